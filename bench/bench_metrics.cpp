@@ -0,0 +1,83 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "benchmark.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "utils/metrics.h"
+
+namespace {
+    /**
+     * 在threads个线程中同时执行body，每个线程执行iterations次
+     * 线程全部创建后才同时开始，结果的每次耗时即单个线程每次操作的耗时：
+     * 没有竞争时不随线程数变化（处理器核数以内），出现竞争时随线程数上升
+     * @param threads 线程数
+     * @param iterations 每个线程的次数
+     * @param body 被测操作，参数为线程序号和本次的序号
+     */
+    template <typename Body>
+    void runThreads(unsigned int threads, size_t iterations, Body body) {
+        std::atomic<bool> start(false);
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (unsigned int t = 0; t < threads; ++t) {
+            workers.push_back(std::thread([&start, &body, t, iterations]() {
+                while (!start.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                for (size_t i = 0; i < iterations; ++i) {
+                    body(t, i);
+                }
+            }));
+        }
+        start.store(true, std::memory_order_release);
+        for (size_t t = 0; t < workers.size(); ++t) {
+            workers[t].join();
+        }
+    }
+
+    void counterAdd(unsigned int threads, size_t iterations) {
+        static evan::utils::MetricCounter counter;
+        runThreads(threads, iterations, [](unsigned int, size_t) { counter.add(); });
+        evan::bench::keep(counter);
+    }
+
+    void histogramObserve(unsigned int threads, size_t iterations) {
+        static evan::utils::MetricHistogram& histogram =
+            evan::utils::MetricsRegistry::instance().latency("bench.observe_us");
+        runThreads(threads, iterations, [](unsigned int t, size_t i) {
+            // 数值分布在前几十个桶中，max只在少数几次更新
+            histogram.observe((i * 2654435761u + t) % 4096);
+        });
+        evan::bench::keep(histogram);
+    }
+
+    /**
+     * 对照：所有线程写同一个原子变量（分片之前的做法）
+     */
+    void sharedAtomicAdd(unsigned int threads, size_t iterations) {
+        static std::atomic<unsigned long long> value(0);
+        runThreads(threads, iterations, [](unsigned int, size_t) { value.fetch_add(1, std::memory_order_relaxed); });
+        evan::bench::keep(value);
+    }
+}
+
+#define EVAN_METRICS_BENCHMARKS(threads) \
+    EVAN_BENCHMARK(bench_counter_add_##threads, "metrics.counter_add.threads_" #threads) { \
+        counterAdd(threads, iterations); \
+    } \
+    EVAN_BENCHMARK(bench_histogram_observe_##threads, "metrics.histogram_observe.threads_" #threads) { \
+        histogramObserve(threads, iterations); \
+    } \
+    EVAN_BENCHMARK(bench_shared_atomic_add_##threads, "metrics.shared_atomic_add.threads_" #threads) { \
+        sharedAtomicAdd(threads, iterations); \
+    }
+
+EVAN_METRICS_BENCHMARKS(1)
+EVAN_METRICS_BENCHMARKS(2)
+EVAN_METRICS_BENCHMARKS(4)
+EVAN_METRICS_BENCHMARKS(8)
+EVAN_METRICS_BENCHMARKS(16)
+EVAN_METRICS_BENCHMARKS(32)
+EVAN_METRICS_BENCHMARKS(64)
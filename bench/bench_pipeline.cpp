@@ -0,0 +1,93 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "benchmark.h"
+#include <cstdio>
+#include <cstdlib>
+#include "procfs_fixture.h"
+#include "core/collector.h"
+#include "core/configuration.h"
+#include "core/procfs_source.h"
+#include "core/system_monitor.h"
+#include "utils/format.h"
+
+namespace {
+    /**
+     * 丢弃输出，只统计字节数（防止输出被优化掉，同时排除终端的开销）
+     */
+    class CountingSink : public evan::utils::FormatSink {
+    public:
+        CountingSink() : bytes(0) {}
+        void write(const char*, size_t length) override { bytes += length; }
+        size_t bytes;
+    };
+
+    /**
+     * 合成procfs目录的存放位置（环境变量EVANOS_FIXTURE_DIR，默认为当前目录下的procfs_fixtures）
+     * 生成过的目录会被复用，只有第一次运行需要生成
+     */
+    std::string fixtureRoot(unsigned int processes) {
+        const char* base = getenv("EVANOS_FIXTURE_DIR");
+        std::string root(base != nullptr && base[0] != '\0' ? base : "procfs_fixtures");
+        evan::bench::ProcfsFixtureSpec spec;
+        spec.processes = processes;
+
+        evan::utils::StackBuffer<64> name;
+        EVAN_FORMAT(name, "/procs_{}", processes);
+        // 100k进程时每个进程只生成一个线程，控制fixture的文件数量（约50万个）
+        if (processes >= 100000) {
+            spec.threads = 1;
+        }
+
+        root += name.c_str();
+        if (!evan::bench::procfs_fixture_prepare(root, spec)) {
+            EVAN_FPRINT(stderr, "Error: Unable to write procfs fixture {}.\n", root);
+            exit(1);
+        }
+        return root;
+    }
+
+    /**
+     * 在合成的procfs目录上执行完整的循环：读取数据源，依次执行perf、sys、total、each采集器，回收Arena
+     * @param processes 进程数
+     * @param iterations 循环次数
+     */
+    void runTicks(unsigned int processes, size_t iterations) {
+        static const char* const COLLECTORS[] = {"perf", "sys", "total", "each"};
+
+        evan::evos_proc_root_set(fixtureRoot(processes));
+        evan::CollectorRegistry registry;
+        evan::evos_builtin_collectors_register(registry);
+        evan::CollectorPlan plan;
+        for (size_t i = 0; i < sizeof(COLLECTORS) / sizeof(COLLECTORS[0]); ++i) {
+            plan.add(registry.find(COLLECTORS[i]));
+        }
+        evan::Configuration config;
+        CountingSink output;
+
+        for (size_t i = 0; i < iterations; ++i) {
+            evan::utils::StdoutCapture capture(output);
+            evan::utils::Arena& arena = evan::evos_tick_arena();
+            evan::TickSources sources(arena);
+            plan.load(sources, arena);
+            for (size_t c = 0; c < plan.size(); ++c) {
+                plan[c]->display(sources, config);
+            }
+            evan::evos_tick_reset();
+        }
+        evan::bench::keep(output.bytes);
+        evan::evos_proc_root_set(std::string());
+    }
+}
+
+EVAN_BENCHMARK(bench_tick_procfs_1k, "pipeline.tick.procfs_1k") {
+    runTicks(1000, iterations);
+}
+
+EVAN_BENCHMARK(bench_tick_procfs_10k, "pipeline.tick.procfs_10k") {
+    runTicks(10000, iterations);
+}
+
+EVAN_BENCHMARK(bench_tick_procfs_100k, "pipeline.tick.procfs_100k") {
+    runTicks(100000, iterations);
+}
@@ -0,0 +1,27 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "benchmark.h"
+#include "core/collector.h"
+#include "core/system_monitor.h"
+
+EVAN_BENCHMARK(bench_process_snapshot, "system_monitor.process_snapshot") {
+    for (size_t i = 0; i < iterations; ++i) {
+        evan::utils::Arena& arena = evan::evos_tick_arena();
+        evan::ProcessList processes((evan::utils::ArenaAllocator<evan::ProcessSample>(arena)));
+        bool ok = evan::evos_process_snapshot_collect(arena, processes);
+        evan::bench::keep(ok);
+        evan::evos_tick_reset();
+    }
+}
+
+EVAN_BENCHMARK(bench_tick_sources, "collector.tick_sources_load") {
+    const evan::DataSourceMask all = evan::SOURCE_MEMORY_STATUS | evan::SOURCE_SYSTEM_INFO | evan::SOURCE_PROCESS_TABLE;
+    for (size_t i = 0; i < iterations; ++i) {
+        evan::utils::Arena& arena = evan::evos_tick_arena();
+        evan::TickSources sources(arena);
+        bool ok = evan::evos_tick_sources_load(all, sources, arena);
+        evan::bench::keep(ok);
+        evan::evos_tick_reset();
+    }
+}
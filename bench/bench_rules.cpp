@@ -0,0 +1,87 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "benchmark.h"
+#include <string>
+#include <vector>
+#include "core/alert_rules.h"
+#include "utils/format.h"
+
+namespace {
+    const size_t RULE_PROCESSES = 50000;
+    const size_t RULE_COUNT = 100;
+
+    /**
+     * 合成的列式进程表：工作集在0到2GB之间均匀分布，每100个进程中有一个java.exe
+     */
+    struct RuleFixture {
+        std::vector<std::string> names;
+        evan::AlertInputs inputs;
+
+        RuleFixture() : names(RULE_PROCESSES) {
+            unsigned long long state = 88172645463325252ULL;
+            inputs.rows = RULE_PROCESSES;
+            for (size_t c = 0; c < evan::ALERT_COLUMN_COUNT; ++c) {
+                inputs.columns[c].resize(RULE_PROCESSES);
+            }
+            for (size_t i = 0; i < RULE_PROCESSES; ++i) {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                inputs.columns[evan::ALERT_COLUMN_RSS][i] = static_cast<uint32_t>(state % (2u << 20));
+                inputs.columns[evan::ALERT_COLUMN_PAGEFILE][i] = static_cast<uint32_t>((state >> 20) % (1u << 20));
+                inputs.columns[evan::ALERT_COLUMN_PID][i] = static_cast<uint32_t>(i * 4);
+                names[i] = i % 100 == 0 ? std::string("java.exe") : EVAN_FORMAT_STRING("proc{}.exe", i);
+            }
+            for (size_t i = 0; i < RULE_PROCESSES; ++i) {
+                inputs.names.push_back(names[i]);
+            }
+            inputs.system[evan::ALERT_SYS_MEM_USED_PCT] = 50.0;
+            inputs.summarize();
+        }
+    };
+
+    /**
+     * 100条规则，四种形式各25条：超过所有进程的阈值、被系统字段短路、选择性的区间加进程名、PID或工作集
+     */
+    std::string ruleText() {
+        std::string text;
+        for (size_t r = 0; r < RULE_COUNT; ++r) {
+            switch (r % 4) {
+                case 0:
+                    text += EVAN_FORMAT_STRING("r{}: proc.rss > {}G && proc.name ~ \"java\"\n", r, 8 + r % 5);
+                    break;
+                case 1:
+                    text += EVAN_FORMAT_STRING("r{}: sys.mem.used_pct > 90 && proc.pagefile > 2G for 30s\n", r);
+                    break;
+                case 2:
+                    text += EVAN_FORMAT_STRING("r{}: proc.rss >= {}M && proc.name !~ \"svc*\"\n", r, 2040 + r / 10);
+                    break;
+                default:
+                    text += EVAN_FORMAT_STRING("r{}: proc.pid == {} || proc.rss > 16G\n", r, r * 7);
+                    break;
+            }
+        }
+        return text;
+    }
+}
+
+EVAN_BENCHMARK(bench_rules_evaluate, "alert_rules.evaluate_100x50k") {
+    static RuleFixture fixture;
+    evan::AlertRuleSet rules;
+    rules.parse(ruleText(), "bench");
+    std::vector<evan::AlertEvent> events;
+    for (size_t i = 0; i < iterations; ++i) {
+        events.clear();
+        rules.evaluate(fixture.inputs, i, events);
+        evan::bench::keep(events);
+    }
+}
+
+EVAN_BENCHMARK(bench_rules_summarize, "alert_rules.summarize_50k") {
+    static RuleFixture fixture;
+    for (size_t i = 0; i < iterations; ++i) {
+        fixture.inputs.summarize();
+        evan::bench::keep(fixture.inputs.highest[0]);
+    }
+}
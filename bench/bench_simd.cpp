@@ -0,0 +1,211 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "benchmark.h"
+#include <cstring>
+#include <string>
+#include <vector>
+#include "utils/simd_scan.h"
+#include "utils/string_utils.h"
+
+namespace {
+    const size_t SCAN_BYTES = 4096;
+    const size_t MASK_ROWS = 65536;
+
+    /**
+     * 4KB的/proc/<pid>/status格式文本（大小写混合）
+     */
+    const std::string& scanText() {
+        static std::string text;
+        if (text.empty()) {
+            const char* const line = "VmRSS:\t  123456 kB\nName:\tSvcHost.EXE\nThreads:\t42\n";
+            while (text.size() < SCAN_BYTES) {
+                text += line;
+            }
+            text.resize(SCAN_BYTES);
+        }
+        return text;
+    }
+
+    /**
+     * 按指定的指令集级别执行基准，结束后恢复原来的级别
+     * CPU不支持的级别按支持的最高级别执行（JSON的context.simd_level为CPU支持的最高级别）
+     */
+    class LevelScope {
+    public:
+        explicit LevelScope(evan::utils::SimdScan::Level lvl) : previous(evan::utils::SimdScan::level()) {
+            evan::utils::SimdScan::setLevel(lvl);
+        }
+        ~LevelScope() { evan::utils::SimdScan::setLevel(previous); }
+
+    private:
+        evan::utils::SimdScan::Level previous;
+    };
+
+    void toLower(evan::utils::SimdScan::Level lvl, size_t iterations) {
+        LevelScope scope(lvl);
+        std::string text = scanText();
+        for (size_t i = 0; i < iterations; ++i) {
+            // 第一次之后已经全是小写，每次仍然处理全部字节
+            evan::utils::SimdScan::toLowerAscii(&text[0], text.size());
+            evan::bench::keep(text);
+        }
+    }
+
+    /**
+     * 按行分割（StringUtils::SplitIterator，分隔符位图由当前级别的内核计算）
+     */
+    void splitLines(evan::utils::SimdScan::Level lvl, size_t iterations) {
+        LevelScope scope(lvl);
+        const evan::utils::StringView text(scanText());
+        for (size_t i = 0; i < iterations; ++i) {
+            evan::utils::StringUtils::SplitIterator lines(text, '\n');
+            evan::utils::StringView line;
+            size_t total = 0;
+            while (lines.next(line)) {
+                total += line.size();
+            }
+            evan::bench::keep(total);
+        }
+    }
+
+    /**
+     * 对照：每行调用一次memchr（改用位图之前SplitIterator的做法）
+     */
+    void splitLinesMemchr(size_t iterations) {
+        const std::string& text = scanText();
+        for (size_t i = 0; i < iterations; ++i) {
+            const char* cursor = text.data();
+            const char* end = text.data() + text.size();
+            size_t total = 0;
+            for (;;) {
+                const char* pos = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+                if (pos == nullptr) {
+                    total += static_cast<size_t>(end - cursor);
+                    break;
+                }
+                total += static_cast<size_t>(pos - cursor);
+                cursor = pos + 1;
+            }
+            evan::bench::keep(total);
+        }
+    }
+
+    /**
+     * 按空白分割（StringUtils::WordIterator）
+     */
+    void splitWords(evan::utils::SimdScan::Level lvl, size_t iterations) {
+        LevelScope scope(lvl);
+        const evan::utils::StringView text(scanText());
+        for (size_t i = 0; i < iterations; ++i) {
+            evan::utils::StringUtils::WordIterator words(text);
+            evan::utils::StringView word;
+            size_t total = 0;
+            while (words.next(word)) {
+                total += word.size();
+            }
+            evan::bench::keep(total);
+        }
+    }
+
+    /**
+     * 对照：逐字节跳过空白和单词
+     */
+    void splitWordsBytewise(size_t iterations) {
+        const std::string& text = scanText();
+        for (size_t i = 0; i < iterations; ++i) {
+            const char* cursor = text.data();
+            const char* end = text.data() + text.size();
+            size_t total = 0;
+            while (cursor < end) {
+                while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r' || *cursor == '\n')) {
+                    ++cursor;
+                }
+                const char* start = cursor;
+                while (cursor < end && *cursor != ' ' && *cursor != '\t' && *cursor != '\r' && *cursor != '\n') {
+                    ++cursor;
+                }
+                total += static_cast<size_t>(cursor - start);
+            }
+            evan::bench::keep(total);
+        }
+    }
+
+    void rangeMask(evan::utils::SimdScan::Level lvl, size_t iterations) {
+        LevelScope scope(lvl);
+        static std::vector<uint32_t> values;
+        if (values.empty()) {
+            unsigned int state = 2463534242u;
+            values.resize(MASK_ROWS);
+            for (size_t i = 0; i < MASK_ROWS; ++i) {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                values[i] = state % (2u << 20);
+            }
+        }
+        const std::vector<uint64_t> candidates(MASK_ROWS / 64, ~0ULL);
+        std::vector<uint64_t> out(MASK_ROWS / 64);
+        for (size_t i = 0; i < iterations; ++i) {
+            // 约一半的行在区间内，每组都需要扫描
+            evan::utils::SimdScan::rangeMask(values.data(), MASK_ROWS, 1u << 19, 1u << 20, candidates.data(), out.data());
+            evan::bench::keep(out);
+        }
+    }
+}
+
+EVAN_BENCHMARK(bench_to_lower_scalar, "simd_scan.to_lower_4k.scalar") {
+    toLower(evan::utils::SimdScan::SCALAR, iterations);
+}
+
+EVAN_BENCHMARK(bench_to_lower_sse2, "simd_scan.to_lower_4k.sse2") {
+    toLower(evan::utils::SimdScan::SSE2, iterations);
+}
+
+EVAN_BENCHMARK(bench_to_lower_avx2, "simd_scan.to_lower_4k.avx2") {
+    toLower(evan::utils::SimdScan::AVX2, iterations);
+}
+
+EVAN_BENCHMARK(bench_split_lines_scalar, "simd_scan.split_lines_4k.scalar") {
+    splitLines(evan::utils::SimdScan::SCALAR, iterations);
+}
+
+EVAN_BENCHMARK(bench_split_lines_sse2, "simd_scan.split_lines_4k.sse2") {
+    splitLines(evan::utils::SimdScan::SSE2, iterations);
+}
+
+EVAN_BENCHMARK(bench_split_lines_avx2, "simd_scan.split_lines_4k.avx2") {
+    splitLines(evan::utils::SimdScan::AVX2, iterations);
+}
+
+EVAN_BENCHMARK(bench_split_lines_memchr, "simd_scan.split_lines_4k.memchr") {
+    splitLinesMemchr(iterations);
+}
+
+EVAN_BENCHMARK(bench_split_words_scalar, "simd_scan.split_words_4k.scalar") {
+    splitWords(evan::utils::SimdScan::SCALAR, iterations);
+}
+
+EVAN_BENCHMARK(bench_split_words_sse2, "simd_scan.split_words_4k.sse2") {
+    splitWords(evan::utils::SimdScan::SSE2, iterations);
+}
+
+EVAN_BENCHMARK(bench_split_words_avx2, "simd_scan.split_words_4k.avx2") {
+    splitWords(evan::utils::SimdScan::AVX2, iterations);
+}
+
+EVAN_BENCHMARK(bench_split_words_bytewise, "simd_scan.split_words_4k.bytewise") {
+    splitWordsBytewise(iterations);
+}
+
+EVAN_BENCHMARK(bench_range_mask_scalar, "simd_scan.range_mask_64k.scalar") {
+    rangeMask(evan::utils::SimdScan::SCALAR, iterations);
+}
+
+EVAN_BENCHMARK(bench_range_mask_sse2, "simd_scan.range_mask_64k.sse2") {
+    rangeMask(evan::utils::SimdScan::SSE2, iterations);
+}
+
+EVAN_BENCHMARK(bench_range_mask_avx2, "simd_scan.range_mask_64k.avx2") {
+    rangeMask(evan::utils::SimdScan::AVX2, iterations);
+}
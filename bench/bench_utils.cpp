@@ -0,0 +1,157 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "benchmark.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "core/configuration.h"
+#include "i18n/internationalization.h"
+#include "ui/display_utils.h"
+#include "utils/arena.h"
+#include "utils/command_line.h"
+#include "utils/format.h"
+#include "utils/string_utils.h"
+
+namespace {
+    // 典型的每个进程一行的字段（与进程表的列数相同）
+    const char* const CSV_LINE = "4242,svchost.exe,1234567890,987654321,Running,SYSTEM,NT AUTHORITY,8,12";
+
+    // 覆盖B到GB的字节数
+    const unsigned long long BYTE_SAMPLES[] = {512ULL, 48ULL << 10, 300ULL << 20, 17ULL << 30};
+    const size_t BYTE_SAMPLE_COUNT = sizeof(BYTE_SAMPLES) / sizeof(BYTE_SAMPLES[0]);
+}
+
+EVAN_BENCHMARK(bench_byte_to_str, "configuration.config_byte_to_str") {
+    evan::Configuration config;
+    for (size_t i = 0; i < iterations; ++i) {
+        std::string text = config.config_byte_to_str(BYTE_SAMPLES[i % BYTE_SAMPLE_COUNT]);
+        evan::bench::keep(text);
+    }
+}
+
+EVAN_BENCHMARK(bench_byte_to_str_arena, "configuration.config_byte_to_str.arena") {
+    evan::Configuration config;
+    evan::utils::Arena arena;
+    for (size_t i = 0; i < iterations; ++i) {
+        evan::utils::StringView text = config.config_byte_to_str(BYTE_SAMPLES[i % BYTE_SAMPLE_COUNT], arena);
+        evan::bench::keep(text);
+        if ((i & 1023) == 1023) {
+            arena.reset();
+        }
+    }
+}
+
+EVAN_BENCHMARK(bench_create_table, "display_utils.createTable") {
+    std::vector<std::string> headers;
+    headers.push_back("PID");
+    headers.push_back("Process Name");
+    headers.push_back("Working Set");
+    headers.push_back("Pagefile");
+
+    std::vector<std::vector<std::string>> rows;
+    for (int r = 0; r < 50; ++r) {
+        std::vector<std::string> row;
+        row.push_back(evan::utils::StringUtils::toString(1000 + r * 4));
+        row.push_back("process" + evan::utils::StringUtils::toString(r) + ".exe");
+        row.push_back("123.4 MB");
+        row.push_back("56.7 MB");
+        rows.push_back(row);
+    }
+
+    for (size_t i = 0; i < iterations; ++i) {
+        std::string table = evan::DisplayUtils::createTable(headers, rows);
+        evan::bench::keep(table);
+    }
+}
+
+EVAN_BENCHMARK(bench_translate_key, "internationalization.translate.key") {
+    evan::Internationalization& i18n = evan::Internationalization::getInstance();
+    i18n.setLanguage(evan::Language::CHINESE);
+    for (size_t i = 0; i < iterations; ++i) {
+        evan::utils::StringView text = i18n.translate(static_cast<evan::TrKey>(i % evan::TR_KEY_COUNT));
+        evan::bench::keep(text);
+    }
+    i18n.setLanguage(evan::Language::ENGLISH);
+}
+
+EVAN_BENCHMARK(bench_translate_name, "internationalization.translate.name") {
+    evan::Internationalization& i18n = evan::Internationalization::getInstance();
+    const std::string name("total_physical_memory");
+    for (size_t i = 0; i < iterations; ++i) {
+        std::string text = i18n.translate(name);
+        evan::bench::keep(text);
+    }
+}
+
+EVAN_BENCHMARK(bench_split, "string_utils.split") {
+    const std::string line(CSV_LINE);
+    for (size_t i = 0; i < iterations; ++i) {
+        std::vector<std::string> fields = evan::utils::StringUtils::split(line, ',');
+        evan::bench::keep(fields);
+    }
+}
+
+EVAN_BENCHMARK(bench_split_view, "string_utils.splitView") {
+    const evan::utils::StringView line(CSV_LINE);
+    evan::utils::StringView fields[16];
+    for (size_t i = 0; i < iterations; ++i) {
+        size_t count = evan::utils::StringUtils::splitView(line, ',', fields, 16);
+        evan::bench::keep(count);
+    }
+}
+
+EVAN_BENCHMARK(bench_format, "format.EVAN_FORMAT") {
+    for (size_t i = 0; i < iterations; ++i) {
+        evan::utils::StackBuffer<128> buffer;
+        EVAN_FORMAT(buffer, "{:<10} {:<25} {:>12} {:.1f}%\n", 4242u, "svchost.exe", 1234567890ULL, 42.5);
+        evan::bench::keep(buffer);
+    }
+}
+
+EVAN_BENCHMARK(bench_format_snprintf, "format.snprintf") {
+    // 与format.EVAN_FORMAT输出相同的一行，作为比较的基准
+    for (size_t i = 0; i < iterations; ++i) {
+        char buffer[128];
+        int length = snprintf(buffer, sizeof(buffer), "%-10u %-25s %12llu %.1f%%\n", 4242u, "svchost.exe", 1234567890ULL, 42.5);
+        evan::bench::keep(buffer);
+        evan::bench::keep(length);
+    }
+}
+
+EVAN_BENCHMARK(bench_to_number, "string_utils.toNumber") {
+    const std::string values[] = {"0", "4242", "65535", "-17", "1234567890"};
+    for (size_t i = 0; i < iterations; ++i) {
+        long value = evan::utils::StringUtils::toNumber<long>(values[i % 5]);
+        evan::bench::keep(value);
+    }
+}
+
+EVAN_BENCHMARK(bench_parse_number, "string_utils.parseNumber") {
+    const evan::utils::StringView values[] = {"0", "4242", "65535", "-17", "1234567890"};
+    for (size_t i = 0; i < iterations; ++i) {
+        long value = 0;
+        size_t used = evan::utils::StringUtils::parseNumber(values[i % 5], value);
+        evan::bench::keep(used);
+        evan::bench::keep(value);
+    }
+}
+
+EVAN_BENCHMARK(bench_parser_parse, "cmdline.parser.parse") {
+    const char* args[] = {"evanOS", "--total", "--each", "--loop", "60", "--changes-only",
+                          "--change-threshold", "2", "--jobs", "4", "-y", "2"};
+    const int argc = static_cast<int>(sizeof(args) / sizeof(args[0]));
+    for (size_t i = 0; i < iterations; ++i) {
+        // 与main()一样每次都重新定义参数，测量的是启动时解析命令行的完整开销
+        cmdline::parser par;
+        par.add("total", 't', "show total memory.");
+        par.add("each", 'e', "show each process.");
+        par.add("loop", 'l', "loop this program.", false, 1u);
+        par.add("changes-only", 'W', "print only changes.");
+        par.add("change-threshold", 'r', "change threshold.", false, 1u);
+        par.add("jobs", 'J', "parallel jobs.", false, 0u);
+        par.add("type", 'y', "byte type.", false, 0);
+        bool ok = par.parse(argc, const_cast<char**>(args));
+        evan::bench::keep(ok);
+    }
+}
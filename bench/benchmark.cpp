@@ -0,0 +1,163 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <thread>
+#include "utils/command_line.h"
+#include "utils/format.h"
+#include "utils/simd_scan.h"
+
+namespace evan {
+namespace bench {
+
+#ifndef __GNUC__
+namespace detail {
+    const void* volatile keepSink = nullptr;
+} // namespace detail
+#endif
+
+/**
+ * 获取所有已注册的基准
+ * 函数内的静态变量保证在其他翻译单元的注册器之前构造
+ */
+std::vector<Benchmark>& benchmarks() {
+    static std::vector<Benchmark> registered;
+    return registered;
+}
+
+namespace {
+    /**
+     * 一个基准的测量结果
+     */
+    struct BenchmarkResult {
+        const char* name;
+        size_t iterations;          ///< 每轮的迭代次数
+        std::vector<double> runs;   ///< 每轮的平均耗时（纳秒/次）
+    };
+
+    /**
+     * 执行一轮并计时
+     * @return 耗时（纳秒）
+     */
+    double timeRun(BenchmarkFunc func, size_t iterations) {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        func(iterations);
+        const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    /**
+     * 测量一个基准
+     * 先倍增迭代次数直到一轮耗时超过目标的十分之一，再按比例放大到目标耗时；
+     * 之后以固定的迭代次数重复多轮，减少单轮的抖动
+     * @param benchmark 基准
+     * @param minTimeNs 每轮的目标耗时（纳秒）
+     * @param repetitions 重复轮数
+     * @param result [out] 测量结果
+     */
+    void measure(const Benchmark& benchmark, double minTimeNs, unsigned int repetitions, BenchmarkResult& result) {
+        size_t iterations = 1;
+        double elapsed = timeRun(benchmark.func, iterations);
+        while (elapsed < minTimeNs / 10 && iterations < (static_cast<size_t>(1) << 40)) {
+            iterations *= 2;
+            elapsed = timeRun(benchmark.func, iterations);
+        }
+        if (elapsed < minTimeNs) {
+            const double scale = elapsed > 0 ? minTimeNs / elapsed : 10.0;
+            iterations = static_cast<size_t>(static_cast<double>(iterations) * std::min(scale, 10.0)) + 1;
+        }
+
+        result.name = benchmark.name;
+        result.iterations = iterations;
+        result.runs.clear();
+        for (unsigned int r = 0; r < repetitions; ++r) {
+            result.runs.push_back(timeRun(benchmark.func, iterations) / static_cast<double>(iterations));
+        }
+    }
+
+    /**
+     * 以JSON输出所有结果
+     * @param results 测量结果
+     * @param minTimeMs 每轮的目标耗时（毫秒）
+     */
+    void writeJson(const std::vector<BenchmarkResult>& results, unsigned int minTimeMs) {
+        char date[32] = "";
+        const std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+        utils::FileSink out(stdout);
+        EVAN_FORMAT(out, "{{\n  \"context\": {{\n    \"date\": \"{}\",\n", date);
+#ifdef EVANOS_BENCH_BUILD_TYPE
+        EVAN_FORMAT(out, "    \"build_type\": \"{}\",\n", EVANOS_BENCH_BUILD_TYPE);
+#endif
+        EVAN_FORMAT(out, "    \"simd_level\": \"{}\",\n",
+                    utils::SimdScan::levelName(utils::SimdScan::detectedLevel()));
+        EVAN_FORMAT(out, "    \"hardware_threads\": {},\n", std::thread::hardware_concurrency());
+        EVAN_FORMAT(out, "    \"min_time_ms\": {}\n  }},\n  \"benchmarks\": [\n", minTimeMs);
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            const BenchmarkResult& result = results[i];
+            std::vector<double> sorted(result.runs);
+            std::sort(sorted.begin(), sorted.end());
+
+            EVAN_FORMAT(out, "    {{\"name\": \"{}\", \"iterations\": {}, \"repetitions\": {}, "
+                             "\"ns_per_op_min\": {:.2f}, \"ns_per_op_median\": {:.2f}, \"ns_per_op_max\": {:.2f}}}{}\n",
+                        result.name, result.iterations, sorted.size(),
+                        sorted.front(), sorted[sorted.size() / 2], sorted.back(),
+                        i + 1 < results.size() ? "," : "");
+        }
+        EVAN_FORMAT(out, "  ]\n}}\n");
+    }
+}
+
+} // namespace bench
+} // namespace evan
+
+/**
+ * 基准程序入口
+ * 结果以JSON输出到标准输出，进度输出到标准错误，便于直接重定向保存：
+ *   evanOS_bench --min-time 500 > bench.json
+ */
+int main(int argc, char** argv) {
+    cmdline::parser par;
+    par.set_program_name("evanOS_bench");
+    par.add("filter", 'f', "run only benchmarks whose name contains this string.", false, std::string(""));
+    par.add("min-time", 'm', "target duration of each repetition in milliseconds (default 200).", false, 200u);
+    par.add("repetitions", 'r', "number of repetitions per benchmark (default 5).", false, 5u);
+    par.add("list", 'l', "list benchmark names and exit.");
+    par.add("help", '?', "show help message.");
+    if (!par.parse(argc, argv) || par.exist("help")) {
+        std::cout << par.error() << par.usage();
+        return par.exist("help") ? 0 : 1;
+    }
+
+    const std::vector<evan::bench::Benchmark>& all = evan::bench::benchmarks();
+    if (par.exist("list")) {
+        for (size_t i = 0; i < all.size(); ++i) {
+            EVAN_PRINT("{}\n", all[i].name);
+        }
+        return 0;
+    }
+
+    const std::string filter = par.get<std::string>("filter");
+    const unsigned int minTimeMs = std::max(1u, par.get<unsigned int>("min-time"));
+    const unsigned int repetitions = std::max(1u, par.get<unsigned int>("repetitions"));
+
+    std::vector<evan::bench::BenchmarkResult> results;
+    for (size_t i = 0; i < all.size(); ++i) {
+        if (!filter.empty() && std::string(all[i].name).find(filter) == std::string::npos) {
+            continue;
+        }
+        EVAN_FPRINT(stderr, "running {}...\n", all[i].name);
+        evan::bench::BenchmarkResult result;
+        evan::bench::measure(all[i], minTimeMs * 1e6, repetitions, result);
+        results.push_back(result);
+    }
+
+    evan::bench::writeJson(results, minTimeMs);
+    return 0;
+}
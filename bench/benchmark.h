@@ -0,0 +1,82 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#ifndef __GNUC__
+    #include <intrin.h>
+#endif
+
+namespace evan {
+namespace bench {
+
+/**
+ * 基准函数：执行被测代码iterations次
+ */
+typedef void (*BenchmarkFunc)(size_t iterations);
+
+/**
+ * 已注册的基准
+ */
+struct Benchmark {
+    const char* name;     ///< 名称（输出到JSON，用于跨提交比较）
+    BenchmarkFunc func;   ///< 基准函数
+};
+
+/**
+ * 获取所有已注册的基准（按注册顺序）
+ */
+std::vector<Benchmark>& benchmarks();
+
+/**
+ * 静态注册器，由EVAN_BENCHMARK使用
+ */
+struct BenchmarkRegistrar {
+    BenchmarkRegistrar(const char* name, BenchmarkFunc func) {
+        Benchmark benchmark = {name, func};
+        benchmarks().push_back(benchmark);
+    }
+};
+
+#ifndef __GNUC__
+namespace detail {
+    extern const void* volatile keepSink;
+} // namespace detail
+#endif
+
+/**
+ * 防止编译器把结果未被使用的被测代码优化掉
+ * GCC/Clang：以空的内联汇编"读取"结果的地址并声明改写了全部内存，结果必须在此之前写入内存，
+ * 之后的代码也不能复用此前从内存读到的值；
+ * MSVC：把地址写入volatile变量并读回一个字节，再以_ReadWriteBarrier阻止编译器跨越此处重排内存访问
+ * @param value 被测代码的结果
+ */
+template <typename T>
+inline void keep(const T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    detail::keepSink = &value;
+    (void)*static_cast<const volatile char*>(detail::keepSink);
+    _ReadWriteBarrier();
+#endif
+}
+
+} // namespace bench
+} // namespace evan
+
+/**
+ * 定义并注册基准
+ * 示例：
+ *   EVAN_BENCHMARK(bench_split, "string_utils.split") {
+ *       for (size_t i = 0; i < iterations; ++i) { ... }
+ *   }
+ */
+#define EVAN_BENCHMARK(func, name) \
+    static void func(size_t iterations); \
+    static ::evan::bench::BenchmarkRegistrar func##_registrar(name, &func); \
+    static void func(size_t iterations)
@@ -0,0 +1,458 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+#include "utils/command_line.h"
+#include "utils/format.h"
+
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <windows.h>
+
+/**
+ * 合成负载生成器
+ * 按给定速率创建和结束子进程与线程、在回环地址上建立和关闭TCP连接、分配并写入内存，
+ * 用于在进程频繁变化的情况下测量evanOS的扫描吞吐、循环抖动（--stats中的tick.jitter_us）和归属准确性：
+ *   evanOS_loadgen --duration 120 --processes 200 --spawn-rate 50 --threads 64 --socket-rate 500 --alloc-rate 256
+ *   evanOS --loop 120 --each --total --stats
+ * 每个子进程名为evanOS_loadgen，工作集约为--child-rss，可以与--each的输出核对；
+ * 相同的参数和种子产生相同的操作序列
+ */
+namespace evan {
+namespace bench {
+
+namespace {
+    /**
+     * 内存页大小（写入每页的一个字节使其驻留）
+     */
+    const size_t PAGE_SIZE = 4096;
+
+    /**
+     * 每次分配的块大小
+     */
+    const size_t ALLOC_CHUNK = 1024 * 1024;
+
+    /**
+     * 调度周期（毫秒）
+     */
+    const unsigned int STEP_MS = 10;
+
+    /**
+     * 负载参数
+     */
+    struct LoadSpec {
+        unsigned int duration;      ///< 运行时间（秒）
+        unsigned int processes;     ///< 同时存在的子进程数
+        unsigned int spawn_rate;    ///< 每秒替换的子进程数（结束一个、创建一个）
+        unsigned int threads;       ///< 常驻线程数
+        unsigned int thread_rate;   ///< 每秒创建并结束的短生命周期线程数
+        unsigned int socket_rate;   ///< 每秒建立并关闭的回环连接数
+        unsigned int memory;        ///< 最多保留的内存（MB），超过时释放最早的块
+        unsigned int alloc_rate;    ///< 每秒分配并写入的内存（MB）
+        unsigned int child_rss;     ///< 每个子进程写入的内存（KB）
+        unsigned int seed;          ///< 随机种子（选择结束哪个子进程）
+    };
+
+    /**
+     * 实际执行的操作数
+     */
+    struct LoadStats {
+        unsigned long long spawned;
+        unsigned long long killed;
+        unsigned long long spawn_errors;
+        unsigned long long threads_started;
+        unsigned long long connections;
+        unsigned long long socket_errors;
+        unsigned long long bytes_allocated;
+    };
+
+    /**
+     * 确定性的伪随机数（xorshift32）
+     */
+    class Random {
+    public:
+        explicit Random(unsigned int seed) : state(seed != 0 ? seed : 0x9E3779B9u) {}
+
+        unsigned int below(unsigned int bound) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return bound != 0 ? state % bound : 0;
+        }
+
+    private:
+        unsigned int state;
+    };
+
+    /**
+     * 分配并写入内存（每页写一个字节）
+     * @param bytes 字节数
+     * @return 内存块，失败返回nullptr
+     */
+    char* touchAllocate(size_t bytes) {
+        char* block = static_cast<char*>(malloc(bytes));
+        if (block != nullptr) {
+            for (size_t i = 0; i < bytes; i += PAGE_SIZE) {
+                block[i] = static_cast<char>(i);
+            }
+        }
+        return block;
+    }
+
+    typedef SOCKET Socket;
+    typedef HANDLE Child;
+
+    void closeSocket(Socket s) { closesocket(s); }
+
+    /**
+     * 创建子进程（以--child模式重新运行自身）
+     * @param rss 子进程写入的内存（KB）
+     * @param child [out] 子进程句柄
+     * @return 成功返回true
+     */
+    bool spawnChild(unsigned int rss, Child& child) {
+        char exePath[MAX_PATH];
+        const DWORD length = GetModuleFileNameA(NULL, exePath, sizeof(exePath));
+        if (length == 0 || length >= sizeof(exePath)) {
+            return false;
+        }
+
+        std::string commandLine;
+        utils::StringSink sink(commandLine);
+        EVAN_FORMAT(sink, "\"{}\" --child {} --child-rss {}", exePath, GetCurrentProcessId(), rss);
+        std::vector<char> mutableCommandLine(commandLine.begin(), commandLine.end());
+        mutableCommandLine.push_back('\0');
+
+        STARTUPINFOA si;
+        memset(&si, 0, sizeof(si));
+        si.cb = sizeof(si);
+        PROCESS_INFORMATION pi;
+        if (!CreateProcessA(exePath, mutableCommandLine.data(), NULL, NULL, FALSE, CREATE_NO_WINDOW,
+                            NULL, NULL, &si, &pi)) {
+            return false;
+        }
+        CloseHandle(pi.hThread);
+        child = pi.hProcess;
+        return true;
+    }
+
+    /**
+     * 结束子进程并等待其退出
+     */
+    void killChild(Child child) {
+        TerminateProcess(child, 0);
+        WaitForSingleObject(child, 1000);
+        CloseHandle(child);
+    }
+
+    /**
+     * 子进程：写入内存后等待父进程结束
+     * @param parent 父进程ID
+     * @param rss 写入的内存（KB）
+     */
+    int runChild(unsigned long parent, unsigned int rss) {
+        touchAllocate(static_cast<size_t>(rss) * 1024);
+        HANDLE handle = OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(parent));
+        if (handle != NULL) {
+            WaitForSingleObject(handle, INFINITE);
+            CloseHandle(handle);
+        }
+        return 0;
+    }
+
+    /**
+     * 回环地址上的TCP服务端：接受连接，读到对端关闭后关闭
+     */
+    class LoopbackServer {
+    public:
+        LoopbackServer() : listener(INVALID_SOCKET), port(0), stopping(false) {}
+
+        ~LoopbackServer() { stop(); }
+
+        /**
+         * 在127.0.0.1的随机端口上监听
+         * @return 成功返回true
+         */
+        bool start() {
+            listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+            if (listener == INVALID_SOCKET) {
+                return false;
+            }
+            sockaddr_in address;
+            memset(&address, 0, sizeof(address));
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            socklen_t length = sizeof(address);
+            if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+                listen(listener, 128) != 0 ||
+                getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+                closeSocket(listener);
+                listener = INVALID_SOCKET;
+                return false;
+            }
+            port = ntohs(address.sin_port);
+            acceptor = std::thread(&LoopbackServer::acceptLoop, this);
+            return true;
+        }
+
+        /**
+         * 停止监听（连接一次自身，唤醒阻塞在accept中的线程）
+         */
+        void stop() {
+            if (listener == INVALID_SOCKET) {
+                return;
+            }
+            stopping = true;
+            connectOnce();
+            acceptor.join();
+            closeSocket(listener);
+            listener = INVALID_SOCKET;
+        }
+
+        /**
+         * 建立一个连接，发送一个字节后关闭
+         * @return 成功返回true
+         */
+        bool connectOnce() const {
+            const Socket client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+            if (client == INVALID_SOCKET) {
+                return false;
+            }
+            sockaddr_in address;
+            memset(&address, 0, sizeof(address));
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            address.sin_port = htons(port);
+            const bool connected = connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 &&
+                                   send(client, "x", 1, 0) == 1;
+            closeSocket(client);
+            return connected;
+        }
+
+    private:
+        void acceptLoop() {
+            while (!stopping) {
+                const Socket peer = accept(listener, nullptr, nullptr);
+                if (peer == INVALID_SOCKET) {
+                    continue;
+                }
+                char buffer[16];
+                while (recv(peer, buffer, sizeof(buffer), 0) > 0) {
+                }
+                closeSocket(peer);
+            }
+        }
+
+        Socket listener;
+        unsigned short port;
+        std::atomic<bool> stopping;
+        std::thread acceptor;
+    };
+
+    /**
+     * 常驻线程：每毫秒醒来一次（产生上下文切换），直到停止
+     */
+    void residentThread(const std::atomic<bool>* stopping) {
+        while (!*stopping) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    /**
+     * 到elapsed时刻为止按rate应当完成的操作数
+     */
+    unsigned long long dueCount(unsigned int rate, std::chrono::steady_clock::duration elapsed) {
+        return static_cast<unsigned long long>(rate) *
+               static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()) / 1000;
+    }
+
+    /**
+     * 按参数生成负载
+     * @param spec 负载参数
+     * @param stats [out] 实际执行的操作数
+     * @return 成功返回true
+     *
+     * 实现：每STEP_MS毫秒检查一次每种操作按速率应完成的次数（从开始时刻累计计算，不会因单步超时而漂移），
+     *       补足差额；只有在主线程中创建和结束子进程，结束哪个子进程由种子决定
+     */
+    bool runLoad(const LoadSpec& spec, LoadStats& stats) {
+        memset(&stats, 0, sizeof(stats));
+        Random random(spec.seed);
+
+        LoopbackServer server;
+        if (spec.socket_rate > 0 && !server.start()) {
+            EVAN_FPRINT(stderr, "Error: Unable to listen on the loopback interface.\n");
+            return false;
+        }
+
+        std::atomic<bool> stopping(false);
+        std::vector<std::thread> residents;
+        for (unsigned int i = 0; i < spec.threads; ++i) {
+            residents.push_back(std::thread(residentThread, &stopping));
+        }
+
+        std::vector<Child> children;
+        const unsigned int pool = spec.processes > 0 ? spec.processes : (spec.spawn_rate > 0 ? 1 : 0);
+        for (unsigned int i = 0; i < pool; ++i) {
+            Child child;
+            if (spawnChild(spec.child_rss, child)) {
+                children.push_back(child);
+                ++stats.spawned;
+            } else {
+                ++stats.spawn_errors;
+            }
+        }
+
+        std::deque<char*> blocks;
+        const size_t maxBlocks = static_cast<size_t>(spec.memory) * 1024 * 1024 / ALLOC_CHUNK;
+        unsigned long long churned = 0;
+        unsigned long long shortThreads = 0;
+        unsigned long long allocated = 0;
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        const std::chrono::steady_clock::time_point end = start + std::chrono::seconds(spec.duration);
+        std::chrono::steady_clock::time_point next = start;
+        for (;;) {
+            const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            if (now >= end) {
+                break;
+            }
+            const std::chrono::steady_clock::duration elapsed = now - start;
+
+            for (const unsigned long long due = dueCount(spec.spawn_rate, elapsed); churned < due; ++churned) {
+                if (!children.empty()) {
+                    const size_t victim = random.below(static_cast<unsigned int>(children.size()));
+                    killChild(children[victim]);
+                    children[victim] = children.back();
+                    children.pop_back();
+                    ++stats.killed;
+                }
+                Child child;
+                if (spawnChild(spec.child_rss, child)) {
+                    children.push_back(child);
+                    ++stats.spawned;
+                } else {
+                    ++stats.spawn_errors;
+                }
+            }
+
+            for (const unsigned long long due = dueCount(spec.thread_rate, elapsed); shortThreads < due; ++shortThreads) {
+                std::thread([]() { std::this_thread::yield(); }).join();
+                ++stats.threads_started;
+            }
+
+            for (const unsigned long long due = dueCount(spec.socket_rate, elapsed); stats.connections + stats.socket_errors < due; ) {
+                if (server.connectOnce()) {
+                    ++stats.connections;
+                } else {
+                    ++stats.socket_errors;
+                }
+            }
+
+            for (const unsigned long long due = dueCount(spec.alloc_rate, elapsed); allocated < due; ++allocated) {
+                char* block = touchAllocate(ALLOC_CHUNK);
+                if (block == nullptr) {
+                    continue;
+                }
+                stats.bytes_allocated += ALLOC_CHUNK;
+                blocks.push_back(block);
+                while (blocks.size() > maxBlocks) {
+                    free(blocks.front());
+                    blocks.pop_front();
+                }
+            }
+
+            next += std::chrono::milliseconds(STEP_MS);
+            std::this_thread::sleep_until(next);
+        }
+
+        for (size_t i = 0; i < children.size(); ++i) {
+            killChild(children[i]);
+            ++stats.killed;
+        }
+        stopping = true;
+        for (size_t i = 0; i < residents.size(); ++i) {
+            residents[i].join();
+        }
+        stats.threads_started += residents.size();
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            free(blocks[i]);
+        }
+        return true;
+    }
+}
+
+} // namespace bench
+} // namespace evan
+
+/**
+ * 负载生成器入口
+ * 结束后以JSON输出参数和实际执行的操作数，便于与evanOS的统计对照
+ */
+int main(int argc, char** argv) {
+    cmdline::parser par;
+    par.set_program_name("evanOS_loadgen");
+    par.add("duration", 'd', "seconds to run (default 60).", false, 60u);
+    par.add("processes", 'p', "number of child processes kept alive (default 0).", false, 0u);
+    par.add("spawn-rate", 's', "child processes replaced (killed and respawned) per second (default 0).", false, 0u);
+    par.add("threads", 't', "resident threads that wake every millisecond (default 0).", false, 0u);
+    par.add("thread-rate", 'T', "short-lived threads created and joined per second (default 0).", false, 0u);
+    par.add("socket-rate", 'c', "loopback TCP connections opened and closed per second (default 0).", false, 0u);
+    par.add("memory", 'm', "MB of allocated memory kept resident (default 0).", false, 0u);
+    par.add("alloc-rate", 'a', "MB allocated and touched per second (default 0).", false, 0u);
+    par.add("child-rss", 'k', "KB each child process touches (default 4096).", false, 4096u);
+    par.add("seed", 'S', "random seed; the same options and seed produce the same sequence (default 1).", false, 1u);
+    par.add("child", 'C', "internal: run as a spawned child of the given parent PID.", false, 0ul);
+    par.add("help", '?', "show help message.");
+    if (!par.parse(argc, argv) || par.exist("help")) {
+        std::cout << par.error() << par.usage();
+        return par.exist("help") ? 0 : 1;
+    }
+
+    if (par.exist("child")) {
+        return evan::bench::runChild(par.get<unsigned long>("child"), par.get<unsigned int>("child-rss"));
+    }
+
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        EVAN_FPRINT(stderr, "Error: WSAStartup failed.\n");
+        return 1;
+    }
+
+    evan::bench::LoadSpec spec;
+    spec.duration = par.get<unsigned int>("duration");
+    spec.processes = par.get<unsigned int>("processes");
+    spec.spawn_rate = par.get<unsigned int>("spawn-rate");
+    spec.threads = par.get<unsigned int>("threads");
+    spec.thread_rate = par.get<unsigned int>("thread-rate");
+    spec.socket_rate = par.get<unsigned int>("socket-rate");
+    spec.memory = par.get<unsigned int>("memory");
+    spec.alloc_rate = par.get<unsigned int>("alloc-rate");
+    spec.child_rss = par.get<unsigned int>("child-rss");
+    spec.seed = par.get<unsigned int>("seed");
+
+    evan::bench::LoadStats stats;
+    const bool ok = evan::bench::runLoad(spec, stats);
+
+    WSACleanup();
+    if (!ok) {
+        return 1;
+    }
+
+    EVAN_PRINT("{{\n  \"spec\": {{\"duration\": {}, \"processes\": {}, \"spawn_rate\": {}, \"threads\": {}, ",
+               spec.duration, spec.processes, spec.spawn_rate, spec.threads);
+    EVAN_PRINT("\"thread_rate\": {}, \"socket_rate\": {}, \"memory\": {}, \"alloc_rate\": {}, \"child_rss\": {}, \"seed\": {}}},\n",
+               spec.thread_rate, spec.socket_rate, spec.memory, spec.alloc_rate, spec.child_rss, spec.seed);
+    EVAN_PRINT("  \"done\": {{\"spawned\": {}, \"killed\": {}, \"spawn_errors\": {}, \"threads_started\": {}, ",
+               stats.spawned, stats.killed, stats.spawn_errors, stats.threads_started);
+    EVAN_PRINT("\"connections\": {}, \"socket_errors\": {}, \"bytes_allocated\": {}}}\n}}\n",
+               stats.connections, stats.socket_errors, stats.bytes_allocated);
+    return 0;
+}
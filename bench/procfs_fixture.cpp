@@ -0,0 +1,375 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "procfs_fixture.h"
+#include <cstdio>
+#include <vector>
+#include "utils/format.h"
+
+#include <windows.h>
+
+namespace evan {
+namespace bench {
+
+namespace {
+    // 常见的进程名（按顺序轮流使用，后面加编号）
+    const char* const PROCESS_NAMES[] = {
+        "systemd", "sshd", "nginx", "postgres", "java", "python3", "node", "bash",
+        "containerd", "dockerd", "redis-server", "envoy", "chronyd", "rsyslogd", "cron", "agetty"
+    };
+    const size_t PROCESS_NAME_COUNT = sizeof(PROCESS_NAMES) / sizeof(PROCESS_NAMES[0]);
+
+    // cpuinfo中每个处理器条目的固定部分
+    const char* const CPU_FLAGS =
+        "flags\t\t: fpu vme de pse tsc msr pae mce cx8 apic sep mtrr pge mca cmov pat pse36 clflush "
+        "mmx fxsr sse sse2 ss ht syscall nx pdpe1gb rdtscp lm constant_tsc rep_good nopl "
+        "xtopology nonstop_tsc cpuid pni pclmulqdq ssse3 fma cx16 pcid sse4_1 sse4_2 x2apic "
+        "movbe popcnt aes xsave avx f16c rdrand hypervisor lahf_lm abm 3dnowprefetch avx2 "
+        "avx512f avx512dq avx512bw avx512vl\nbogomips\t: 5799.99\nclflush size\t: 64\n"
+        "address sizes\t: 46 bits physical, 48 bits virtual\n\n";
+
+    // status中内存信息之后的固定部分
+    const char* const STATUS_SIGNALS =
+        "SigQ:\t0/63476\nSigPnd:\t0000000000000000\nShdPnd:\t0000000000000000\n"
+        "SigBlk:\t0000000000000000\nSigIgn:\t0000000000001000\nSigCgt:\t0000000180004a02\n"
+        "CapInh:\t0000000000000000\nCapPrm:\t0000000000000000\nCapEff:\t0000000000000000\n"
+        "CapBnd:\t000001ffffffffff\nCapAmb:\t0000000000000000\nNoNewPrivs:\t0\nSeccomp:\t0\n"
+        "Speculation_Store_Bypass:\tthread vulnerable\nCpus_allowed:\tffff\nCpus_allowed_list:\t0-15\n"
+        "Mems_allowed:\t00000001\nMems_allowed_list:\t0\n";
+
+    // 第一个用户进程的PID
+    const unsigned int FIRST_PID = 300;
+
+    // 目录布局版本，生成规则改变时递增，使已有的目录被重新生成
+    const unsigned int FIXTURE_LAYOUT = 2;
+
+    /**
+     * 确定性的伪随机数（xorshift32）
+     */
+    class Random {
+    public:
+        explicit Random(unsigned int seed) : state(seed != 0 ? seed : 0x9E3779B9u) {}
+
+        unsigned int next() {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+
+        /**
+         * 获取[lo, hi]之间的值
+         */
+        unsigned long long range(unsigned long long lo, unsigned long long hi) {
+            return lo + next() % (hi - lo + 1);
+        }
+
+    private:
+        unsigned int state;
+    };
+
+    /**
+     * 创建目录（已存在视为成功）
+     */
+    bool makeDirectory(const std::string& path) {
+        return CreateDirectoryA(path.c_str(), nullptr) || GetLastError() == ERROR_ALREADY_EXISTS;
+    }
+
+    /**
+     * 逐级创建目录
+     */
+    bool makeDirectories(const std::string& path) {
+        for (size_t pos = path.find_first_of("/\\", 1); pos != std::string::npos; pos = path.find_first_of("/\\", pos + 1)) {
+            if (path[pos - 1] != ':' && path[pos - 1] != '/' && path[pos - 1] != '\\') {
+                makeDirectory(path.substr(0, pos));
+            }
+        }
+        return makeDirectory(path);
+    }
+
+    /**
+     * 写入整个文件
+     */
+    bool writeFile(const std::string& path, const std::string& content) {
+        FILE* file = fopen(path.c_str(), "wb");
+        if (file == nullptr) {
+            return false;
+        }
+        const bool ok = fwrite(content.data(), 1, content.size(), file) == content.size();
+        return fclose(file) == 0 && ok;
+    }
+
+    /**
+     * 规格标记（写在根目录的.fixture文件中）
+     */
+    std::string specMarker(const ProcfsFixtureSpec& spec) {
+        std::string marker;
+        utils::StringSink sink(marker);
+        EVAN_FORMAT(sink, "layout={} processes={} threads={} sockets={} cgroups={} cpus={} seed={}\n",
+                    FIXTURE_LAYOUT, spec.processes, spec.threads, spec.sockets, spec.cgroups, spec.cpus, spec.seed);
+        return marker;
+    }
+
+    /**
+     * 一个合成进程
+     */
+    struct FixtureProcess {
+        unsigned int pid;
+        unsigned int ppid;
+        std::string name;
+        bool kernel;                  ///< 内核线程没有内存信息和命令行
+        unsigned long long rss_kb;
+        unsigned long long swap_kb;
+        unsigned long long vsize_kb;
+        unsigned int cgroup;
+    };
+
+    /**
+     * 写入/proc/<pid>/stat格式的一行（进程或线程）
+     */
+    void formatStat(std::string& out, const FixtureProcess& proc, unsigned int id, unsigned int threads, Random& random) {
+        out.clear();
+        utils::StringSink sink(out);
+        EVAN_FORMAT(sink, "{} ({}) S {} {} {} 0 -1 {} {} 0 {} 0 {} {} 0 0 20 0 {} 0 {} {} {} ",
+                    id, proc.name, proc.ppid, proc.pid, proc.pid, proc.kernel ? 69238880u : 4194560u,
+                    random.range(100, 500000), random.range(0, 200),
+                    random.range(0, 900000), random.range(0, 300000),
+                    threads, random.range(1000, 9000000), proc.vsize_kb * 1024, proc.rss_kb / 4);
+        EVAN_FORMAT(sink, "18446744073709551615 1 1 0 0 0 0 0 4096 16384 0 0 0 17 {} 0 0 0 0 0 0 0 0 0 0 0 0 0\n",
+                    random.range(0, 15));
+    }
+
+    /**
+     * 写入/proc/<pid>/status
+     */
+    void formatStatus(std::string& out, const FixtureProcess& proc, unsigned int threads, Random& random) {
+        out.clear();
+        utils::StringSink sink(out);
+        const unsigned int uid = proc.kernel ? 0 : static_cast<unsigned int>(random.range(0, 1) * 1000);
+        EVAN_FORMAT(sink, "Name:\t{}\nUmask:\t0022\nState:\tS (sleeping)\nTgid:\t{}\nNgid:\t0\nPid:\t{}\nPPid:\t{}\n"
+                          "TracerPid:\t0\nUid:\t{}\t{}\t{}\t{}\nGid:\t{}\t{}\t{}\t{}\nFDSize:\t{}\nGroups:\t\n"
+                          "NStgid:\t{}\nNSpid:\t{}\nNSpgid:\t{}\nNSsid:\t{}\n",
+                    proc.name, proc.pid, proc.pid, proc.ppid,
+                    uid, uid, uid, uid, uid, uid, uid, uid, proc.kernel ? 64u : 256u,
+                    proc.pid, proc.pid, proc.pid, proc.pid);
+        if (!proc.kernel) {
+            EVAN_FORMAT(sink, "VmPeak:\t{:>8} kB\nVmSize:\t{:>8} kB\nVmLck:\t       0 kB\nVmPin:\t       0 kB\n"
+                              "VmHWM:\t{:>8} kB\nVmRSS:\t{:>8} kB\nRssAnon:\t{:>8} kB\nRssFile:\t{:>8} kB\n",
+                        proc.vsize_kb + 2048, proc.vsize_kb, proc.rss_kb + 512, proc.rss_kb,
+                        proc.rss_kb * 3 / 4, proc.rss_kb / 4);
+            EVAN_FORMAT(sink, "RssShmem:\t       0 kB\nVmData:\t{:>8} kB\nVmStk:\t     132 kB\nVmExe:\t{:>8} kB\n"
+                              "VmLib:\t{:>8} kB\nVmPTE:\t{:>8} kB\nVmSwap:\t{:>8} kB\n",
+                        proc.vsize_kb / 2, random.range(100, 20000), random.range(1000, 50000),
+                        random.range(40, 4000), proc.swap_kb);
+            out.append("HugetlbPages:\t       0 kB\nCoreDumping:\t0\nTHP_enabled:\t1\n");
+        }
+        EVAN_FORMAT(sink, "Threads:\t{}\n", threads);
+        out.append(STATUS_SIGNALS);
+        EVAN_FORMAT(sink, "voluntary_ctxt_switches:\t{}\nnonvoluntary_ctxt_switches:\t{}\n",
+                    random.range(10, 1000000), random.range(0, 50000));
+    }
+
+    /**
+     * 写入全局文件（meminfo、cpuinfo、stat）
+     */
+    bool writeGlobalFiles(const std::string& root, const ProcfsFixtureSpec& spec, unsigned long long totalRssKb,
+                          unsigned long long totalSwapKb, Random& random) {
+        std::string content;
+        utils::StringSink sink(content);
+
+        const unsigned long long memTotal = totalRssKb * 2 + 4ULL * 1024 * 1024;
+        const unsigned long long swapTotal = totalSwapKb * 2 + 2ULL * 1024 * 1024;
+        EVAN_FORMAT(sink, "MemTotal:       {:>10} kB\nMemFree:        {:>10} kB\nMemAvailable:   {:>10} kB\n"
+                          "Buffers:        {:>10} kB\nCached:         {:>10} kB\nSwapCached:              0 kB\n",
+                    memTotal, memTotal - totalRssKb - memTotal / 8, memTotal - totalRssKb,
+                    memTotal / 64, memTotal / 8);
+        EVAN_FORMAT(sink, "Active:         {:>10} kB\nInactive:       {:>10} kB\nSwapTotal:      {:>10} kB\n"
+                          "SwapFree:       {:>10} kB\nDirty:                 128 kB\nWriteback:               0 kB\n",
+                    totalRssKb, memTotal / 16, swapTotal, swapTotal - totalSwapKb);
+        EVAN_FORMAT(sink, "AnonPages:      {:>10} kB\nMapped:         {:>10} kB\nShmem:              65536 kB\n"
+                          "Slab:           {:>10} kB\nPageTables:     {:>10} kB\n",
+                    totalRssKb * 3 / 4, totalRssKb / 4, memTotal / 32,
+                    static_cast<unsigned long long>(spec.processes) * 40);
+        EVAN_FORMAT(sink, "CommitLimit:    {:>10} kB\nCommitted_AS:   {:>10} kB\nVmallocTotal:   34359738367 kB\n"
+                          "HugePages_Total:       0\nHugepagesize:       2048 kB\n",
+                    memTotal / 2 + swapTotal, totalRssKb * 3);
+        if (!writeFile(root + "/meminfo", content)) {
+            return false;
+        }
+
+        content.clear();
+        for (unsigned int cpu = 0; cpu < spec.cpus; ++cpu) {
+            EVAN_FORMAT(sink, "processor\t: {}\nvendor_id\t: GenuineIntel\ncpu family\t: 6\nmodel\t\t: 106\n"
+                              "model name\t: Intel(R) Xeon(R) Platinum 8375C CPU @ 2.90GHz\nstepping\t: 6\n"
+                              "cpu MHz\t\t: {}.000\ncache size\t: 55296 KB\n",
+                        cpu, random.range(2900, 3500));
+            EVAN_FORMAT(sink, "physical id\t: 0\nsiblings\t: {}\ncore id\t\t: {}\ncpu cores\t: {}\napicid\t\t: {}\n"
+                              "fpu\t\t: yes\ncpuid level\t: 27\n",
+                        spec.cpus, cpu / 2, spec.cpus / 2, cpu);
+            content.append(CPU_FLAGS);
+        }
+        if (!writeFile(root + "/cpuinfo", content)) {
+            return false;
+        }
+
+        content.clear();
+        EVAN_FORMAT(sink, "cpu  {} {} {} {} {} 0 {} 0 0 0\n",
+                    random.range(1000000, 9000000), random.range(0, 10000), random.range(100000, 900000),
+                    random.range(10000000, 90000000), random.range(1000, 90000), random.range(1000, 90000));
+        for (unsigned int cpu = 0; cpu < spec.cpus; ++cpu) {
+            EVAN_FORMAT(sink, "cpu{} {} {} {} {} {} 0 {} 0 0 0\n", cpu,
+                        random.range(100000, 900000), random.range(0, 1000), random.range(10000, 90000),
+                        random.range(1000000, 9000000), random.range(100, 9000), random.range(100, 9000));
+        }
+        EVAN_FORMAT(sink, "ctxt {}\nbtime 1760000000\nprocesses {}\nprocs_running {}\nprocs_blocked 0\n",
+                    random.range(100000000, 900000000), spec.processes * 3, random.range(1, spec.cpus));
+        return writeFile(root + "/stat", content);
+    }
+}
+
+/**
+ * 生成合成的procfs目录
+ * @param root 根目录
+ * @param spec 规模
+ * @return 成功返回true
+ */
+bool procfs_fixture_write(const std::string& root, const ProcfsFixtureSpec& spec) {
+    if (!makeDirectories(root) || !makeDirectory(root + "/net")) {
+        return false;
+    }
+
+    Random random(spec.seed);
+    std::string content;
+    std::string sockets("  sl  local_address rem_address   st tx_queue rx_queue tr tm->when retrnsmt   uid  timeout inode\n");
+    utils::StringSink socketSink(sockets);
+    unsigned long long totalRssKb = 0;
+    unsigned long long totalSwapKb = 0;
+    unsigned int socketIndex = 0;
+
+    // 用户进程的PID为FIRST_PID + i，内核线程排在所有用户进程之后，两个范围不重叠
+    const unsigned int firstKernelPid = FIRST_PID + spec.processes;
+    std::vector<bool> usedPids(firstKernelPid + spec.processes / 10 + 1, false);
+
+    for (unsigned int i = 0; i < spec.processes; ++i) {
+        FixtureProcess proc;
+        proc.kernel = i % 10 == 0;
+        proc.pid = proc.kernel ? firstKernelPid + i / 10 : FIRST_PID + i;
+        if (usedPids[proc.pid]) {
+            EVAN_FPRINT(stderr, "Error: Duplicate fixture PID {}.\n", proc.pid);
+            return false;
+        }
+        usedPids[proc.pid] = true;
+        proc.ppid = proc.kernel ? firstKernelPid : (i < 16 ? 1 : FIRST_PID + static_cast<unsigned int>(random.range(0, i - 1)));
+        proc.cgroup = spec.cgroups != 0 ? i % spec.cgroups : 0;
+        // 大多数进程几MB到几十MB，约二十分之一是几百MB到2GB的大进程
+        proc.rss_kb = proc.kernel ? 0 : (random.range(0, 19) == 0 ? random.range(256 * 1024, 2048 * 1024)
+                                                                   : random.range(1024, 64 * 1024));
+        proc.swap_kb = proc.kernel || random.range(0, 3) != 0 ? 0 : random.range(0, 64 * 1024);
+        proc.vsize_kb = proc.kernel ? 0 : proc.rss_kb * random.range(2, 20);
+        {
+            utils::StringSink nameSink(proc.name);
+            if (proc.kernel) {
+                EVAN_FORMAT(nameSink, "kworker/{}:{}", i / 10 % (spec.cpus != 0 ? spec.cpus : 1), i % 7);
+            } else {
+                EVAN_FORMAT(nameSink, "{}-{}", PROCESS_NAMES[i % PROCESS_NAME_COUNT], i);
+            }
+        }
+        totalRssKb += proc.rss_kb;
+        totalSwapKb += proc.swap_kb;
+
+        utils::StackBuffer<512> dirBuffer;
+        EVAN_FORMAT(dirBuffer, "{}/{}", root, proc.pid);
+        const std::string dir(dirBuffer.data(), dirBuffer.size());
+        const unsigned int threads = spec.threads != 0 ? spec.threads : 1;
+        if (!makeDirectory(dir) || !makeDirectory(dir + "/task")) {
+            return false;
+        }
+
+        formatStat(content, proc, proc.pid, threads, random);
+        if (!writeFile(dir + "/stat", content)) {
+            return false;
+        }
+        formatStatus(content, proc, threads, random);
+        if (!writeFile(dir + "/status", content)) {
+            return false;
+        }
+
+        content.clear();
+        if (!proc.kernel) {
+            utils::StringSink sink(content);
+            EVAN_FORMAT(sink, "/usr/bin/{}", PROCESS_NAMES[i % PROCESS_NAME_COUNT]);
+            content.push_back('\0');
+            EVAN_FORMAT(sink, "--config=/etc/{}.conf", PROCESS_NAMES[i % PROCESS_NAME_COUNT]);
+            content.push_back('\0');
+        }
+        if (!writeFile(dir + "/cmdline", content)) {
+            return false;
+        }
+
+        content.clear();
+        {
+            utils::StringSink sink(content);
+            if (proc.kernel) {
+                EVAN_FORMAT(sink, "0::/\n");
+            } else {
+                EVAN_FORMAT(sink, "0::/system.slice/svc-{}.service\n", proc.cgroup);
+            }
+        }
+        if (!writeFile(dir + "/cgroup", content)) {
+            return false;
+        }
+
+        for (unsigned int t = 0; t < threads; ++t) {
+            const unsigned int tid = t == 0 ? proc.pid : 1000000 + i * threads + t;
+            utils::StackBuffer<64> tidName;
+            EVAN_FORMAT(tidName, "/task/{}", tid);
+            const std::string taskDir = dir + tidName.c_str();
+            formatStat(content, proc, tid, threads, random);
+            if (!makeDirectory(taskDir) || !writeFile(taskDir + "/stat", content)) {
+                return false;
+            }
+        }
+
+        if (!proc.kernel) {
+            for (unsigned int s = 0; s < spec.sockets; ++s, ++socketIndex) {
+                const bool listening = s == 0;
+                EVAN_FORMAT(socketSink, "{:>4}: 0100007F:{:04X} {}:{:04X} {} 00000000:00000000 00:00000000 00000000 {:>5} "
+                                        "       0 {} 1 0000000000000000 20 4 30 10 -1\n",
+                            socketIndex, static_cast<unsigned int>(1024 + socketIndex % 60000),
+                            listening ? "00000000" : "0A00020F",
+                            listening ? 0u : static_cast<unsigned int>(random.range(1024, 65535)),
+                            listening ? "0A" : "01", proc.pid % 2 == 0 ? 0u : 1000u,
+                            100000 + socketIndex);
+            }
+        }
+    }
+
+    if (!writeFile(root + "/net/tcp", sockets) ||
+        !writeGlobalFiles(root, spec, totalRssKb, totalSwapKb, random)) {
+        return false;
+    }
+    return writeFile(root + "/.fixture", specMarker(spec));
+}
+
+/**
+ * 准备合成的procfs目录（规格相同时复用）
+ * @param root 根目录
+ * @param spec 规模
+ * @return 成功返回true
+ */
+bool procfs_fixture_prepare(const std::string& root, const ProcfsFixtureSpec& spec) {
+    const std::string marker = specMarker(spec);
+    FILE* file = fopen((root + "/.fixture").c_str(), "rb");
+    if (file != nullptr) {
+        char existing[256];
+        const size_t n = fread(existing, 1, sizeof(existing), file);
+        fclose(file);
+        if (std::string(existing, n) == marker) {
+            return true;
+        }
+    }
+    return procfs_fixture_write(root, spec);
+}
+
+} // namespace bench
+} // namespace evan
@@ -0,0 +1,44 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <string>
+
+namespace evan {
+namespace bench {
+
+/**
+ * 合成procfs目录的规模
+ */
+struct ProcfsFixtureSpec {
+    unsigned int processes;   ///< 进程数
+    unsigned int threads;     ///< 每个进程的线程数（task/<tid>）
+    unsigned int sockets;     ///< 每个进程的TCP套接字数（net/tcp中的行）
+    unsigned int cgroups;     ///< cgroup数量（进程轮流分配）
+    unsigned int cpus;        ///< 处理器数（cpuinfo中的条目）
+    unsigned int seed;        ///< 随机数种子（相同的规格和种子生成相同的内容）
+
+    ProcfsFixtureSpec() : processes(1000), threads(4), sockets(2), cgroups(32), cpus(16), seed(1) {}
+};
+
+/**
+ * 生成合成的procfs目录
+ * 目录结构与Linux的/proc一致：meminfo、cpuinfo、stat、net/tcp，以及每个进程的
+ * stat、status、cmdline、cgroup和task/<tid>/stat；约十分之一的进程是没有内存信息的内核线程
+ * @param root 根目录（不存在时逐级创建）
+ * @param spec 规模
+ * @return 成功返回true
+ */
+bool procfs_fixture_write(const std::string& root, const ProcfsFixtureSpec& spec);
+
+/**
+ * 准备合成的procfs目录：根目录中的规格标记与spec相同时直接复用，否则重新生成
+ * @param root 根目录
+ * @param spec 规模
+ * @return 成功返回true
+ */
+bool procfs_fixture_prepare(const std::string& root, const ProcfsFixtureSpec& spec);
+
+} // namespace bench
+} // namespace evan
@@ -0,0 +1,46 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "procfs_fixture.h"
+#include "utils/command_line.h"
+#include "utils/format.h"
+
+/**
+ * 合成procfs目录生成器入口
+ * 生成的目录可以直接交给evanOS --proc-root使用：
+ *   evanOS_procfs_fixture --root fixture --processes 10000 --threads 8
+ *   evanOS --proc-root fixture --each --total
+ */
+int main(int argc, char** argv) {
+    evan::bench::ProcfsFixtureSpec spec;
+
+    cmdline::parser par;
+    par.set_program_name("evanOS_procfs_fixture");
+    par.add("root", 'o', "directory to write the synthetic procfs tree into.", true, std::string(""));
+    par.add("processes", 'n', "number of processes (default 1000).", false, spec.processes);
+    par.add("threads", 't', "threads per process (default 4).", false, spec.threads);
+    par.add("sockets", 's', "TCP sockets per user process (default 2).", false, spec.sockets);
+    par.add("cgroups", 'g', "number of cgroups processes are spread across (default 32).", false, spec.cgroups);
+    par.add("cpus", 'c', "number of processors in cpuinfo (default 16).", false, spec.cpus);
+    par.add("seed", 'S', "random seed; the same spec and seed produce the same tree (default 1).", false, spec.seed);
+    par.add("help", '?', "show help message.");
+    if (!par.parse(argc, argv) || par.exist("help")) {
+        std::cout << par.error() << par.usage();
+        return par.exist("help") ? 0 : 1;
+    }
+
+    spec.processes = par.get<unsigned int>("processes");
+    spec.threads = par.get<unsigned int>("threads");
+    spec.sockets = par.get<unsigned int>("sockets");
+    spec.cgroups = par.get<unsigned int>("cgroups");
+    spec.cpus = par.get<unsigned int>("cpus");
+    spec.seed = par.get<unsigned int>("seed");
+
+    const std::string root = par.get<std::string>("root");
+    if (!evan::bench::procfs_fixture_write(root, spec)) {
+        EVAN_FPRINT(stderr, "Error: Unable to write procfs fixture {}.\n", root);
+        return 1;
+    }
+    EVAN_PRINT("Wrote {} processes ({} threads each) to {}.\n", spec.processes, spec.threads, root);
+    return 0;
+}
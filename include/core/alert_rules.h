@@ -0,0 +1,220 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "utils/string_view.h"
+
+namespace evan {
+    class AlertSink;
+    class Collector;
+    struct TickSources;
+
+    /**
+     * 进程表的数值列（按KB保存字节数，32位无符号整数最大表示4TB）
+     */
+    enum AlertColumn {
+        ALERT_COLUMN_RSS,        ///< proc.rss：工作集（KB）
+        ALERT_COLUMN_PAGEFILE,   ///< proc.pagefile：页面文件使用量（KB）
+        ALERT_COLUMN_PID,        ///< proc.pid：进程ID
+        ALERT_COLUMN_COUNT
+    };
+
+    /**
+     * 系统级字段（每次循环一个值）
+     */
+    enum AlertSystemField {
+        ALERT_SYS_MEM_USED_PCT,   ///< sys.mem.used_pct：物理内存使用率（0-100）
+        ALERT_SYS_MEM_USED,       ///< sys.mem.used：已用物理内存（字节）
+        ALERT_SYS_MEM_AVAIL,      ///< sys.mem.avail：可用物理内存（字节）
+        ALERT_SYS_MEM_TOTAL,      ///< sys.mem.total：物理内存总量（字节）
+        ALERT_SYS_SWAP_USED_PCT,  ///< sys.swap.used_pct：提交量占提交限制的比例（0-100）
+        ALERT_SYS_PROC_COUNT,     ///< sys.proc_count：进程数
+        ALERT_SYS_FIELD_COUNT
+    };
+
+    /**
+     * 系统字段名（与规则中的写法相同，如"sys.mem.used_pct"）
+     * @param field 字段
+     */
+    const char* evos_alert_system_field_name(AlertSystemField field);
+
+    /**
+     * 从本次循环的数据源计算系统字段（数据源读取失败的字段为0）
+     * @param sources 数据源（SOURCE_MEMORY_STATUS和SOURCE_PROCESS_TABLE）
+     * @param system [out] ALERT_SYS_FIELD_COUNT个字段值
+     */
+    void evos_alert_system_load(const TickSources& sources, double* system);
+
+    /**
+     * 规则的输入：每次循环从数据源转换一次的列式进程表和系统字段
+     * 所有规则共用同一份输入，数值列连续存放以便SimdScan::rangeMask按64行一组过滤；
+     * 每组另外保存最小值和最大值，区间与整组不相交或包含整组时不需要扫描该组
+     */
+    struct AlertInputs {
+        size_t rows;                                   ///< 进程数
+        std::vector<uint32_t> columns[ALERT_COLUMN_COUNT];
+        std::vector<uint32_t> minimum[ALERT_COLUMN_COUNT];   ///< 每64行一组的最小值
+        std::vector<uint32_t> maximum[ALERT_COLUMN_COUNT];   ///< 每64行一组的最大值
+        uint32_t lowest[ALERT_COLUMN_COUNT];                 ///< 整列的最小值
+        uint32_t highest[ALERT_COLUMN_COUNT];                ///< 整列的最大值
+        std::vector<utils::StringView> names;          ///< 进程名（指向本次循环的Arena）
+        double system[ALERT_SYS_FIELD_COUNT];
+
+        AlertInputs();
+
+        /**
+         * 从本次循环的数据源转换（复用各列已有的容量）
+         * @param sources 数据源（需要SOURCE_MEMORY_STATUS和SOURCE_PROCESS_TABLE）
+         */
+        void load(const TickSources& sources);
+
+        /**
+         * 根据rows和columns重新计算每组和整列的最小值、最大值（load()会调用，直接填充各列时需要调用）
+         */
+        void summarize();
+    };
+
+    /**
+     * 告警状态变化
+     */
+    struct AlertEvent {
+        size_t rule;           ///< 规则下标
+        bool firing;           ///< true为开始告警，false为恢复
+        unsigned long pid;     ///< 进程规则的进程ID（系统规则为0）
+        std::string process;   ///< 进程规则的进程名
+    };
+
+    /**
+     * 告警规则集
+     * 每条规则启动时编译一次为紧凑的节点数组：数值比较转换为闭区间（按列的单位取整），
+     * 常量区间折叠为真/假，&&和||的两个操作数按代价交换使代价低的先执行；
+     * 每次循环按候选位图求值：&&的右侧只处理左侧为真的行，||的右侧只处理左侧为假的行，
+     * 数值比较先按每组的最小值和最大值跳过整组，其余的组由SimdScan::rangeMask处理，
+     * 进程名匹配只对剩余的候选行执行。
+     *
+     * 规则文件每行一条规则，空行和以'#'开头的行被忽略：
+     *     [名称:] 表达式 [for 持续时间]
+     * 例如：
+     *     java_rss: proc.rss > 8G && proc.name ~ "java"
+     *     mem_pressure: sys.mem.used_pct > 90 for 30s
+     * 表达式支持||、&&、!和括号；比较运算符为> >= < <= == !=，进程名还支持~和!~
+     * （忽略大小写的通配符匹配，不含'*'和'?'的模式按子串匹配）；数值可以带K/M/G/T后缀（1024进制）；
+     * 持续时间单位为ms、s、m、h（默认s），条件持续满足这么久才开始告警。
+     * 含有进程字段的规则按进程分别跟踪状态，事件中带有进程ID和名称
+     */
+    class AlertRuleSet {
+    public:
+        AlertRuleSet() : generation(0) {}
+
+        /**
+         * 读取规则文件
+         * @param path 文件路径
+         * @return 全部编译成功返回true，否则输出错误信息（文件、行、列）并返回false
+         */
+        bool load(const std::string& path);
+
+        /**
+         * 编译规则文本
+         * @param text 规则文本（多行）
+         * @param origin 错误信息中的来源名称
+         * @return 全部编译成功返回true，否则输出错误信息并返回false
+         */
+        bool parse(utils::StringView text, const std::string& origin);
+
+        /**
+         * 对本次循环的输入求值所有规则，状态变化时追加事件
+         * @param inputs 输入
+         * @param now_ms 单调时钟（毫秒），用于持续时间
+         * @param events [out] 状态变化（追加）
+         */
+        void evaluate(const AlertInputs& inputs, unsigned long long now_ms, std::vector<AlertEvent>& events);
+
+        size_t size() const { return rules.size(); }
+        const std::string& name(size_t rule) const { return rules[rule].name; }
+        const std::string& text(size_t rule) const { return rules[rule].text; }
+
+        /**
+         * 正在告警的数量（进程规则按进程计数）
+         */
+        size_t firing() const;
+
+    private:
+        /**
+         * 编译后的节点
+         */
+        struct Node {
+            uint8_t kind;      ///< NODE_*
+            uint8_t field;     ///< 数值列或系统字段
+            uint8_t op;        ///< 系统字段的比较运算符
+            bool negate;       ///< 区间和进程名匹配取反
+            uint32_t left;     ///< 子节点或模式下标
+            uint32_t right;    ///< 右子节点
+            uint32_t low;      ///< 区间下界（常量节点为0或1）
+            uint32_t span;     ///< 区间上界与下界之差
+            double value;      ///< 系统字段比较的常量
+        };
+
+        /**
+         * 进程规则中单个进程的状态
+         */
+        struct ProcessState {
+            unsigned long long since;   ///< 开始满足条件的时间
+            unsigned long long tick;    ///< 最后一次满足条件的求值序号
+            bool firing;
+            std::string process;        ///< 开始告警时的进程名
+        };
+
+        struct Rule {
+            std::string name;
+            std::string text;                  ///< 表达式原文
+            std::vector<Node> nodes;
+            std::vector<std::string> patterns; ///< 进程名模式
+            uint32_t root;
+            uint32_t depth;                    ///< 节点树深度（决定临时位图的数量）
+            unsigned long long duration_ms;
+            bool per_process;                  ///< 是否含有进程字段
+            // 状态
+            bool matching;                     ///< 系统规则：上一次是否满足条件
+            bool firing;                       ///< 系统规则：是否正在告警
+            unsigned long long since;          ///< 系统规则：开始满足条件的时间
+            std::unordered_map<unsigned long, ProcessState> processes;
+        };
+
+        class Parser;
+
+        bool evalNode(const Rule& rule, uint32_t index, const AlertInputs& inputs, size_t words,
+                      const uint64_t* candidates, uint64_t* out, uint64_t* scratch) const;
+        void track(Rule& rule, size_t index, const AlertInputs& inputs, const uint64_t* mask,
+                   unsigned long long now_ms, std::vector<AlertEvent>& events);
+
+        std::vector<Rule> rules;
+        std::vector<uint64_t> candidates;   ///< 求值时的临时位图（跨循环复用）
+        std::vector<uint64_t> result;
+        std::vector<uint64_t> scratch;
+        unsigned long long generation;      ///< 求值序号
+    };
+
+    /**
+     * 生成告警事件的NDJSON行（不含换行）
+     * {"time":"...","rule":"...","state":"firing|resolved","expr":"...","pid":...,"process":"..."}
+     * @param rules 规则集
+     * @param event 事件
+     * @return JSON行
+     */
+    std::string evos_alert_event_json(const AlertRuleSet& rules, const AlertEvent& event);
+
+    /**
+     * 创建告警采集器（--alerts）
+     * 每次循环求值所有规则，状态变化写入sink，并显示规则数和正在告警的数量
+     * @param rules 规则集（所有权转移给采集器）
+     * @param sink 告警输出（可以与其他采集器共享），为空时写入标准输出
+     * @return 采集器，由调用方（注册表）持有
+     */
+    Collector* evos_alerts_collector_create(AlertRuleSet* rules, const std::shared_ptr<AlertSink>& sink);
+}
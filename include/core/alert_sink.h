@@ -0,0 +1,43 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace evan {
+    /**
+     * exec:输出中等待启动命令的事件数上限（超过时丢弃新事件）
+     */
+    const size_t ALERT_EXEC_QUEUE_MAX = 1024;
+
+    /**
+     * 告警输出
+     * 每个告警事件一行NDJSON（见evos_alert_event_json），由采集器线程调用；
+     * --alerts、--anomalies和--leaks共用同一个输出，并行执行时可能同时调用send()
+     */
+    class AlertSink {
+    public:
+        virtual ~AlertSink() {}
+
+        /**
+         * 输出一个事件
+         * @param line JSON行（不含换行）
+         */
+        virtual void send(const std::string& line) = 0;
+    };
+
+    /**
+     * 创建告警输出（--alert-sink）
+     *     stdout（默认）   写入标准输出（与其他采集器的输出在一起）
+     *     file:<路径>      追加到文件，每个事件一行
+     *     exec:<命令>      在一个后台线程中启动命令，JSON行写入命令的标准输入（积压的事件合并为一次命令）
+     *     unix:<路径>      写入Unix域套接字（流式），断开后在下一个事件时重新连接
+     * 返回的输出以互斥锁串行化send()，可以由多个采集器共享（各自持有一个shared_ptr）
+     * @param spec 输出说明，为空表示标准输出
+     * @return 输出对象，无法识别或无法打开时输出错误信息并返回空指针
+     */
+    std::shared_ptr<AlertSink> evos_alert_sink_create(const std::string& spec);
+}
@@ -0,0 +1,132 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "core/alert_rules.h"
+#include "utils/streaming_stats.h"
+
+namespace evan {
+    class AlertSink;
+    class Collector;
+    struct TickSources;
+
+    /**
+     * 默认的异常阈值（稳健z值的绝对值）
+     */
+    const double DEFAULT_ANOMALY_THRESHOLD = 4.0;
+
+    /**
+     * 异常检测的进程字段
+     */
+    enum AnomalyProcessMetric {
+        ANOMALY_PROC_RSS,        ///< proc.rss：工作集（字节）
+        ANOMALY_PROC_PAGEFILE,   ///< proc.pagefile：页面文件使用量（字节）
+        ANOMALY_PROC_METRIC_COUNT
+    };
+
+    /**
+     * 异常检测的系统字段（物理内存总量不会变化，不检测）
+     */
+    const AlertSystemField ANOMALY_SYS_METRICS[] = {
+        ALERT_SYS_MEM_USED_PCT,
+        ALERT_SYS_MEM_USED,
+        ALERT_SYS_MEM_AVAIL,
+        ALERT_SYS_SWAP_USED_PCT,
+        ALERT_SYS_PROC_COUNT,
+    };
+
+    /**
+     * 异常检测的系统字段数
+     */
+    const size_t ANOMALY_SYS_METRIC_COUNT = sizeof(ANOMALY_SYS_METRICS) / sizeof(ANOMALY_SYS_METRICS[0]);
+    static_assert(ANOMALY_SYS_METRIC_COUNT == ALERT_SYS_FIELD_COUNT - 1,
+                  "ANOMALY_SYS_METRICS must list every sys.* field except sys.mem.total");
+
+    /**
+     * 一个被标记的样本
+     */
+    struct AnomalyFinding {
+        const char* metric;     ///< 字段名（如"sys.mem.used_pct"、"proc.rss"）
+        bool bytes;             ///< 值是否为字节数
+        unsigned long pid;      ///< 进程字段的进程ID（系统字段为0）
+        std::string process;    ///< 进程字段的进程名
+        double value;           ///< 本次的值
+        double median;          ///< 加入本次之前的中位数估计
+        double mad;             ///< 加入本次之前的MAD估计
+        double z;               ///< 相对EWMA均值和标准差的z值
+        double robust_z;        ///< 稳健z值
+    };
+
+    /**
+     * 流式异常检测（--anomalies）
+     * 每个系统字段（与告警规则的sys.*相同）和工作集最大的前N个进程的proc.rss、proc.pagefile
+     * 各有一个utils::StreamingStats，每个样本O(1)更新，不保存历史；
+     * 样本先与之前的统计量比较，稳健z值的绝对值达到阈值时标记，然后才加入统计量。
+     * 进程退出或跌出前N名时丢弃它的统计量，再次进入时重新预热
+     */
+    class AnomalyDetector {
+    public:
+        /**
+         * @param threshold 稳健z值的阈值
+         * @param top 跟踪的进程数（0表示只跟踪系统字段）
+         * @param alpha EWMA平滑系数
+         */
+        AnomalyDetector(double threshold, size_t top, double alpha = utils::STREAMING_DEFAULT_ALPHA)
+            : threshold(threshold), top(top), alpha(alpha), generation(0) {}
+
+        /**
+         * 处理本次循环的样本
+         * @param sources 数据源（SOURCE_MEMORY_STATUS和SOURCE_PROCESS_TABLE）
+         * @param findings [out] 被标记的样本（追加）
+         */
+        void observe(const TickSources& sources, std::vector<AnomalyFinding>& findings);
+
+        /**
+         * 正在跟踪的字段数
+         */
+        size_t tracked() const { return ANOMALY_SYS_METRIC_COUNT + processes.size() * ANOMALY_PROC_METRIC_COUNT; }
+
+        double limit() const { return threshold; }
+
+    private:
+        struct ProcessStats {
+            utils::StreamingStats metrics[ANOMALY_PROC_METRIC_COUNT];
+            unsigned long long seen;    ///< 最后一次在前N名中的循环序号
+        };
+
+        bool score(utils::StreamingStats& stats, double value, AnomalyFinding& finding);
+
+        double threshold;
+        size_t top;
+        double alpha;
+        utils::StreamingStats system[ALERT_SYS_FIELD_COUNT];
+        double values[ALERT_SYS_FIELD_COUNT];
+        std::unordered_map<unsigned long, ProcessStats> processes;
+        std::vector<size_t> order;          ///< 选择前N个进程的下标（跨循环复用）
+        unsigned long long generation;      ///< 循环序号
+    };
+
+    /**
+     * 生成异常样本的NDJSON行（不含换行），与告警事件写入同一个输出
+     * {"time":"...","rule":"anomaly","state":"anomaly","metric":"...","value":...,"median":...,
+     *  "mad":...,"z":...,"robust_z":...,"pid":...,"process":"..."}
+     * @param finding 样本
+     * @return JSON行
+     */
+    std::string evos_anomaly_finding_json(const AnomalyFinding& finding);
+
+    /**
+     * 创建异常检测采集器（--anomalies）
+     * 每次循环显示跟踪的字段数和被标记的样本，被标记的样本同时写入sink
+     * @param threshold 稳健z值的阈值（--anomaly-threshold）
+     * @param top 跟踪的进程数（--anomaly-top）
+     * @param sink 告警输出（可以与其他采集器共享），为空时只在控制台显示
+     * @return 采集器，由调用方（注册表）持有
+     */
+    Collector* evos_anomalies_collector_create(double threshold, size_t top, const std::shared_ptr<AlertSink>& sink);
+}
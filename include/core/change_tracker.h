@@ -0,0 +1,131 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "utils/string_view.h"
+
+namespace evan {
+
+/**
+ * 默认变化阈值（相对上一次值的百分比）
+ */
+const unsigned int DEFAULT_CHANGE_THRESHOLD = 1;
+
+/**
+ * 默认关键帧间隔（循环次数）
+ */
+const unsigned int DEFAULT_KEYFRAME_INTERVAL = 60;
+
+/**
+ * 变化跟踪器
+ * 用于循环模式的--changes-only输出：每次循环记录字段和进程行的值，
+ * 只输出相对上一次变化超过阈值的部分，并每隔固定次数输出一次完整的关键帧
+ *
+ * 输出格式（每行一条，便于写入日志和比较差异）：
+ *   [KEYFRAME 0]               完整输出（进程行以 "=" 开头）
+ *   [TICK 5]                   增量输出的开始
+ *   total.used_phys: 7 GB -> 8 GB
+ *   + process 1234: ...        新出现的进程
+ *   ~ process 1234: ...        数值变化的进程
+ *   - process 1234: ...        已退出的进程
+ *
+ * 字段和进程行的文本在已有的缓冲区上原地更新，字段和进程集合不变时每次循环不分配内存
+ */
+class ChangeTracker {
+public:
+    /**
+     * 构造函数
+     * @param thresholdPercent 变化阈值（相对百分比，0表示任何变化都输出）
+     * @param keyframeInterval 关键帧间隔（循环次数，0表示只在第一次输出关键帧）
+     */
+    ChangeTracker(unsigned int thresholdPercent, unsigned int keyframeInterval);
+
+    /**
+     * 开始新的一次循环
+     * 关键帧的标题在这里立即写入，不支持字段级跟踪的采集器随后输出的完整内容位于标题之后
+     * @param out 输出流（与endTick相同）
+     * @return 本次是否为关键帧
+     */
+    bool beginTick(FILE* out);
+
+    /**
+     * 当前循环是否为关键帧
+     * @return 是关键帧返回true
+     */
+    bool isKeyframe() const { return keyframe; }
+
+    /**
+     * 记录字段
+     * @param key 字段键（如 "total.used_phys"）
+     * @param value 用于比较的数值
+     * @param text 用于显示的文本
+     */
+    void field(utils::StringView key, double value, utils::StringView text);
+
+    /**
+     * 记录进程行
+     * @param pid 进程ID
+     * @param value 用于比较的数值（如工作集大小）
+     * @param text 用于显示的整行文本
+     */
+    void row(unsigned long pid, double value, utils::StringView text);
+
+    /**
+     * 结束本次循环，输出本次的变化（或关键帧）并清理已消失的进程行
+     * @param out 输出流
+     */
+    void endTick(FILE* out);
+
+private:
+    /**
+     * 判断数值变化是否超过阈值
+     */
+    bool exceedsThreshold(double previous, double current) const;
+
+    /**
+     * 在第一次输出前写入本次循环的标题
+     */
+    void writeHeader(FILE* out);
+
+    struct FieldState {
+        std::string key;
+        double value;
+        std::string text;
+        bool dirty;        // 本次循环需要输出
+        std::string previous_text;
+    };
+
+    struct RowState {
+        double value;
+        std::string text;
+        unsigned long tick; // 最后一次出现的循环序号
+        char marker;        // 本次循环的输出标记（'+'/'~'，0表示不输出）
+    };
+
+    double threshold;
+    unsigned int keyframe_interval;
+    unsigned long tick;
+    bool keyframe;
+    bool header_written;
+
+    /**
+     * 按键比较字段（用于在有序数组中查找，不需要构造std::string）
+     */
+    struct FieldKeyLess {
+        bool operator()(const FieldState& state, utils::StringView key) const {
+            return utils::StringView(state.key) < key;
+        }
+    };
+
+    // 字段按键排序，保证输出顺序稳定
+    std::vector<FieldState> fields;
+    std::unordered_map<unsigned long, RowState> rows;
+    std::vector<unsigned long> row_order; // endTick中排序用，跨循环复用
+};
+
+} // namespace evan
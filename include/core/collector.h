@@ -0,0 +1,195 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <windows.h>
+#include "core/monitor_snapshot.h"
+#include "utils/arena.h"
+#include "utils/metrics.h"
+
+namespace evan {
+    class ChangeTracker;
+    class Configuration;
+
+    /**
+     * 数据源（同一次循环内无论有多少采集器使用，都只读取一次）
+     */
+    enum DataSource {
+        SOURCE_MEMORY_STATUS = 1u << 0,   ///< GlobalMemoryStatusEx
+        SOURCE_SYSTEM_INFO = 1u << 1,     ///< GetSystemInfo
+        SOURCE_PROCESS_TABLE = 1u << 2    ///< 进程快照（名称、工作集、页面文件）
+    };
+
+    /**
+     * 数据源集合
+     */
+    typedef unsigned int DataSourceMask;
+
+    /**
+     * 一次循环内读取的数据源
+     * 由CollectorPlan在循环开始时填充，之后所有采集器只读访问（可以并行）；
+     * 进程表的内存来自本次循环的Arena
+     */
+    struct TickSources {
+        DataSourceMask loaded;        ///< 成功读取的数据源
+        MEMORYSTATUSEX memory_status; ///< 内存状态（SOURCE_MEMORY_STATUS）
+        SYSTEM_INFO system_info;      ///< 系统信息（SOURCE_SYSTEM_INFO）
+        ProcessList processes;        ///< 进程表（SOURCE_PROCESS_TABLE）
+
+        /**
+         * 构造函数
+         * @param arena 本次循环的Arena
+         */
+        explicit TickSources(utils::Arena& arena);
+
+        /**
+         * 数据源是否读取成功
+         */
+        bool has(DataSource source) const { return (loaded & source) != 0; }
+    };
+
+    /**
+     * 读取数据源
+     * @param sources 需要的数据源
+     * @param out [out] 读取结果，out.loaded记录成功的数据源
+     * @param arena 保存进程名等数据的Arena
+     * @return 全部读取成功返回true
+     */
+    bool evos_tick_sources_load(DataSourceMask sources, TickSources& out, utils::Arena& arena);
+
+    /**
+     * 采集器
+     * 声明自己依赖的数据源，由执行计划统一读取后传入
+     */
+    class Collector {
+    public:
+        virtual ~Collector() {}
+
+        /**
+         * 采集器名称（与命令行参数名相同）
+         */
+        virtual const char* name() const = 0;
+
+        /**
+         * 依赖的数据源
+         */
+        virtual DataSourceMask sources() const { return 0; }
+
+        /**
+         * 显示本次循环的数据
+         * @param sources 本次循环的数据源
+         * @param config 配置实例，用于格式化输出
+         */
+        virtual void display(const TickSources& sources, const Configuration& config) = 0;
+
+        /**
+         * 把字段交给变化跟踪器（--changes-only模式）
+         * @param sources 本次循环的数据源
+         * @param tracker 变化跟踪器
+         * @param config 配置实例
+         * @return 支持字段级跟踪返回true，否则返回false（调用方只在关键帧中完整显示）
+         */
+        virtual bool watch(const TickSources& /*sources*/, ChangeTracker& /*tracker*/, const Configuration& /*config*/) {
+            return false;
+        }
+    };
+
+    /**
+     * 包装无参数显示函数的采集器（GPU、网络等不依赖共享数据源的功能）
+     */
+    class FunctionCollector : public Collector {
+    public:
+        typedef void (*DisplayFunc)();
+
+        FunctionCollector(const std::string& name, DisplayFunc func) : name_(name), func_(func) {}
+
+        const char* name() const override { return name_.c_str(); }
+        void display(const TickSources&, const Configuration&) override { func_(); }
+
+    private:
+        std::string name_;
+        DisplayFunc func_;
+    };
+
+    /**
+     * 采集器注册表（持有采集器对象）
+     */
+    class CollectorRegistry {
+    public:
+        CollectorRegistry() {}
+        ~CollectorRegistry();
+
+        /**
+         * 注册采集器（同名采集器会替换之前的）
+         * @param collector 采集器，所有权转移给注册表
+         */
+        void add(Collector* collector);
+
+        /**
+         * 按名称查找采集器
+         * @param name 名称
+         * @return 采集器，不存在返回nullptr
+         */
+        Collector* find(const std::string& name) const;
+
+    private:
+        CollectorRegistry(const CollectorRegistry&);
+        CollectorRegistry& operator=(const CollectorRegistry&);
+
+        std::map<std::string, Collector*> collectors;
+    };
+
+    /**
+     * 执行计划
+     * 启动时根据选中的采集器构建一次：合并所有采集器依赖的数据源，
+     * 每次循环先统一读取这些数据源，再按顺序（或并行）执行采集器
+     */
+    class CollectorPlan {
+    public:
+        CollectorPlan() : required(0) {}
+
+        /**
+         * 追加采集器（按显示顺序）
+         * @param collector 采集器（由注册表持有）
+         */
+        void add(Collector* collector);
+
+        /**
+         * 读取本次循环需要的数据源
+         * @param out [out] 数据源
+         * @param arena 本次循环的Arena
+         * @return 全部读取成功返回true
+         */
+        bool load(TickSources& out, utils::Arena& arena) const;
+
+        /**
+         * 所有采集器依赖的数据源
+         */
+        DataSourceMask sources() const { return required; }
+
+        size_t size() const { return steps.size(); }
+        bool empty() const { return steps.empty(); }
+        Collector* operator[](size_t index) const { return steps[index]; }
+
+        /**
+         * 采集器的耗时直方图（"collector.<名称>_us"，构建计划时注册）
+         * @param index 采集器在计划中的下标
+         */
+        utils::MetricHistogram& latency(size_t index) const { return *latencies[index]; }
+
+    private:
+        std::vector<Collector*> steps;
+        std::vector<utils::MetricHistogram*> latencies;
+        DataSourceMask required;
+    };
+
+    /**
+     * 注册内置采集器（perf、sys、total、each、hardware）
+     * @param registry 注册表
+     */
+    void evos_builtin_collectors_register(CollectorRegistry& registry);
+}
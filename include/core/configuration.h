@@ -5,6 +5,8 @@
 
 #include <string>
 #include <mutex>
+#include "utils/arena.h"
+#include "utils/format.h"
 
 namespace evan {
 
@@ -47,18 +49,33 @@ public:
      */
     std::string config_byte_to_str(unsigned long long byte) const;
     
+    /**
+     * 将字节数转换为可读字符串，结果保存在Arena中（用于循环中的热点路径，不分配堆内存）
+     * @param byte 字节数
+     * @param arena 本次循环的Arena
+     * @return 指向Arena中字符串的视图（以'\0'结尾）
+     */
+    utils::StringView config_byte_to_str(unsigned long long byte, utils::Arena& arena) const;
+    
     /**
      * 重置为默认配置
      */
     void config_reset();
     
 private:
+    /**
+     * 将字节数格式化到输出目标
+     * @param byte 字节数
+     * @param sink 输出目标
+     */
+    void writeBytes(unsigned long long byte, utils::FormatSink& sink) const;
+    
     /**
      * 自动转换字节数
      * @param byte 字节数
-     * @return 转换后的字符串
+     * @param sink 输出目标
      */
-    std::string autoConvertBytes(unsigned long long byte) const;
+    void autoConvertBytes(unsigned long long byte, utils::FormatSink& sink) const;
     
     /**
      * 字节转换配置
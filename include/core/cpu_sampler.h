@@ -0,0 +1,80 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <windows.h>
+
+namespace evan {
+
+/**
+ * 每核CPU使用率采样器
+ * 通过ntdll的NtQuerySystemInformation(SystemProcessorPerformanceInformation)
+ * 读取每个逻辑处理器的累计空闲/内核/用户时间，两次采样之差即为区间使用率
+ * 所有缓冲区在initialize()时一次性分配，采样过程不再分配内存
+ */
+class CpuSampler {
+public:
+    CpuSampler();
+    ~CpuSampler();
+
+    /**
+     * 初始化采样器
+     * 加载ntdll函数并按逻辑处理器数量分配缓冲区
+     * @return 是否初始化成功
+     */
+    bool initialize();
+
+    /**
+     * 获取逻辑处理器数量（包括所有处理器组）
+     * @return 逻辑处理器数量
+     */
+    size_t getCoreCount() const { return core_count; }
+
+    /**
+     * 采样每核使用率
+     * 第一次调用只记录基准值，输出全部为0
+     * @param utilization [out] 每核使用率（0-100），长度至少为getCoreCount()
+     * @param capacity utilization缓冲区长度
+     * @return 实际写入的核心数量，失败返回0
+     */
+    size_t sample(float* utilization, size_t capacity);
+
+    /**
+     * 是否已经有可用的基准采样
+     * @return 已有基准采样返回true
+     */
+    bool hasBaseline() const { return has_baseline; }
+
+private:
+    // ntdll函数指针声明（NTAPI即__stdcall，32位下与默认的__cdecl不同，必须与ntdll一致）
+    typedef LONG (NTAPI *NtQuerySystemInformation_t)(int info_class, void* info, ULONG length,
+                                                     ULONG* return_length);
+    typedef LONG (NTAPI *NtQuerySystemInformationEx_t)(int info_class, void* input, ULONG input_length,
+                                                       void* info, ULONG length, ULONG* return_length);
+
+    /**
+     * 读取所有处理器组的原始计数到raw_buffer
+     * @return 成功返回true
+     */
+    bool readRawCounters();
+
+    NtQuerySystemInformation_t ntQuerySystemInformation;
+    NtQuerySystemInformationEx_t ntQuerySystemInformationEx;
+
+    size_t core_count;
+    unsigned short group_count;
+    bool is_initialized;
+    bool has_baseline;
+
+    // 原始查询缓冲区（按处理器组依次存放）
+    std::vector<unsigned char> raw_buffer;
+
+    // 上一次采样的空闲时间与总时间（内核时间包含空闲时间）
+    std::vector<unsigned long long> prev_idle;
+    std::vector<unsigned long long> prev_total;
+};
+
+} // namespace evan
@@ -6,8 +6,57 @@
 
 #include <string>
 #include <vector>
+#include "utils/ring_buffer.h"
 
-// GPU信息结构体
+// GPU厂商编号（设备ID的高16位）
+enum GPUVendorCode {
+    GPU_VENDOR_UNKNOWN = 0,
+    GPU_VENDOR_NVIDIA = 1,
+    GPU_VENDOR_AMD = 2,
+    GPU_VENDOR_INTEL = 3
+};
+
+/**
+ * 生成设备ID
+ * @param vendor 厂商编号
+ * @param index 厂商驱动内的设备序号
+ * @return 设备ID，在一次运行内唯一且稳定
+ */
+inline unsigned int gpu_device_id(GPUVendorCode vendor, unsigned int index) {
+    return (static_cast<unsigned int>(vendor) << 16) | (index & 0xFFFFu);
+}
+
+/**
+ * GPU静态标识
+ * 驱动加载后不再变化，每个设备只需保存一份
+ */
+struct GPUDeviceIdentity {
+    unsigned int device_id;           ///< 设备ID（见gpu_device_id）
+    std::string name;                 ///< GPU名称
+    std::string vendor;               ///< GPU厂商
+    std::string driver_version;       ///< 驱动版本
+    unsigned long long memory_total;  ///< 总显存（字节）
+};
+
+/**
+ * GPU动态采样
+ * 定长POD，不含指针和字符串，可以直接放入环形缓冲区或按字节导出；
+ * 字节数使用64位整数，小数读数按固定倍率缩放为整数，不丢失精度
+ */
+struct GPUSample {
+    unsigned long long memory_used;   ///< 已用显存（字节）
+    unsigned long long memory_free;   ///< 可用显存（字节）
+    unsigned int device_id;           ///< 设备ID，对应GPUDeviceIdentity::device_id
+    unsigned int utilization_centi;   ///< 使用率（0.01%）
+    int temperature_centi;            ///< 温度（0.01℃）
+    unsigned int power_mw;            ///< 功耗（mW）
+    unsigned int clock_core_mhz;      ///< 核心频率（MHz）
+    unsigned int clock_memory_mhz;    ///< 显存频率（MHz）
+};
+
+static_assert(sizeof(GPUSample) == 40, "GPUSample layout must stay fixed");
+
+// GPU信息结构体（兼容接口，由GPUDeviceIdentity和GPUSample组合得到）
 typedef struct {
     std::string name;           // GPU名称
     std::string vendor;         // GPU厂商
@@ -22,6 +71,71 @@ typedef struct {
     float clock_memory;         // 显存频率（MHz）
 } GPUInfo;
 
+/**
+ * 把标识和采样组合为GPUInfo（显存换算为MB）
+ * @param identity 设备标识
+ * @param sample 动态采样
+ * @return GPU信息
+ */
+GPUInfo gpu_info_compose(const GPUDeviceIdentity& identity, const GPUSample& sample);
+
+/**
+ * 按设备保存的GPU采样历史
+ * 每个设备一个定长环形缓冲区，标识只保存一次
+ */
+class GPUSampleHistory {
+public:
+    /**
+     * 构造函数
+     * @param capacity 每个设备保留的采样数
+     */
+    explicit GPUSampleHistory(size_t capacity = 60) : capacity_(capacity) {}
+
+    /**
+     * 登记设备标识（已登记的设备会更新标识）
+     * @param identity 设备标识
+     */
+    void addDevice(const GPUDeviceIdentity& identity);
+
+    /**
+     * 追加一次采样，未登记的设备被忽略
+     * @param sample 动态采样
+     * @return 是否追加成功
+     */
+    bool push(const GPUSample& sample);
+
+    /**
+     * 获取设备的采样历史
+     * @param device_id 设备ID
+     * @return 采样历史，设备不存在时返回nullptr
+     */
+    const evan::utils::RingBuffer<GPUSample>* samples(unsigned int device_id) const;
+
+    /**
+     * 获取设备标识
+     * @param device_id 设备ID
+     * @return 设备标识，设备不存在时返回nullptr
+     */
+    const GPUDeviceIdentity* identity(unsigned int device_id) const;
+
+    /**
+     * 获取设备数量
+     */
+    size_t deviceCount() const { return devices.size(); }
+
+private:
+    struct DeviceHistory {
+        GPUDeviceIdentity identity;
+        evan::utils::RingBuffer<GPUSample> samples;
+    };
+
+    DeviceHistory* find(unsigned int device_id);
+    const DeviceHistory* find(unsigned int device_id) const;
+
+    size_t capacity_;
+    std::vector<DeviceHistory> devices;
+};
+
 // GPU监控抽象接口
 class IGPUMonitor {
 public:
@@ -36,6 +150,12 @@ public:
     // 获取所有GPU信息
     virtual bool getAllGPUInfo(std::vector<GPUInfo>& gpu_info_list) = 0;
     
+    // 获取所有GPU的静态标识（初始化后调用一次即可）
+    virtual bool getDeviceIdentities(std::vector<GPUDeviceIdentity>& identities) = 0;
+    
+    // 采样所有GPU的动态读数（追加到samples末尾）
+    virtual bool sampleAll(std::vector<GPUSample>& samples) = 0;
+    
     // 清理资源
     virtual void cleanup() = 0;
     
@@ -52,6 +172,8 @@ public:
     bool initialize() override;
     bool getGPUInfo(GPUInfo& gpu_info) override;
     bool getAllGPUInfo(std::vector<GPUInfo>& gpu_info_list) override;
+    bool getDeviceIdentities(std::vector<GPUDeviceIdentity>& identities) override;
+    bool sampleAll(std::vector<GPUSample>& samples) override;
     void cleanup() override;
     std::string getVendorName() const override { return "NVIDIA"; }
     
@@ -85,6 +207,10 @@ private:
     
     bool is_initialized;
     unsigned int device_count;
+    
+    // 读取单个设备的标识和采样
+    bool readIdentity(unsigned int index, void* device, GPUDeviceIdentity& identity);
+    bool readSample(unsigned int index, void* device, GPUSample& sample);
 };
 
 // AMD GPU监控实现
@@ -96,6 +222,8 @@ public:
     bool initialize() override;
     bool getGPUInfo(GPUInfo& gpu_info) override;
     bool getAllGPUInfo(std::vector<GPUInfo>& gpu_info_list) override;
+    bool getDeviceIdentities(std::vector<GPUDeviceIdentity>& identities) override;
+    bool sampleAll(std::vector<GPUSample>& samples) override;
     void cleanup() override;
     std::string getVendorName() const override { return "AMD"; }
     
@@ -112,6 +240,8 @@ public:
     bool initialize() override;
     bool getGPUInfo(GPUInfo& gpu_info) override;
     bool getAllGPUInfo(std::vector<GPUInfo>& gpu_info_list) override;
+    bool getDeviceIdentities(std::vector<GPUDeviceIdentity>& identities) override;
+    bool sampleAll(std::vector<GPUSample>& samples) override;
     void cleanup() override;
     std::string getVendorName() const override { return "Intel"; }
     
@@ -134,6 +264,12 @@ public:
     // 获取所有GPU信息
     bool getAllGPUInfo(std::vector<GPUInfo>& gpu_info_list);
     
+    // 获取所有GPU的静态标识
+    bool getDeviceIdentities(std::vector<GPUDeviceIdentity>& identities);
+    
+    // 采样所有GPU的动态读数（会先清空samples，容量保留复用）
+    bool sampleAll(std::vector<GPUSample>& samples);
+    
     // 清理资源
     void cleanup();
     
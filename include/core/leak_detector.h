@@ -0,0 +1,147 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "utils/sliding_regression.h"
+
+namespace evan {
+    class AlertSink;
+    class Collector;
+    struct TickSources;
+
+    /**
+     * 默认的泄漏阈值（工作集增长速度，MB每小时）
+     */
+    const double DEFAULT_LEAK_RATE_MB_PER_HOUR = 10.0;
+
+    /**
+     * 默认的最短增长时间（分钟）
+     */
+    const unsigned int DEFAULT_LEAK_DURATION_MIN = 30;
+
+    /**
+     * 每个进程的窗口中的点数（窗口覆盖最短增长时间，点之间的间隔为其1/31）
+     */
+    const size_t LEAK_WINDOW_POINTS = 32;
+
+    /**
+     * 窗口中至少有这么多点才开始判断（循环间隔大于点间隔时窗口会比最短增长时间更长）
+     */
+    const size_t LEAK_MIN_POINTS = 8;
+
+    /**
+     * 判定为持续增长需要的最小R²（排除锯齿形的正常缓存和GC）
+     */
+    const double LEAK_MIN_R2 = 0.8;
+
+    /**
+     * 已标记的进程在斜率低于阈值的这个比例或R²低于LEAK_MIN_R2的这个比例时才恢复（避免反复标记）
+     */
+    const double LEAK_RESOLVE_RATIO = 0.5;
+
+    /**
+     * 泄漏状态
+     */
+    enum LeakState {
+        LEAK_STARTED,    ///< 本次循环开始标记
+        LEAK_ONGOING,    ///< 仍在增长
+        LEAK_RESOLVED,   ///< 不再增长
+        LEAK_EXITED      ///< 标记期间进程退出（或PID被其他进程重用）
+    };
+
+    /**
+     * 一个被标记的进程
+     */
+    struct LeakFinding {
+        LeakState state;
+        unsigned long pid;
+        std::string process;
+        unsigned long long working_set;   ///< 最近一次的工作集（字节）
+        double rate;                      ///< 窗口内的最小二乘斜率（字节每秒）
+        double r2;                        ///< 拟合的R²
+        unsigned long long leaking_ms;    ///< 从开始标记到现在的时间
+        double exhaust_seconds;           ///< 按当前斜率耗尽可用物理内存的时间（秒），未知时为负数
+    };
+
+    /**
+     * 进程内存泄漏检测（--leaks）
+     * 每个进程一个utils::SlidingRegression窗口（LEAK_WINDOW_POINTS个点，内存固定），
+     * 按最短增长时间/31的间隔采样工作集（循环更频繁时跳过中间的循环），在线更新最小二乘斜率。
+     * 窗口覆盖最短增长时间后，斜率达到阈值且R²不低于LEAK_MIN_R2时标记该进程，
+     * 并按当前斜率估计耗尽可用物理内存的时间。
+     * 进程按PID跟踪，PID对应的进程名变化时视为新进程；进程退出后丢弃它的窗口
+     */
+    class LeakDetector {
+    public:
+        /**
+         * @param rate 增长速度阈值（字节每秒）
+         * @param duration_ms 最短增长时间（毫秒）
+         */
+        LeakDetector(double rate, unsigned long long duration_ms);
+
+        /**
+         * 处理本次循环的进程表
+         * @param sources 数据源（SOURCE_PROCESS_TABLE，SOURCE_MEMORY_STATUS用于估计耗尽时间）
+         * @param now_ms 单调时钟（毫秒）
+         * @param findings [out] 正在增长和状态变化的进程（追加）
+         */
+        void observe(const TickSources& sources, unsigned long long now_ms, std::vector<LeakFinding>& findings);
+
+        /**
+         * 正在跟踪的进程数
+         */
+        size_t tracked() const { return processes.size(); }
+
+        double threshold() const { return rate; }
+        unsigned long long duration() const { return duration_ms; }
+
+    private:
+        struct ProcessState {
+            utils::SlidingRegression window;   ///< x为从第一次看到该进程起的秒数，y为工作集（字节）
+            std::string name;
+            unsigned long long first_ms;       ///< 第一次看到该进程的时间
+            unsigned long long sampled_ms;     ///< 最后一次加入窗口的时间
+            unsigned long long since_ms;       ///< 开始标记的时间
+            unsigned long long seen;           ///< 最后一次出现在进程表中的循环序号
+            bool leaking;
+
+            ProcessState() : window(LEAK_WINDOW_POINTS), first_ms(0), sampled_ms(0), since_ms(0), seen(0), leaking(false) {}
+        };
+
+        void fill(const ProcessState& state, unsigned long pid, LeakState kind, unsigned long long now_ms,
+                  LeakFinding& finding) const;
+
+        double rate;
+        unsigned long long duration_ms;
+        unsigned long long interval_ms;    ///< 加入窗口的最小间隔
+        double available;                  ///< 本次循环的可用物理内存（字节），未知时为负数
+        std::unordered_map<unsigned long, ProcessState> processes;
+        unsigned long long generation;     ///< 循环序号
+    };
+
+    /**
+     * 生成泄漏状态变化的NDJSON行（不含换行），与告警事件写入同一个输出
+     * {"time":"...","rule":"leak","state":"leaking|resolved|exited","pid":...,"process":"...",
+     *  "working_set":...,"rate_per_hour":...,"r2":...,"exhaust_s":...}
+     * @param finding 进程
+     * @return JSON行
+     */
+    std::string evos_leak_finding_json(const LeakFinding& finding);
+
+    /**
+     * 创建内存泄漏检测采集器（--leaks）
+     * 每次循环显示跟踪的进程数和正在增长的进程（增长速度、R²、预计耗尽时间），
+     * 开始标记、恢复和退出时写入sink
+     * @param rate 增长速度阈值（字节每秒，--leak-rate）
+     * @param duration_ms 最短增长时间（毫秒，--leak-duration）
+     * @param sink 告警输出（可以与其他采集器共享），为空时只在控制台显示
+     * @return 采集器，由调用方（注册表）持有
+     */
+    Collector* evos_leaks_collector_create(double rate, unsigned long long duration_ms,
+                                           const std::shared_ptr<AlertSink>& sink);
+}
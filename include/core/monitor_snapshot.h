@@ -0,0 +1,41 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <vector>
+#include "utils/arena.h"
+
+namespace evan {
+
+/**
+ * 一次采样的系统快照
+ * 由采集端（本地或--serve进程）填充，由渲染端（本地或--attach进程）消费
+ */
+struct MonitorSnapshot {
+    unsigned long long timestamp_ms;  ///< 采样时间（自系统启动的毫秒数）
+    float memory_percent;             ///< 物理内存使用率（0-100）
+    float swap_percent;               ///< 交换区使用率（0-100）
+    std::vector<float> core_usage;    ///< 每核CPU使用率（0-100）
+
+    MonitorSnapshot() : timestamp_ms(0), memory_percent(0.0f), swap_percent(0.0f) {}
+};
+
+/**
+ * 一个进程的采样
+ * 名称指向本次循环的Arena，只在该Arena下一次reset()之前有效
+ */
+struct ProcessSample {
+    unsigned long pid;                ///< 进程ID
+    utils::StringView name;           ///< 可执行文件名
+    unsigned long long working_set;   ///< 工作集大小（字节）
+    unsigned long long pagefile;      ///< 页面文件使用量（字节）
+    bool accessible;                  ///< 是否成功读取了内存信息
+};
+
+/**
+ * 一次循环内的进程列表，内存全部来自本次循环的Arena
+ */
+typedef utils::ArenaVector<ProcessSample> ProcessList;
+
+} // namespace evan
@@ -0,0 +1,137 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <windows.h>
+
+namespace evan {
+    class Collector;
+
+    /**
+     * 性能计数器事件
+     * 前六个是硬件事件，后三个是软件事件；Windows上只有周期数和三个软件事件可用，其余事件显示n/a
+     */
+    enum PerfEvent {
+        PERF_CYCLES,            ///< 处理器周期
+        PERF_INSTRUCTIONS,      ///< 退休的指令数
+        PERF_CACHE_REFERENCES,  ///< 末级缓存访问
+        PERF_CACHE_MISSES,      ///< 末级缓存未命中
+        PERF_BRANCHES,          ///< 分支指令
+        PERF_BRANCH_MISSES,     ///< 分支预测失败
+        PERF_TASK_CLOCK,        ///< CPU时间（纳秒）
+        PERF_CONTEXT_SWITCHES,  ///< 上下文切换
+        PERF_PAGE_FAULTS,       ///< 缺页
+        PERF_EVENT_COUNT
+    };
+
+    /**
+     * 单个进程测量时的窗口（毫秒，--inquire --perf-counters）
+     */
+    const unsigned int PERF_INQUIRE_WINDOW_MS = 1000;
+
+    /**
+     * 采集器第一次运行时建立基准后等待的时间（毫秒）
+     */
+    const unsigned int PERF_BASELINE_MS = 250;
+
+    /**
+     * 计数目标
+     */
+    struct PerfTarget {
+        unsigned long pid;   ///< 进程ID
+    };
+
+    /**
+     * 解析计数目标列表（--perf-target）
+     * @param spec 逗号分隔的PID，如"1234,5678"
+     * @param targets [out] 目标（追加）
+     * @return 全部解析成功返回true，否则输出错误信息并返回false
+     */
+    bool evos_perf_targets_parse(const std::string& spec, std::vector<PerfTarget>& targets);
+
+    /**
+     * 一个目标的累计计数
+     */
+    struct PerfReading {
+        unsigned long long values[PERF_EVENT_COUNT];  ///< 累计值（发生多路复用时按运行时间比例换算）
+        bool available[PERF_EVENT_COUNT];             ///< 事件是否可用
+        bool valid;                                   ///< 目标是否存在
+    };
+
+    /**
+     * 性能计数器采样器
+     * Windows上没有perf_event_open，一次NtQuerySystemInformation(SystemProcessInformation)读取所有目标的
+     * 周期数（CycleTime）、CPU时间、上下文切换和缺页，指令、缓存和分支事件不可用
+     */
+    class PerfCounterSampler {
+    public:
+        PerfCounterSampler();
+        ~PerfCounterSampler();
+
+        /**
+         * 打开所有目标的计数器（会先关闭之前打开的计数器）
+         * @param targets 目标
+         * @return 至少一个目标的至少一个事件可用返回true
+         */
+        bool open(const std::vector<PerfTarget>& targets);
+
+        /**
+         * 读取所有目标的累计计数
+         * @param readings [out] 每个目标一项，顺序与open()的targets相同
+         * @return 成功返回true
+         */
+        bool sample(std::vector<PerfReading>& readings);
+
+        /**
+         * 关闭所有计数器
+         */
+        void close();
+
+        /**
+         * 是否有硬件事件可用
+         */
+        bool hardware() const { return hardware_; }
+
+        const std::vector<PerfTarget>& targets() const { return targets_; }
+
+    private:
+        PerfCounterSampler(const PerfCounterSampler&);
+        PerfCounterSampler& operator=(const PerfCounterSampler&);
+
+        // NTAPI即__stdcall，32位下与默认的__cdecl不同，必须与ntdll一致
+        typedef LONG (NTAPI *NtQuerySystemInformation_t)(int info_class, void* info, ULONG length,
+                                                         ULONG* return_length);
+
+        std::vector<PerfTarget> targets_;
+        std::vector<unsigned char> buffer;           ///< SystemProcessInformation缓冲区（跨采样复用）
+        NtQuerySystemInformation_t ntQuerySystemInformation;
+        bool hardware_;
+    };
+
+    /**
+     * 显示两次采样之间的计数（IPC、缓存和分支未命中率，不可用的事件显示n/a）
+     * @param targets 目标
+     * @param before 开始时的计数
+     * @param after 结束时的计数
+     * @param hardware 是否有硬件事件可用
+     */
+    void evos_perf_counters_report(const std::vector<PerfTarget>& targets, const std::vector<PerfReading>& before,
+                                   const std::vector<PerfReading>& after, bool hardware);
+
+    /**
+     * 测量一个进程PERF_INQUIRE_WINDOW_MS毫秒内的计数并显示（--inquire --perf-counters）
+     * @param pid 进程ID
+     */
+    void evos_perf_counters_inquire(unsigned long pid);
+
+    /**
+     * 创建性能计数器采集器（--perf-counters）
+     * 第一次运行时打开计数器并建立基准，之后每次显示与上一次之间的计数
+     * @param targets 目标，为空时只输出提示
+     * @return 采集器，由调用方（注册表）持有
+     */
+    Collector* evos_perf_counters_collector_create(const std::vector<PerfTarget>& targets);
+}
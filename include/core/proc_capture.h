@@ -0,0 +1,18 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <string>
+
+namespace evan {
+    /**
+     * 把当前数据源保存为procfs格式的归档（--capture-proc）
+     * 设置了--proc-root时原样复制其中的meminfo、cpuinfo、stat和每个进程的status、stat、cmdline、cgroup；
+     * 否则读取本机（Windows API）并生成等价的meminfo、cpuinfo和<pid>/status。
+     * 生成的归档可以用--proc-root <归档>.tar回放，也可以用tar解开后作为目录使用
+     * @param output 归档路径（ustar格式）
+     * @return 进程退出码（0成功，1无法读取数据源或无法写入归档）
+     */
+    int evos_proc_capture_run(const std::string& output);
+}
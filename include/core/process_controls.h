@@ -0,0 +1,64 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <string>
+
+namespace evan {
+    /**
+     * 调度类别
+     */
+    enum SchedClass {
+        SCHED_CLASS_NORMAL = 0,   ///< 不修改
+        SCHED_CLASS_BATCH = 1,    ///< 低于正常（BELOW_NORMAL_PRIORITY_CLASS）
+        SCHED_CLASS_IDLE = 2      ///< 空闲（IDLE_PRIORITY_CLASS，只使用空闲的CPU时间）
+    };
+
+    /**
+     * 未指定NUMA节点
+     */
+    const int NUMA_NODE_ANY = -1;
+
+    /**
+     * 监控进程自身的资源控制（--cpu-affinity、--sched-class、--io-idle、--numa-node）
+     * 对整个进程生效，包括并行采集的工作线程
+     */
+    struct ProcessControls {
+        std::string cpu_list;     ///< 允许运行的CPU列表，如"0,2-3"，为空表示不限制
+        SchedClass sched_class;   ///< 调度类别
+        bool io_idle;             ///< 是否进入后台模式（I/O和内存优先级降为最低）
+        int numa_node;            ///< 绑定的NUMA节点，NUMA_NODE_ANY表示不绑定
+
+        ProcessControls() : sched_class(SCHED_CLASS_NORMAL), io_idle(false), numa_node(NUMA_NODE_ANY) {}
+    };
+
+    /**
+     * 解析CPU列表
+     * @param list CPU列表，逗号分隔的编号或范围，如"0,2-3"
+     * @param mask [out] CPU掩码
+     * @return 格式正确且编号都小于64时返回true
+     */
+    bool evos_cpu_list_parse(const std::string& list, unsigned long long& mask);
+
+    /**
+     * 解析调度类别名称
+     * @param name idle、batch或normal
+     * @param sched [out] 调度类别
+     * @return 名称有效返回true
+     */
+    bool evos_sched_class_parse(const std::string& name, SchedClass& sched);
+
+    /**
+     * 应用资源控制
+     * 每一项单独应用，失败的项输出错误信息并跳过，不影响其余各项
+     * @param controls 资源控制
+     * @return 全部应用成功返回true
+     */
+    bool evos_process_controls_apply(const ProcessControls& controls);
+
+    /**
+     * 显示实际生效的资源控制（供--stats使用）
+     */
+    void evos_process_controls_display();
+}
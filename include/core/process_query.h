@@ -0,0 +1,26 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <string>
+#include "utils/format.h"
+
+namespace evan {
+    /**
+     * 写入JSON字符串（含引号，转义引号、反斜杠和控制字符）
+     * @param sink 输出目标
+     * @param str 字符串
+     */
+    void evos_json_string_write(utils::FormatSink& sink, utils::StringView str);
+
+    /**
+     * 批量查询进程（--inquire-batch）
+     * 每行一个查询：纯数字按PID查询，否则按进程名通配符（'*'、'?'，忽略大小写）查询；
+     * 空行和以'#'开头的行被忽略。所有查询共用一次进程快照，结果按输入顺序以NDJSON输出到标准输出，
+     * 每个匹配的进程一行，没有匹配的查询输出一行error
+     * @param source 查询文件路径，"-"表示标准输入
+     * @return 进程退出码（0成功，1无法读取输入或无法获取进程快照）
+     */
+    int evos_inquire_batch_run(const std::string& source);
+}
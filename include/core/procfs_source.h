@@ -0,0 +1,63 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <string>
+#include <windows.h>
+#include "core/monitor_snapshot.h"
+#include "utils/arena.h"
+#include "utils/string_view.h"
+
+namespace evan {
+    /**
+     * 设置procfs格式的数据根目录（--proc-root）
+     * 设置后进程表、内存状态和处理器数量从该目录读取，而不是调用Windows API；
+     * 用于在合成的fixture上运行采集器和基准。只应在启动时（创建工作线程之前）设置。
+     * 以".tar"结尾时作为--capture-proc生成的归档打开，回放采集时的数据
+     * @param root 根目录或归档，为空表示读取本机
+     */
+    void evos_proc_root_set(const std::string& root);
+
+    /**
+     * 获取procfs格式的数据根目录
+     * @return 根目录，为空表示读取本机
+     */
+    const std::string& evos_proc_root();
+
+    /**
+     * 读取根目录下的文件
+     * @param root 根目录或归档
+     * @param relative 相对路径，如"meminfo"、"123/status"
+     * @param buffer 缓冲区（根目录是归档时不使用，直接返回指向归档的视图）
+     * @param capacity 缓冲区大小，超过的部分被截断
+     * @return 文件内容，不存在或读取失败返回空视图
+     */
+    utils::StringView evos_procfs_file_read(const std::string& root, utils::StringView relative, char* buffer, size_t capacity);
+
+    /**
+     * 从<root>/meminfo读取内存状态
+     * @param root 根目录
+     * @param status [out] 内存状态（物理内存和页面文件，页面文件为物理内存加交换区）
+     * @return 成功返回true
+     */
+    bool evos_procfs_memory_load(const std::string& root, MEMORYSTATUSEX& status);
+
+    /**
+     * 从<root>/cpuinfo读取处理器数量
+     * @param root 根目录
+     * @param arena 读取cpuinfo的缓冲区所在的Arena（每次循环复用同一块内存，不分配堆内存）
+     * @param info [out] 系统信息（处理器数量和活动处理器掩码，其余字段为x64的默认值）
+     * @return 成功返回true
+     */
+    bool evos_procfs_system_info_load(const std::string& root, utils::Arena& arena, SYSTEM_INFO& info);
+
+    /**
+     * 从<root>/<pid>/status读取所有进程
+     * @param root 根目录
+     * @param arena 保存进程名的Arena
+     * @param processes [out] 进程列表（追加，工作集为VmRSS，页面文件为VmSwap；没有VmRSS的内核线程accessible为false）
+     * @return 根目录可以读取返回true
+     */
+    bool evos_procfs_processes_load(const std::string& root, utils::Arena& arena, ProcessList& processes);
+}
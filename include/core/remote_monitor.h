@@ -0,0 +1,135 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "core/monitor_snapshot.h"
+
+namespace evan {
+
+/**
+ * 快照帧格式（主机字节序，仅用于本机Unix域套接字）
+ *
+ *   FrameHeader | core_count个uint16（每核使用率，单位0.01%）
+ */
+struct FrameHeader {
+    uint32_t magic;           ///< 固定为FRAME_MAGIC
+    uint16_t version;         ///< 协议版本
+    uint16_t core_count;      ///< 随后的每核数据个数
+    uint64_t timestamp_ms;    ///< 采样时间
+    uint16_t memory_centi;    ///< 内存使用率（0.01%）
+    uint16_t swap_centi;      ///< 交换区使用率（0.01%）
+    uint32_t reserved;        ///< 保留，填0
+};
+
+const uint32_t FRAME_MAGIC = 0x534F5645;  // "EVOS"
+const uint16_t FRAME_VERSION = 1;
+
+/**
+ * 最大同时连接的客户端数量
+ */
+const size_t MAX_ATTACH_CLIENTS = 64;
+
+/**
+ * 获取默认的套接字路径（%TEMP%\evanOS.sock）
+ * @return 套接字路径
+ */
+std::string remote_default_socket_path();
+
+/**
+ * 将快照编码为帧
+ * @param snapshot 快照
+ * @param frame [out] 帧缓冲区（复用已有容量）
+ */
+void remote_frame_encode(const MonitorSnapshot& snapshot, std::vector<char>& frame);
+
+/**
+ * 采集服务器
+ * 在Unix域套接字上监听，每个采集周期把同一帧广播给所有已连接的客户端。
+ * 帧中只有系统快照（热力图和内存、交换区折线所需的数据），其他采集器的输出不经过服务器
+ * 发送缓冲区已满的慢客户端会丢弃当前帧，断开的客户端会被移除
+ */
+class MonitorServer {
+public:
+    MonitorServer();
+    ~MonitorServer();
+
+    /**
+     * 开始监听
+     * @param path 套接字路径（已存在的同名文件会被删除）
+     * @return 是否成功
+     */
+    bool start(const std::string& path);
+
+    /**
+     * 接受所有等待中的连接（非阻塞）
+     */
+    void acceptClients();
+
+    /**
+     * 向所有客户端广播快照
+     * @param snapshot 快照
+     * @return 成功发送的客户端数量
+     */
+    size_t broadcast(const MonitorSnapshot& snapshot);
+
+    /**
+     * 停止监听并断开所有客户端
+     */
+    void stop();
+
+    size_t clientCount() const { return clients.size(); }
+
+    /**
+     * 获取因客户端过慢而丢弃的帧数
+     * @return 丢弃的帧数
+     */
+    unsigned long long droppedFrames() const { return dropped_frames; }
+
+private:
+    uintptr_t listen_socket;
+    std::vector<uintptr_t> clients;
+    std::vector<char> frame;
+    std::string socket_path;
+    bool wsa_started;
+    unsigned long long dropped_frames;
+};
+
+/**
+ * 附加客户端
+ * 连接到采集服务器并逐帧接收快照
+ */
+class MonitorClient {
+public:
+    MonitorClient();
+    ~MonitorClient();
+
+    /**
+     * 连接到服务器
+     * @param path 套接字路径
+     * @return 是否成功
+     */
+    bool connect(const std::string& path);
+
+    /**
+     * 阻塞接收下一帧
+     * @param snapshot [out] 快照
+     * @return 成功返回true，连接关闭或帧格式错误返回false
+     */
+    bool receive(MonitorSnapshot& snapshot);
+
+    /**
+     * 断开连接
+     */
+    void disconnect();
+
+private:
+    uintptr_t client_socket;
+    std::vector<uint16_t> payload;
+    bool wsa_started;
+};
+
+} // namespace evan
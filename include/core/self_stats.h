@@ -0,0 +1,15 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+namespace evan {
+    /**
+     * 显示evanOS自身的运行统计（--stats）
+     * 
+     * 功能：显示实际生效的CPU亲和性、优先级类别和后台I/O模式，
+     *       并按采集器、输出和渲染器显示内存分配次数与字节数，
+     *       分配回归直接体现为数字，而不是模糊的变慢
+     */
+    void evos_self_stats_display();
+}
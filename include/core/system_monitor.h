@@ -35,6 +35,9 @@
 
 // 引入配置管理类
 #include "core/configuration.h"
+#include "core/monitor_snapshot.h"
+#include "core/change_tracker.h"
+#include "core/collector.h"
 
 // 常量定义
 namespace evan {
@@ -97,6 +100,26 @@ namespace evan {
      * 除法因子（1024）
      */
     const unsigned long DIV = 1024;
+    
+    /**
+     * CPU热力图及内存/交换区历史保留的采样次数
+     */
+    const size_t HEATMAP_HISTORY = 60;
+    
+    /**
+     * 进程列表预留的容量（避免进程较多时在Arena中反复扩容）
+     */
+    const size_t PROCESS_RESERVE = 512;
+    
+    /**
+     * 默认的并行采集线程数（0表示每个选中的功能一个线程）
+     */
+    const unsigned int DEFAULT_JOBS = 0;
+    
+    /**
+     * 并行采集线程数上限
+     */
+    const unsigned int MAX_JOBS = 16;
 }
 
 namespace evan {
@@ -137,30 +160,65 @@ namespace evan {
      */
     void evos_memory_total_display(const Configuration& config);
     
+    /**
+     * 显示总内存使用情况（使用执行计划已读取的数据源）
+     * @param sources 本次循环的数据源（需要SOURCE_MEMORY_STATUS）
+     * @param config 配置实例，用于格式化输出
+     */
+    void evos_memory_total_display(const TickSources& sources, const Configuration& config);
+    
     /**
      * 显示系统基本信息
      * @param config 配置实例，用于格式化输出
      */
     void evos_system_info_display(const Configuration& config);
     
+    /**
+     * 显示系统基本信息（使用执行计划已读取的数据源）
+     * @param sources 本次循环的数据源（需要SOURCE_MEMORY_STATUS、SOURCE_SYSTEM_INFO）
+     * @param config 配置实例，用于格式化输出
+     */
+    void evos_system_info_display(const TickSources& sources, const Configuration& config);
+    
     /**
      * 显示系统性能信息
      * @param config 配置实例，用于格式化输出
      */
     void evos_system_performance_display(const Configuration& config);
     
+    /**
+     * 显示系统性能信息（使用执行计划已读取的数据源）
+     * @param sources 本次循环的数据源（需要SOURCE_MEMORY_STATUS、SOURCE_SYSTEM_INFO）
+     * @param config 配置实例，用于格式化输出
+     */
+    void evos_system_performance_display(const TickSources& sources, const Configuration& config);
+    
     /**
      * 显示每个进程的详细信息
      * @param config 配置实例，用于格式化输出
      */
     void evos_process_enum_display(const Configuration& config);
     
+    /**
+     * 显示每个进程的详细信息（使用执行计划已读取的数据源）
+     * @param sources 本次循环的数据源（需要SOURCE_PROCESS_TABLE）
+     * @param config 配置实例，用于格式化输出
+     */
+    void evos_process_enum_display(const TickSources& sources, const Configuration& config);
+    
     /**
      * 显示硬件信息
      * @param config 配置实例，用于格式化输出
      */
     void evos_hardware_info_display(const Configuration& config);
     
+    /**
+     * 显示硬件信息（使用执行计划已读取的数据源）
+     * @param sources 本次循环的数据源（需要SOURCE_SYSTEM_INFO）
+     * @param config 配置实例，用于格式化输出
+     */
+    void evos_hardware_info_display(const TickSources& sources, const Configuration& config);
+    
     /**
      * 显示指定进程的详细信息
      * @param pid 进程ID
@@ -168,6 +226,45 @@ namespace evan {
      */
     void evos_process_info_display(DWORD pid, const Configuration& config);
     
+    /**
+     * 显示每核CPU热力图及内存/交换区历史
+     * 每次调用追加一次采样，循环模式下逐步积累历史
+     */
+    void evos_cpu_heatmap_display();
+    
+    /**
+     * 采集一次系统快照（每核CPU、内存、交换区使用率）
+     * @param snapshot [out] 快照
+     * @return 成功返回true
+     */
+    bool evos_snapshot_collect(MonitorSnapshot& snapshot);
+    
+    /**
+     * 渲染系统快照，追加到热力图及历史折线后输出
+     * @param snapshot 快照
+     */
+    void evos_snapshot_render(const MonitorSnapshot& snapshot);
+    
+    /**
+     * 获取本次循环的Arena（进程快照、格式化后的单元格等只在一次循环内有效的数据）
+     * 每个线程有各自的Arena
+     * @return 当前线程的Arena引用
+     */
+    utils::Arena& evos_tick_arena();
+    
+    /**
+     * 结束一次循环，在O(1)内回收当前线程本次循环的全部快照内存
+     */
+    void evos_tick_reset();
+    
+    /**
+     * 采集所有进程的内存信息
+     * @param arena 保存进程名的Arena
+     * @param processes [out] 进程列表（追加）
+     * @return 成功返回true
+     */
+    bool evos_process_snapshot_collect(utils::Arena& arena, ProcessList& processes);
+    
     /**
      * 显示GPU基本信息
      */
@@ -4,8 +4,9 @@
 #pragma once
 
 #include <string>
-#include <map>
 #include <vector>
+#include "utils/arena.h"
+#include "utils/string_view.h"
 
 namespace evan {
 
@@ -19,6 +20,57 @@ enum class Language {
     JAPANESE
 };
 
+// 支持的语言数量
+const size_t LANGUAGE_COUNT = 6;
+
+/**
+ * 翻译键列表：X(标识符, 键名, 英文文本)
+ * 键名用于翻译文件，英文文本是所有语言的回退
+ */
+#define EVAN_TRANSLATION_KEYS(X) \
+    X(SYSTEM_PERFORMANCE, "system_performance", "System Performance") \
+    X(SYSTEM_MEMORY, "system_memory", "System Memory") \
+    X(TOTAL_MEMORY, "total_memory", "Total Memory") \
+    X(EACH_PROCESS, "each_process", "Each Process") \
+    X(HARDWARE_INFO, "hardware_info", "Hardware Info") \
+    X(GPU_INFO, "gpu_info", "GPU Info") \
+    X(ADVANCED_GPU_INFO, "advanced_gpu_info", "Advanced GPU Info") \
+    X(HELP, "help", "Help") \
+    X(COPYRIGHT, "copyright", "Copyright") \
+    X(LICENSE, "license", "License") \
+    X(CPU_ARCHITECTURE, "cpu_architecture", "CPU Architecture") \
+    X(NUMBER_OF_PROCESSORS, "number_of_processors", "Number of Processors") \
+    X(PROCESSOR_LEVEL, "processor_level", "Processor Level") \
+    X(PROCESSOR_REVISION, "processor_revision", "Processor Revision") \
+    X(CPU_BRAND, "cpu_brand", "CPU Brand") \
+    X(PAGE_SIZE, "page_size", "Page Size") \
+    X(ACTIVE_PROCESSOR_MASK, "active_processor_mask", "Active Processor Mask") \
+    X(TOTAL_PHYSICAL_MEMORY, "total_physical_memory", "Total Physical Memory") \
+    X(USED_PHYSICAL_MEMORY, "used_physical_memory", "Used Physical Memory") \
+    X(FREE_PHYSICAL_MEMORY, "free_physical_memory", "Free Physical Memory") \
+    X(MEMORY_USAGE, "memory_usage", "Memory Usage") \
+    X(GPU_NAME, "gpu_name", "GPU Name") \
+    X(GPU_VENDOR, "gpu_vendor", "GPU Vendor") \
+    X(DRIVER_VERSION, "driver_version", "Driver Version") \
+    X(MEMORY_TOTAL, "memory_total", "Total Memory") \
+    X(MEMORY_USED, "memory_used", "Used Memory") \
+    X(MEMORY_FREE, "memory_free", "Free Memory") \
+    X(UTILIZATION, "utilization", "Utilization") \
+    X(TEMPERATURE, "temperature", "Temperature") \
+    X(POWER_USAGE, "power_usage", "Power Usage") \
+    X(CLOCK_CORE, "clock_core", "Core Clock") \
+    X(CLOCK_MEMORY, "clock_memory", "Memory Clock")
+
+/**
+ * 翻译键（编译期整数，作为翻译表的下标）
+ */
+enum TrKey {
+#define EVAN_TRANSLATION_KEY_ENUM(id, name, english) TR_##id,
+    EVAN_TRANSLATION_KEYS(EVAN_TRANSLATION_KEY_ENUM)
+#undef EVAN_TRANSLATION_KEY_ENUM
+    TR_KEY_COUNT
+};
+
 // 国际化管理类
 class Internationalization {
 public:
@@ -47,19 +99,45 @@ public:
     std::string getCurrentLanguageName() const;
     
     /**
-     * 翻译字符串
+     * 翻译字符串（数组下标，不分配内存）
      * @param key 翻译键
-     * @return 翻译后的字符串
+     * @return 当前语言的文本（缺失时为英文），在程序运行期间有效
+     */
+    utils::StringView translate(TrKey key) const {
+        return current[key];
+    }
+    
+    /**
+     * 按键名翻译字符串
+     * @param key 翻译键名
+     * @return 翻译后的字符串，未知的键名原样返回
      */
-    std::string translate(const std::string& key);
+    std::string translate(const std::string& key) const;
+    
+    /**
+     * 按键名查找翻译键
+     * @param name 翻译键名
+     * @param key [out] 翻译键
+     * @return 找到返回true
+     */
+    static bool findKey(utils::StringView name, TrKey& key);
     
     /**
      * 注册翻译
      * @param lang 语言类型
      * @param key 翻译键
+     * @param value 翻译值（复制保存）
+     */
+    void registerTranslation(Language lang, TrKey key, utils::StringView value);
+    
+    /**
+     * 按键名注册翻译
+     * @param lang 语言类型
+     * @param key 翻译键名
      * @param value 翻译值
+     * @return 键名已知返回true，未知的键名被忽略
      */
-    void registerTranslation(Language lang, const std::string& key, const std::string& value);
+    bool registerTranslation(Language lang, const std::string& key, const std::string& value);
     
     /**
      * 加载翻译文件
@@ -69,6 +147,13 @@ public:
      */
     bool loadTranslationFile(Language lang, const std::string& filePath);
     
+    /**
+     * 指定语言的翻译文件（语言第一次被选中时才加载；已经加载的语言立即加载）
+     * @param lang 语言类型
+     * @param filePath 翻译文件路径
+     */
+    void setTranslationFile(Language lang, const std::string& filePath);
+    
     /**
      * 获取支持的语言列表
      * @return 支持的语言名称列表
@@ -90,22 +175,38 @@ private:
     Internationalization(const Internationalization&) = delete;
     Internationalization& operator=(const Internationalization&) = delete;
     
-    // 初始化默认翻译
-    void initializeDefaultTranslations();
+    // 加载语言的内置翻译和指定的翻译文件（只在第一次调用时执行）
+    void ensureLoaded(Language lang);
+    
+    // 映射翻译文件并解析到翻译表（不重新计算回退）
+    bool parseTranslationFile(Language lang, const std::string& filePath);
+    
+    // 重新计算语言的最终翻译表（缺失的键回退到英文，英文变化时重新计算所有语言）
+    void resolve(Language lang);
     
     // 当前语言
     Language currentLanguage;
     
-    // 翻译映射
-    std::map<Language, std::map<std::string, std::string>> translations;
+    // 已注册的翻译（空视图表示缺失），文本保存在storage中
+    utils::StringView registered[LANGUAGE_COUNT][TR_KEY_COUNT];
     
-    // 语言名称映射
-    std::map<Language, std::string> languageNames;
+    // 加载时已完成英文回退的翻译表
+    utils::StringView resolved[LANGUAGE_COUNT][TR_KEY_COUNT];
     
-
+    // 当前语言的翻译表（指向resolved中的一行）
+    const utils::StringView* current;
+    
+    // 注册的翻译文本（只增不减，视图在程序运行期间有效）
+    utils::Arena storage;
+    
+    // 语言是否已经加载
+    bool loaded[LANGUAGE_COUNT];
+    
+    // 等待语言第一次被选中时加载的翻译文件
+    std::string pendingFiles[LANGUAGE_COUNT];
 };
 
-// 翻译宏（方便使用）
-#define _T(key) evan::Internationalization::getInstance().translate(key)
+// 翻译宏（方便使用），参数是翻译键标识符，如EVAN_TR(CPU_BRAND)
+#define EVAN_TR(id) evan::Internationalization::getInstance().translate(evan::TR_##id)
 
 } // namespace evan
@@ -0,0 +1,128 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "utils/ring_buffer.h"
+
+namespace evan {
+
+/**
+ * 每核CPU热力图控件
+ * 每行对应一个逻辑处理器，每列对应一次采样，颜色表示使用率
+ * 历史数据保存在固定容量的环形缓冲区中（每格1字节）
+ * 渲染时直接向输出缓冲区追加预先生成的转义序列，不为单元格分配字符串
+ */
+class HeatmapWidget {
+public:
+    /**
+     * 构造函数
+     * @param rows 行数（逻辑处理器数量）
+     * @param columns 列数（保留的采样次数）
+     */
+    HeatmapWidget(size_t rows, size_t columns);
+
+    /**
+     * 追加一列采样值
+     * @param values 每行的使用率（0-100）
+     * @param count values长度，超出行数的部分被忽略
+     */
+    void push(const float* values, size_t count);
+
+    /**
+     * 将热力图追加到输出缓冲区
+     * @param out 输出缓冲区
+     */
+    void render(std::string& out) const;
+
+    /**
+     * 获取渲染结果的最大字节数，用于预留输出缓冲区
+     * @return 最大字节数
+     */
+    size_t maxRenderSize() const;
+
+    size_t rowCount() const { return history.size(); }
+    size_t columnCount() const { return columns; }
+
+private:
+    size_t columns;
+    std::vector<utils::RingBuffer<unsigned char>> history;
+};
+
+/**
+ * 历史迷你折线控件
+ * 使用Unicode方块字符（▁-█）按时间顺序绘制百分比序列
+ */
+class SparklineWidget {
+public:
+    /**
+     * 构造函数
+     * @param label 标签（需为静态字符串）
+     * @param capacity 保留的采样次数
+     */
+    SparklineWidget(const char* label, size_t capacity);
+
+    /**
+     * 追加采样值
+     * @param percent 百分比（0-100）
+     */
+    void push(float percent);
+
+    /**
+     * 将折线追加到输出缓冲区
+     * @param out 输出缓冲区
+     */
+    void render(std::string& out) const;
+
+    /**
+     * 获取渲染结果的最大字节数，用于预留输出缓冲区
+     * @return 最大字节数
+     */
+    size_t maxRenderSize() const;
+
+private:
+    const char* label;
+    utils::RingBuffer<unsigned char> history;
+};
+
+/**
+ * CPU/内存/交换区历史面板
+ * 组合一个每核热力图和两条迷你折线，并复用同一个输出缓冲区
+ */
+class HistoryPanel {
+public:
+    /**
+     * 构造函数
+     * @param cores 逻辑处理器数量
+     * @param columns 保留的采样次数
+     */
+    HistoryPanel(size_t cores, size_t columns);
+
+    /**
+     * 追加一次采样
+     * @param core_usage 每核使用率（0-100）
+     * @param core_count core_usage长度
+     * @param memory_percent 内存使用率（0-100）
+     * @param swap_percent 交换区使用率（0-100）
+     */
+    void update(const float* core_usage, size_t core_count, float memory_percent, float swap_percent);
+
+    /**
+     * 渲染整个面板
+     * @return 渲染结果（引用面板内部缓冲区，下次渲染前有效）
+     */
+    const std::string& render();
+
+    size_t coreCount() const { return heatmap.rowCount(); }
+
+private:
+    HeatmapWidget heatmap;
+    SparklineWidget memory;
+    SparklineWidget swap;
+    std::string frame;
+};
+
+} // namespace evan
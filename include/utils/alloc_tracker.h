@@ -0,0 +1,112 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * 内存分配统计开关（由CMake选项EVANOS_ALLOC_TRACKING控制，默认关闭）
+ * 开启后替换全局operator new/delete并拦截malloc系列函数，
+ * 按当前线程的作用域标签（采集器、输出、渲染器）统计分配次数和字节数
+ */
+#ifndef EVANOS_ALLOC_TRACKING
+#define EVANOS_ALLOC_TRACKING 0
+#endif
+
+namespace evan {
+namespace utils {
+
+/**
+ * 最多统计的作用域标签数量（标签0为"untagged"）
+ */
+const size_t MAX_ALLOC_TAGS = 32;
+
+/**
+ * 一个作用域标签的分配统计
+ */
+struct AllocStats {
+    const char* tag;                  ///< 标签名
+    unsigned long long allocs;        ///< 分配次数
+    unsigned long long bytes;         ///< 分配字节数
+    unsigned long long frees;         ///< 释放次数
+    unsigned long long freed_bytes;   ///< 释放字节数（按分配时的标签计入）
+};
+
+/**
+ * 内存分配统计
+ */
+class AllocTracker {
+public:
+    /**
+     * 是否编译了分配统计
+     * @return 开启EVANOS_ALLOC_TRACKING时返回true
+     */
+    static bool enabled() { return EVANOS_ALLOC_TRACKING != 0; }
+
+    /**
+     * 是否同时拦截了malloc系列函数
+     * MSVC的Debug运行库通过分配钩子拦截，GCC/MinGW通过链接器--wrap拦截，
+     * 其余情况只统计operator new/delete
+     * @return 拦截了malloc返回true
+     */
+    static bool mallocHooked();
+
+    /**
+     * 注册作用域标签（同名标签共享同一个统计项）
+     * @param tag 标签名（须在整个程序运行期间有效，通常为字符串字面量）
+     * @return 标签编号，标签表已满时返回0
+     */
+    static unsigned int registerTag(const char* tag);
+
+    /**
+     * 获取当前线程的作用域标签
+     * @return 标签编号
+     */
+    static unsigned int currentTag();
+
+    /**
+     * 设置当前线程的作用域标签
+     * @param tag 标签编号
+     * @return 之前的标签编号
+     */
+    static unsigned int exchangeTag(unsigned int tag);
+
+    /**
+     * 获取所有标签的统计
+     * @param out 输出数组
+     * @param capacity 数组长度
+     * @return 标签数量
+     */
+    static size_t snapshot(AllocStats* out, size_t capacity);
+};
+
+/**
+ * 分配统计作用域
+ * 在作用域内当前线程的所有分配计入指定标签，离开作用域时恢复之前的标签，可以嵌套
+ * 未开启EVANOS_ALLOC_TRACKING时为空操作
+ *
+ * 示例：
+ *   AllocScope scope("each");
+ *   evos_process_enum_display(config);
+ */
+class AllocScope {
+public:
+#if EVANOS_ALLOC_TRACKING
+    explicit AllocScope(const char* tag) : previous(AllocTracker::exchangeTag(AllocTracker::registerTag(tag))) {}
+    ~AllocScope() { AllocTracker::exchangeTag(previous); }
+#else
+    explicit AllocScope(const char*) {}
+#endif
+
+private:
+    AllocScope(const AllocScope&);
+    AllocScope& operator=(const AllocScope&);
+
+#if EVANOS_ALLOC_TRACKING
+    unsigned int previous;
+#endif
+};
+
+} // namespace utils
+} // namespace evan
@@ -0,0 +1,167 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "utils/string_view.h"
+
+namespace evan {
+namespace utils {
+
+/**
+ * 默认内存块大小
+ */
+const size_t ARENA_DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+/**
+ * 线性（bump）分配器
+ * 分配只移动块内偏移，单个对象不能释放；reset()在O(1)内回收全部内存，
+ * 已申请的内存块保留下来供下一轮复用，因此预热之后的循环不再调用malloc。
+ * 用于只在一次循环内有效的数据（进程快照、格式化后的单元格等），
+ * 放在其中的对象不会被析构，只能保存可平凡析构的数据或使用ArenaAllocator的容器。
+ * 不是线程安全的，每个线程使用各自的Arena。
+ */
+class Arena {
+public:
+    /**
+     * 构造函数
+     * @param chunkSize 每个内存块的大小（超过块大小的分配单独申请一块）
+     */
+    explicit Arena(size_t chunkSize = ARENA_DEFAULT_CHUNK_SIZE);
+    ~Arena();
+
+    /**
+     * 分配内存
+     * @param size 字节数
+     * @param alignment 对齐（2的幂，不超过alignof(std::max_align_t)）
+     * @return 内存地址，不会返回nullptr（内存不足时抛出std::bad_alloc）
+     */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        const size_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+        if (current < chunks.size() && aligned + size <= chunks[current].size) {
+            offset = aligned + size;
+            return chunks[current].data + aligned;
+        }
+        return allocateSlow(size, alignment);
+    }
+
+    /**
+     * 分配对象数组（不调用构造函数）
+     * @param count 元素个数
+     * @return 数组首地址
+     */
+    template <typename T>
+    T* allocateArray(size_t count) {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /**
+     * 复制字符串到Arena中（结果以'\0'结尾）
+     * @param str 源字符串
+     * @return 指向Arena内副本的视图
+     */
+    StringView copy(StringView str);
+
+    /**
+     * 回收全部内存（O(1)，内存块保留复用）
+     * 之前分配的所有指针随之失效
+     */
+    void reset() {
+        current = 0;
+        offset = 0;
+        ++generation_;
+    }
+
+    /**
+     * 获取当前已分配的字节数（含对齐填充）
+     */
+    size_t bytesUsed() const;
+
+    /**
+     * 获取已申请的内存总量
+     */
+    size_t bytesReserved() const { return reserved; }
+
+    /**
+     * 获取内存块数量
+     */
+    size_t chunkCount() const { return chunks.size(); }
+
+    /**
+     * 获取reset()的次数，可用于检查持有的指针是否已经过期
+     */
+    unsigned long generation() const { return generation_; }
+
+private:
+    Arena(const Arena&);
+    Arena& operator=(const Arena&);
+
+    /**
+     * 当前块空间不足时切换到下一个块（已有的块优先复用）
+     */
+    void* allocateSlow(size_t size, size_t alignment);
+
+    struct Chunk {
+        char* data;
+        size_t size;
+    };
+
+    std::vector<Chunk> chunks;
+    size_t chunk_size;
+    size_t current;    // 当前块下标
+    size_t offset;     // 当前块内的偏移
+    size_t reserved;
+    unsigned long generation_;
+};
+
+/**
+ * 从Arena分配内存的标准库分配器
+ * deallocate为空操作，容器的内存随Arena的reset()一起回收
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+
+    explicit ArenaAllocator(Arena& owner) : arena(&owner) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t count) {
+        return arena->allocateArray<T>(count);
+    }
+
+    void deallocate(T*, size_t) {}
+
+    template <typename U>
+    struct rebind {
+        typedef ArenaAllocator<U> other;
+    };
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+
+private:
+    template <typename U>
+    friend class ArenaAllocator;
+
+    Arena* arena;
+};
+
+/**
+ * 使用Arena的容器
+ */
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T> >;
+
+typedef std::basic_string<char, std::char_traits<char>, ArenaAllocator<char> > ArenaString;
+
+} // namespace utils
+} // namespace evan
@@ -165,6 +165,11 @@ namespace cmdline {
         return std::stoul(str);
     }
     
+    template <>
+    inline double parser::convert<double>(const std::string& str) {
+        return std::stod(str);
+    }
+    
     template <>
     inline std::string parser::convert<std::string>(const std::string& str) {
         return str;
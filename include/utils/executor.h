@@ -0,0 +1,79 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace evan {
+namespace utils {
+
+/**
+ * 固定大小的线程池
+ * 每次run()提交一批互相独立的任务，工作线程按下标领取执行，全部完成后run()才返回，
+ * 相当于每次循环末尾的屏障。一次循环的耗时等于最慢的任务，而不是所有任务之和。
+ * 任务之间的执行顺序不确定，需要确定顺序的结果应由任务写入按下标分配的槽位。
+ *
+ * 示例：
+ *   Executor executor(4);
+ *   std::vector<Executor::Task> tasks;
+ *   tasks.push_back([&]() { collectGpu(); });
+ *   tasks.push_back([&]() { collectNetwork(); });
+ *   executor.run(tasks);
+ */
+class Executor {
+public:
+    typedef std::function<void()> Task;
+
+    /**
+     * 构造函数，立即创建工作线程
+     * @param threads 工作线程数量（0表示使用CPU逻辑核心数）
+     */
+    explicit Executor(size_t threads = 0);
+
+    /**
+     * 析构函数，等待工作线程退出
+     */
+    ~Executor();
+
+    /**
+     * 并行执行一批任务，全部完成后返回
+     * 任务抛出的第一个异常在全部任务结束后于调用线程中重新抛出
+     * @param tasks 任务列表（run()返回前必须保持有效）
+     */
+    void run(const std::vector<Task>& tasks);
+
+    /**
+     * 获取工作线程数量
+     */
+    size_t threadCount() const { return workers.size(); }
+
+private:
+    Executor(const Executor&);
+    Executor& operator=(const Executor&);
+
+    /**
+     * 工作线程主循环
+     */
+    void workerLoop();
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;       // 通知工作线程有新任务或需要退出
+    std::condition_variable finished;   // 通知run()本批任务已全部完成
+
+    const std::vector<Task>* batch;     // 当前批次
+    size_t next;                        // 下一个待领取的任务下标
+    size_t remaining;                   // 尚未完成的任务数
+    std::exception_ptr failure;         // 本批次的第一个异常
+    bool stopping;
+};
+
+} // namespace utils
+} // namespace evan
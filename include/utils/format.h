@@ -0,0 +1,502 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include "utils/string_view.h"
+
+/**
+ * 类型安全的格式化
+ *
+ * 格式字符串使用 {} 占位符，在编译期解析并与参数类型逐个检查，
+ * 参数个数或类型不匹配时编译失败，而不是像printf那样在运行时输出乱码。
+ * 格式化结果直接写入输出目标（栈缓冲区、std::string或FILE*），不做额外分配。
+ *
+ * 占位符语法：{[:[填充字符]对齐][0][宽度][.精度][类型]}
+ *   对齐   <  左对齐（字符串默认）   >  右对齐（数值默认）   ^  居中
+ *   宽度   数字，或 * 表示从前一个参数读取宽度（对应printf的 %*s）
+ *   精度   浮点数的小数位数，或字符串的最大长度；.* 表示从参数读取
+ *   类型   d 十进制  x/X 十六进制  f 定点小数  s 字符串  c 字符  p 指针
+ *   {{ 和 }} 分别输出 { 和 }
+ *
+ * 示例：
+ *   EVAN_PRINT("\tMemory Usage: {:.2f}%.\n", usage);
+ *   EVAN_PRINT("{:<*} {:>*}\n", PID_SIZE, pid, NUM_WIDTH, pages);
+ *   StackBuffer<64> buffer;
+ *   EVAN_FORMAT(buffer, "{} MB", size);
+ */
+
+namespace evan {
+namespace utils {
+
+/**
+ * 格式化输出目标
+ */
+class FormatSink {
+public:
+    virtual ~FormatSink() {}
+
+    /**
+     * 写入数据
+     * @param data 数据
+     * @param length 长度
+     */
+    virtual void write(const char* data, size_t length) = 0;
+};
+
+/**
+ * 写入调用方提供的固定缓冲区，超出部分截断，结果始终以'\0'结尾
+ */
+class FixedBufferSink : public FormatSink {
+public:
+    FixedBufferSink(char* buffer, size_t capacity) : buf(buffer), cap(capacity), len(0), wanted(0) {
+        if (cap > 0) {
+            buf[0] = '\0';
+        }
+    }
+
+    void write(const char* data, size_t length) override;
+
+    const char* c_str() const { return buf; }
+    const char* data() const { return buf; }
+    size_t size() const { return len; }
+    StringView view() const { return StringView(buf, len); }
+
+    /**
+     * 是否发生了截断
+     */
+    bool truncated() const { return wanted > len; }
+
+    /**
+     * 清空内容，复用缓冲区
+     */
+    void clear() {
+        len = 0;
+        wanted = 0;
+        if (cap > 0) {
+            buf[0] = '\0';
+        }
+    }
+
+private:
+    char* buf;
+    size_t cap;
+    size_t len;
+    size_t wanted; // 不截断时应写入的长度
+};
+
+/**
+ * 自带栈上存储的固定缓冲区
+ */
+template <size_t N>
+class StackBuffer : public FixedBufferSink {
+public:
+    StackBuffer() : FixedBufferSink(storage, N) {}
+
+private:
+    StackBuffer(const StackBuffer&);
+    StackBuffer& operator=(const StackBuffer&);
+
+    char storage[N];
+};
+
+/**
+ * 追加到std::string
+ */
+class StringSink : public FormatSink {
+public:
+    explicit StringSink(std::string& target) : out(target) {}
+
+    void write(const char* data, size_t length) override {
+        out.append(data, length);
+    }
+
+private:
+    std::string& out;
+};
+
+/**
+ * 写入FILE*，内部缓冲一次格式化的输出后统一fwrite
+ */
+class FileSink : public FormatSink {
+public:
+    explicit FileSink(FILE* file) : fp(file), len(0) {}
+    ~FileSink() { flush(); }
+
+    void write(const char* data, size_t length) override;
+
+    /**
+     * 把缓冲的内容写入文件
+     */
+    void flush();
+
+private:
+    FileSink(const FileSink&);
+    FileSink& operator=(const FileSink&);
+
+    FILE* fp;
+    size_t len;
+    char buffer[512];
+};
+
+/**
+ * 捕获当前线程写往标准输出的格式化输出
+ * 生效期间本线程的EVAN_PRINT和writeStdout()改为写入指定目标，离开作用域时恢复，可以嵌套。
+ * 并行执行的采集器先把输出写入各自的缓冲区，再由调用方按固定顺序输出。
+ */
+class StdoutCapture {
+public:
+    explicit StdoutCapture(FormatSink& sink);
+    ~StdoutCapture();
+
+private:
+    StdoutCapture(const StdoutCapture&);
+    StdoutCapture& operator=(const StdoutCapture&);
+
+    FormatSink* previous;
+};
+
+/**
+ * 写入标准输出（当前线程处于StdoutCapture中时写入捕获目标）
+ * @param data 数据
+ * @param length 长度
+ */
+void writeStdout(const char* data, size_t length);
+
+namespace detail {
+    /**
+     * 获取当前线程的标准输出捕获目标
+     * @return 捕获目标，未捕获时返回nullptr
+     */
+    FormatSink* stdoutCapture();
+
+    /**
+     * 运行时参数（类型擦除后交给非模板的格式化实现，避免每种参数组合都生成一份代码）
+     */
+    struct FormatArg {
+        enum Type { NONE, INT, UINT, DOUBLE, STRING, CHAR, BOOL, POINTER };
+
+        Type type;
+        union {
+            long long i;
+            unsigned long long u;
+            double d;
+            const void* p;
+            char c;
+            bool b;
+        } value;
+        const char* str;
+        size_t str_len;
+
+        FormatArg() : type(NONE), str(nullptr), str_len(0) { value.u = 0; }
+    };
+
+    inline FormatArg makeIntArg(long long v) {
+        FormatArg arg;
+        arg.type = FormatArg::INT;
+        arg.value.i = v;
+        return arg;
+    }
+
+    inline FormatArg makeUintArg(unsigned long long v) {
+        FormatArg arg;
+        arg.type = FormatArg::UINT;
+        arg.value.u = v;
+        return arg;
+    }
+
+    inline FormatArg makeStringArg(const char* data, size_t length) {
+        FormatArg arg;
+        arg.type = FormatArg::STRING;
+        arg.str = data;
+        arg.str_len = length;
+        return arg;
+    }
+
+    /**
+     * 参数类型特征
+     * code为编译期检查使用的类型码：i有符号整数 u无符号整数 f浮点数 s字符串 c字符 b布尔 p指针 ?不支持
+     */
+    template <typename T, typename Enable = void>
+    struct ArgTraits {
+        static const char code = '?';
+    };
+
+    template <>
+    struct ArgTraits<bool> {
+        static const char code = 'b';
+        static FormatArg make(bool v) {
+            FormatArg arg;
+            arg.type = FormatArg::BOOL;
+            arg.value.b = v;
+            return arg;
+        }
+    };
+
+    template <>
+    struct ArgTraits<char> {
+        static const char code = 'c';
+        static FormatArg make(char v) {
+            FormatArg arg;
+            arg.type = FormatArg::CHAR;
+            arg.value.c = v;
+            return arg;
+        }
+    };
+
+    template <typename T>
+    struct ArgTraits<T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type> {
+        static const char code = 'i';
+        static FormatArg make(T v) { return makeIntArg(v); }
+    };
+
+    template <typename T>
+    struct ArgTraits<T, typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type> {
+        static const char code = 'u';
+        static FormatArg make(T v) { return makeUintArg(v); }
+    };
+
+    template <typename T>
+    struct ArgTraits<T, typename std::enable_if<std::is_enum<T>::value>::type> {
+        static const char code = 'i';
+        static FormatArg make(T v) { return makeIntArg(static_cast<long long>(v)); }
+    };
+
+    template <typename T>
+    struct ArgTraits<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+        static const char code = 'f';
+        static FormatArg make(T v) {
+            FormatArg arg;
+            arg.type = FormatArg::DOUBLE;
+            arg.value.d = static_cast<double>(v);
+            return arg;
+        }
+    };
+
+    template <typename T>
+    struct ArgTraits<T*> {
+        static const char code = 'p';
+        static FormatArg make(const T* v) {
+            FormatArg arg;
+            arg.type = FormatArg::POINTER;
+            arg.value.p = v;
+            return arg;
+        }
+    };
+
+    template <>
+    struct ArgTraits<const char*> {
+        static const char code = 's';
+        static FormatArg make(const char* v) {
+            return v ? makeStringArg(v, std::char_traits<char>::length(v)) : makeStringArg("(null)", 6);
+        }
+    };
+
+    template <>
+    struct ArgTraits<char*> : ArgTraits<const char*> {};
+
+    template <>
+    struct ArgTraits<std::string> {
+        static const char code = 's';
+        static FormatArg make(const std::string& v) { return makeStringArg(v.data(), v.size()); }
+    };
+
+    template <>
+    struct ArgTraits<StringView> {
+        static const char code = 's';
+        static FormatArg make(StringView v) { return makeStringArg(v.data(), v.size()); }
+    };
+
+    /**
+     * 参数类型码列表
+     */
+    template <char... Codes>
+    struct TypeCodes;
+
+    template <>
+    struct TypeCodes<> {
+        static constexpr char at(size_t) { return '\0'; }
+    };
+
+    template <char First, char... Rest>
+    struct TypeCodes<First, Rest...> {
+        static constexpr char at(size_t index) {
+            return index == 0 ? First : TypeCodes<Rest...>::at(index - 1);
+        }
+    };
+
+    /**
+     * 由参数推导类型码列表（只在decltype中使用，没有定义）
+     */
+    template <typename... Args>
+    TypeCodes<ArgTraits<typename std::decay<Args>::type>::code...> typeCodes(const Args&...);
+
+    constexpr bool isDigit(char ch) {
+        return ch >= '0' && ch <= '9';
+    }
+
+    constexpr bool isAlign(char ch) {
+        return ch == '<' || ch == '>' || ch == '^';
+    }
+
+    constexpr bool isInteger(char code) {
+        return code == 'i' || code == 'u';
+    }
+
+    constexpr const char* skipDigits(const char* s) {
+        return isDigit(*s) ? skipDigits(s + 1) : s;
+    }
+
+    /**
+     * 判断类型说明符与参数类型是否兼容
+     * @param code 参数类型码（'\0'表示参数不足）
+     * @param type 类型说明符（'\0'表示未指定）
+     */
+    constexpr bool compatible(char code, char type) {
+        return code != '\0' && code != '?' &&
+               (type == '\0' ||
+                (type == 'd' && isInteger(code)) ||
+                ((type == 'x' || type == 'X') && (isInteger(code) || code == 'p')) ||
+                (type == 'f' && code == 'f') ||
+                (type == 's' && (code == 's' || code == 'b')) ||
+                (type == 'c' && (code == 'c' || isInteger(code))) ||
+                (type == 'p' && code == 'p'));
+    }
+
+    /**
+     * 编译期格式字符串检查
+     * C++11的constexpr函数只能包含一条return语句，解析过程按状态拆成互相递归的函数，
+     * 每个函数接收当前位置和下一个参数的下标
+     */
+    template <typename Codes>
+    struct FormatChecker {
+        // 普通文本
+        static constexpr bool text(const char* s, size_t arg) {
+            return *s == '\0' ? Codes::at(arg) == '\0' :
+                   *s == '{' ? (s[1] == '{' ? text(s + 2, arg) : open(s + 1, arg)) :
+                   *s == '}' ? (s[1] == '}' && text(s + 2, arg)) :
+                   text(s + 1, arg);
+        }
+
+        // '{'之后
+        static constexpr bool open(const char* s, size_t arg) {
+            return *s == '}' ? finish(s, arg, '\0') :
+                   *s == ':' ? align(s + 1, arg) :
+                   false;
+        }
+
+        // [填充字符]对齐
+        static constexpr bool align(const char* s, size_t arg) {
+            return (*s != '\0' && *s != '}' && isAlign(s[1])) ? zero(s + 2, arg) :
+                   isAlign(*s) ? zero(s + 1, arg) :
+                   zero(s, arg);
+        }
+
+        // 补零标志
+        static constexpr bool zero(const char* s, size_t arg) {
+            return *s == '0' ? width(s + 1, arg) : width(s, arg);
+        }
+
+        // 宽度
+        static constexpr bool width(const char* s, size_t arg) {
+            return *s == '*' ? (isInteger(Codes::at(arg)) && precision(s + 1, arg + 1)) :
+                   precision(skipDigits(s), arg);
+        }
+
+        // .精度
+        static constexpr bool precision(const char* s, size_t arg) {
+            return *s != '.' ? type(s, arg) :
+                   s[1] == '*' ? (isInteger(Codes::at(arg)) && type(s + 2, arg + 1)) :
+                   isDigit(s[1]) && type(skipDigits(s + 1), arg);
+        }
+
+        // 类型说明符
+        static constexpr bool type(const char* s, size_t arg) {
+            return *s == '}' ? finish(s, arg, '\0') :
+                   (*s != '\0' && s[1] == '}') ? finish(s + 1, arg, *s) :
+                   false;
+        }
+
+        // '}'处消耗一个参数
+        static constexpr bool finish(const char* s, size_t arg, char spec) {
+            return compatible(Codes::at(arg), spec) && text(s + 1, arg + 1);
+        }
+    };
+
+    /**
+     * 格式化实现（运行时再解析一次格式字符串，解析本身远比输出便宜）
+     * @param sink 输出目标
+     * @param format 格式字符串
+     * @param args 参数数组
+     * @param count 参数个数
+     */
+    void vformat(FormatSink& sink, const char* format, const FormatArg* args, size_t count);
+
+    template <bool Valid, typename... Args>
+    inline void formatTo(FormatSink& sink, const char* format, const Args&... args) {
+        static_assert(Valid, "format string does not match the argument count or types");
+        const FormatArg packed[sizeof...(Args) + 1] = {
+            ArgTraits<typename std::decay<Args>::type>::make(args)..., FormatArg()
+        };
+        vformat(sink, format, packed, sizeof...(Args));
+    }
+
+    template <bool Valid, typename... Args>
+    inline void printTo(FILE* file, const char* format, const Args&... args) {
+        if (file == stdout) {
+            FormatSink* capture = stdoutCapture();
+            if (capture != nullptr) {
+                formatTo<Valid>(*capture, format, args...);
+                return;
+            }
+        }
+        FileSink sink(file);
+        formatTo<Valid>(sink, format, args...);
+    }
+
+    template <bool Valid, typename... Args>
+    inline std::string formatString(const char* format, const Args&... args) {
+        std::string result;
+        StringSink sink(result);
+        formatTo<Valid>(sink, format, args...);
+        return result;
+    }
+} // namespace detail
+
+} // namespace utils
+} // namespace evan
+
+/**
+ * 编译期检查格式字符串与参数（格式字符串必须是字面量）
+ */
+#define EVAN_FORMAT_VALID(fmt, ...) \
+    ::evan::utils::detail::FormatChecker<decltype(::evan::utils::detail::typeCodes(__VA_ARGS__))>::text(fmt, 0)
+
+/**
+ * 格式化写入输出目标
+ * @param sink FormatSink对象
+ * @param fmt 格式字符串字面量
+ */
+#define EVAN_FORMAT(sink, fmt, ...) \
+    ::evan::utils::detail::formatTo<EVAN_FORMAT_VALID(fmt, ##__VA_ARGS__)>(sink, fmt, ##__VA_ARGS__)
+
+/**
+ * 格式化写入FILE*
+ */
+#define EVAN_FPRINT(file, fmt, ...) \
+    ::evan::utils::detail::printTo<EVAN_FORMAT_VALID(fmt, ##__VA_ARGS__)>(file, fmt, ##__VA_ARGS__)
+
+/**
+ * 格式化写入标准输出
+ */
+#define EVAN_PRINT(fmt, ...) EVAN_FPRINT(stdout, fmt, ##__VA_ARGS__)
+
+/**
+ * 格式化为std::string
+ */
+#define EVAN_FORMAT_STRING(fmt, ...) \
+    ::evan::utils::detail::formatString<EVAN_FORMAT_VALID(fmt, ##__VA_ARGS__)>(fmt, ##__VA_ARGS__)
@@ -0,0 +1,51 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "utils/string_view.h"
+
+namespace evan {
+namespace utils {
+
+/**
+ * 只读内存映射文件
+ * 文件内容直接映射到地址空间，读取不经过用户态缓冲区，也不逐行分配字符串；
+ * view()返回的视图在close()或析构之前有效
+ */
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    /**
+     * 映射文件（已映射的文件先关闭）
+     * @param path 文件路径
+     * @return 成功返回true，空文件也算成功（视图为空）
+     */
+    bool open(const std::string& path);
+
+    /**
+     * 解除映射并关闭文件
+     */
+    void close();
+
+    /**
+     * 获取文件内容
+     */
+    StringView view() const { return StringView(data, length); }
+
+private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    const char* data;
+    size_t length;
+    void* file;      // HANDLE
+    void* mapping;   // HANDLE
+};
+
+} // namespace utils
+} // namespace evan
@@ -0,0 +1,314 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace evan {
+namespace utils {
+
+/**
+ * 缓存行大小
+ */
+const size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * 计数器和直方图的分片数（同时写入的线程不超过分片数时互不竞争）
+ */
+const size_t METRIC_SHARDS = 64;
+
+/**
+ * 直方图最多的桶边界数量
+ */
+const size_t MAX_HISTOGRAM_BOUNDS = 63;
+
+/**
+ * 延迟直方图的第一个桶上界（微秒）
+ */
+const unsigned long long LATENCY_FIRST_BOUND_US = 20;
+
+/**
+ * 延迟直方图每个2倍区间内的线性桶数（相对误差不超过1/4）
+ */
+const unsigned int LATENCY_STEPS_PER_OCTAVE = 4;
+
+namespace detail {
+    /**
+     * 为新线程分配分片下标（轮流分配）
+     */
+    size_t assignMetricShard();
+
+    /**
+     * 获取当前线程的分片下标
+     */
+    inline size_t currentMetricShard() {
+        static thread_local size_t shard = assignMetricShard();
+        return shard;
+    }
+} // namespace detail
+
+/**
+ * 计数器（只增不减）
+ * 每个线程写入自己的分片，分片按缓存行对齐，写入只是一次无竞争的relaxed原子加法；
+ * 只有读取时才汇总所有分片
+ */
+class MetricCounter {
+public:
+    MetricCounter();
+
+    /**
+     * 增加计数
+     * @param n 增量
+     */
+    void add(unsigned long long n = 1) {
+        shards[detail::currentMetricShard()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /**
+     * 获取所有分片之和
+     */
+    unsigned long long value() const;
+
+private:
+    MetricCounter(const MetricCounter&);
+    MetricCounter& operator=(const MetricCounter&);
+
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        std::atomic<unsigned long long> value;
+    };
+
+    Shard shards[METRIC_SHARDS];
+};
+
+/**
+ * 仪表（可增可减的当前值，如队列长度、连接数）
+ * 通常只有一个写入方，不分片
+ */
+class MetricGauge {
+public:
+    MetricGauge() : current(0) {}
+
+    void set(long long v) { current.store(v, std::memory_order_relaxed); }
+    void add(long long n) { current.fetch_add(n, std::memory_order_relaxed); }
+    long long value() const { return current.load(std::memory_order_relaxed); }
+
+private:
+    MetricGauge(const MetricGauge&);
+    MetricGauge& operator=(const MetricGauge&);
+
+    alignas(CACHE_LINE_SIZE) std::atomic<long long> current;
+};
+
+/**
+ * 直方图读数
+ */
+struct HistogramSnapshot {
+    std::vector<unsigned long long> bounds;   ///< 桶上界（含），最后一个桶没有上界
+    std::vector<unsigned long long> buckets;  ///< 每个桶的计数，比bounds多一个
+    unsigned long long count;                 ///< 样本总数
+    unsigned long long sum;                   ///< 样本之和
+    unsigned long long max;                   ///< 最大样本（精确值）
+
+    HistogramSnapshot() : count(0), sum(0), max(0) {}
+
+    /**
+     * 估计分位数（返回分位数所在桶的上界，不超过最大样本；落在最后一个桶时返回最大样本）
+     * @param q 分位数（0-1）
+     * @return 估计值，无样本时返回0
+     */
+    unsigned long long quantile(double q) const;
+};
+
+/**
+ * 固定桶边界的直方图（整数样本，如微秒、字节数）
+ * 与计数器一样按线程分片，读取时汇总
+ */
+class MetricHistogram {
+public:
+    /**
+     * 构造函数
+     * @param bounds 升序的桶上界
+     * @param count 边界数量（超过MAX_HISTOGRAM_BOUNDS的部分被忽略）
+     */
+    MetricHistogram(const unsigned long long* bounds, size_t count);
+
+    /**
+     * 记录一个样本
+     * @param value 样本值
+     */
+    void observe(unsigned long long value) {
+        Shard& shard = shards[detail::currentMetricShard()];
+        shard.buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+        shard.sum.fetch_add(value, std::memory_order_relaxed);
+        // 分片通常只有一个写入线程，比较交换几乎不会重试
+        unsigned long long current = shard.max.load(std::memory_order_relaxed);
+        while (value > current && !shard.max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * 汇总所有分片
+     * @param out [out] 读数
+     */
+    void snapshot(HistogramSnapshot& out) const;
+
+private:
+    MetricHistogram(const MetricHistogram&);
+    MetricHistogram& operator=(const MetricHistogram&);
+
+    size_t bucketOf(unsigned long long value) const {
+        size_t lo = 0;
+        size_t hi = bound_count;
+        while (lo < hi) {
+            const size_t mid = (lo + hi) / 2;
+            if (value <= bounds[mid]) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        return lo;
+    }
+
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        std::atomic<unsigned long long> buckets[MAX_HISTOGRAM_BOUNDS + 1];
+        std::atomic<unsigned long long> sum;
+        std::atomic<unsigned long long> max;
+    };
+
+    unsigned long long bounds[MAX_HISTOGRAM_BOUNDS];
+    size_t bound_count;
+    Shard shards[METRIC_SHARDS];
+};
+
+/**
+ * 生成对数线性的桶边界：从first开始，每个2倍区间等分为steps个桶
+ * 例如first=20、steps=4时为20, 25, 30, 35, 40, 50, 60, 70, 80, 100, ...
+ * @param out [out] 边界
+ * @param capacity 最多生成的边界数量
+ * @param first 第一个边界
+ * @param steps 每个2倍区间内的桶数（first应能被steps整除）
+ * @return 生成的边界数量
+ */
+size_t logLinearBounds(unsigned long long* out, size_t capacity, unsigned long long first, unsigned int steps);
+
+/**
+ * 计时作用域：析构时把经过的微秒数记录到直方图
+ *
+ * 示例：
+ *   static MetricHistogram& loadTime = MetricsRegistry::instance().latency("source.load_us");
+ *   LatencyTimer timer(loadTime);
+ */
+class LatencyTimer {
+public:
+    explicit LatencyTimer(MetricHistogram& histogram) :
+        histogram(histogram), start(std::chrono::steady_clock::now()) {}
+
+    ~LatencyTimer() {
+        histogram.observe(static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count()));
+    }
+
+private:
+    LatencyTimer(const LatencyTimer&);
+    LatencyTimer& operator=(const LatencyTimer&);
+
+    MetricHistogram& histogram;
+    std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * 指标类型
+ */
+enum MetricType {
+    METRIC_COUNTER,
+    METRIC_GAUGE,
+    METRIC_HISTOGRAM
+};
+
+/**
+ * 已注册的指标
+ */
+struct MetricEntry {
+    std::string name;
+    MetricType type;
+    MetricCounter* counter;       ///< type为METRIC_COUNTER时有效
+    MetricGauge* gauge;           ///< type为METRIC_GAUGE时有效
+    MetricHistogram* histogram;   ///< type为METRIC_HISTOGRAM时有效
+};
+
+/**
+ * 指标注册表
+ * 注册（按名称查找或创建）需要加锁，调用方应把返回的引用保存在静态变量中；
+ * 写入指标不经过注册表，完全无锁。指标在程序运行期间不会被释放。
+ *
+ * 示例：
+ *   static MetricCounter& ticks = MetricsRegistry::instance().counter("ticks");
+ *   ticks.add();
+ */
+class MetricsRegistry {
+public:
+    /**
+     * 获取全局注册表
+     */
+    static MetricsRegistry& instance();
+
+    /**
+     * 获取或创建计数器
+     * @param name 指标名
+     * @return 计数器引用
+     * @throws std::invalid_argument 同名指标的类型不同
+     */
+    MetricCounter& counter(const std::string& name);
+
+    /**
+     * 获取或创建仪表
+     * @param name 指标名
+     * @return 仪表引用
+     * @throws std::invalid_argument 同名指标的类型不同
+     */
+    MetricGauge& gauge(const std::string& name);
+
+    /**
+     * 获取或创建直方图（已存在时忽略bounds）
+     * @param name 指标名
+     * @param bounds 升序的桶上界
+     * @param count 边界数量
+     * @return 直方图引用
+     * @throws std::invalid_argument 同名指标的类型不同
+     */
+    MetricHistogram& histogram(const std::string& name, const unsigned long long* bounds, size_t count);
+
+    /**
+     * 获取或创建延迟直方图（微秒，对数线性的桶边界，见logLinearBounds）
+     * @param name 指标名，约定以"_us"结尾
+     * @return 直方图引用
+     * @throws std::invalid_argument 同名指标的类型不同
+     */
+    MetricHistogram& latency(const std::string& name);
+
+    /**
+     * 获取所有指标（按注册顺序）
+     * @return 指标列表
+     */
+    std::vector<MetricEntry> entries() const;
+
+private:
+    MetricsRegistry() {}
+    MetricsRegistry(const MetricsRegistry&);
+    MetricsRegistry& operator=(const MetricsRegistry&);
+
+    MetricEntry* find(const std::string& name, MetricType type);
+
+    mutable std::mutex mutex;
+    std::vector<MetricEntry> metrics;
+};
+
+} // namespace utils
+} // namespace evan
@@ -0,0 +1,108 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace evan {
+namespace utils {
+
+/**
+ * 固定容量环形缓冲区
+ * 容量在构造时确定并一次性分配，写满后覆盖最旧的元素
+ * 下标0表示最旧的元素，size()-1表示最新的元素
+ */
+template <typename T>
+class RingBuffer {
+public:
+    /**
+     * 构造函数
+     * @param capacity 缓冲区容量（至少为1）
+     */
+    explicit RingBuffer(size_t capacity = 1);
+
+    /**
+     * 追加元素，缓冲区已满时覆盖最旧的元素
+     * @param value 新元素
+     */
+    void push(const T& value);
+
+    /**
+     * 按时间顺序访问元素
+     * @param index 下标（0为最旧）
+     * @return 元素引用
+     */
+    const T& operator[](size_t index) const;
+
+    /**
+     * 获取最新的元素（缓冲区不能为空）
+     * @return 最新元素引用
+     */
+    const T& back() const;
+
+    /**
+     * 获取当前元素数量
+     * @return 元素数量
+     */
+    size_t size() const { return count; }
+
+    /**
+     * 获取缓冲区容量
+     * @return 容量
+     */
+    size_t capacity() const { return storage.size(); }
+
+    /**
+     * 检查缓冲区是否为空
+     * @return 为空返回true
+     */
+    bool empty() const { return count == 0; }
+
+    /**
+     * 清空缓冲区（不释放内存）
+     */
+    void clear();
+
+private:
+    std::vector<T> storage;
+    size_t head;   // 下一个写入位置
+    size_t count;  // 当前元素数量
+};
+
+// 模板方法实现
+
+template <typename T>
+RingBuffer<T>::RingBuffer(size_t capacity) :
+    storage(capacity == 0 ? 1 : capacity), head(0), count(0) {
+}
+
+template <typename T>
+void RingBuffer<T>::push(const T& value) {
+    storage[head] = value;
+    head = (head + 1) % storage.size();
+    if (count < storage.size()) {
+        ++count;
+    }
+}
+
+template <typename T>
+const T& RingBuffer<T>::operator[](size_t index) const {
+    // head - count 即最旧元素的位置，加上容量避免无符号下溢
+    return storage[(head + storage.size() - count + index) % storage.size()];
+}
+
+template <typename T>
+const T& RingBuffer<T>::back() const {
+    return storage[(head + storage.size() - 1) % storage.size()];
+}
+
+template <typename T>
+void RingBuffer<T>::clear() {
+    head = 0;
+    count = 0;
+}
+
+} // namespace utils
+} // namespace evan
@@ -0,0 +1,128 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "utils/string_view.h"
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+namespace evan {
+namespace utils {
+
+/**
+ * SIMD字节扫描内核
+ * 分隔符位图（StringUtils::SplitIterator和WordIterator的行、空白分割）、ASCII小写转换
+ * （StringUtils::toLowerInPlace）和列式数据的范围过滤（告警规则）提供SSE2/AVX2实现，
+ * 首次使用时通过CPUID选择当前CPU支持的最快版本，不支持的平台（如ARM64）回退到标量实现。
+ * 单次查找一个字节直接使用memchr：在bench的测量中C库的实现比这里的SSE2/AVX2内核更快；
+ * 分割则一次取得64字节内所有分隔符的位置，每个字段只需要一次取最低置位
+ */
+class SimdScan {
+public:
+    /**
+     * 指令集级别
+     */
+    enum Level {
+        SCALAR = 0,  ///< 标量实现
+        SSE2 = 1,    ///< 128位SSE2
+        AVX2 = 2     ///< 256位AVX2
+    };
+
+    /**
+     * 获取当前使用的指令集级别
+     * @return 指令集级别
+     */
+    static Level level();
+
+    /**
+     * 获取CPU支持的最高指令集级别
+     * @return 指令集级别
+     */
+    static Level detectedLevel();
+
+    /**
+     * 获取指令集级别名称
+     * @param lvl 指令集级别
+     * @return 名称字符串
+     */
+    static const char* levelName(Level lvl);
+
+    /**
+     * 强制使用指定的指令集级别（用于基准测试对比各内核）
+     * 超过CPU支持的级别时使用CPU支持的最高级别
+     * @param lvl 指令集级别
+     */
+    static void setLevel(Level lvl);
+
+    /**
+     * 分隔符块的字节数（位图的位数）
+     */
+    static const size_t BLOCK_BYTES = 64;
+
+    /**
+     * 字节位图：第i位为1当且仅当data[i] == byte
+     * @param data 数据
+     * @param length 数据长度，只检查前min(length, BLOCK_BYTES)个字节，其余位为0
+     * @param byte 要查找的字节
+     * @return 位图
+     */
+    static uint64_t byteMask(const char* data, size_t length, char byte);
+
+    /**
+     * 空白位图：第i位为1当且仅当data[i]是空白（' '、'\t'、'\r'、'\n'，与StringUtils::trimView一致）
+     * @param data 数据
+     * @param length 数据长度，只检查前min(length, BLOCK_BYTES)个字节，其余位为0
+     * @return 位图
+     */
+    static uint64_t whitespaceMask(const char* data, size_t length);
+
+    /**
+     * 获取最低置位的下标
+     * @param mask 位图（不能为0）
+     * @return 下标
+     */
+    static unsigned int lowestBit(uint64_t mask) {
+    #if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, mask);
+        return static_cast<unsigned int>(index);
+    #elif defined(_MSC_VER)
+        unsigned long index;
+        if (_BitScanForward(&index, static_cast<unsigned long>(mask))) {
+            return static_cast<unsigned int>(index);
+        }
+        _BitScanForward(&index, static_cast<unsigned long>(mask >> 32));
+        return static_cast<unsigned int>(index) + 32;
+    #else
+        return static_cast<unsigned int>(__builtin_ctzll(mask));
+    #endif
+    }
+
+    /**
+     * 原地将ASCII字符转换为小写
+     * @param data 字符缓冲区
+     * @param length 长度
+     */
+    static void toLowerAscii(char* data, size_t length);
+
+    /**
+     * 列范围过滤：第i位为1当且仅当candidates的第i位为1且low <= values[i] <= low + span
+     * 以64行为一组，候选位全为0的组不读取values
+     * @param values 列数据
+     * @param count 行数
+     * @param low 下界
+     * @param span 上界与下界之差
+     * @param candidates 候选行位图（(count + 63) / 64个字）
+     * @param out [out] 结果位图（与candidates可以是同一数组），最后一个字中超出count的位为0
+     */
+    static void rangeMask(const uint32_t* values, size_t count, uint32_t low, uint32_t span,
+                          const uint64_t* candidates, uint64_t* out);
+};
+
+} // namespace utils
+} // namespace evan
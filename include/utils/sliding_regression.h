@@ -0,0 +1,89 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace evan {
+namespace utils {
+
+/**
+ * 滑动窗口上的在线最小二乘直线拟合
+ *
+ * 窗口保存最近capacity个点（环形缓冲区，内存固定），同时维护Σx、Σy、Σxx、Σxy、Σyy，
+ * 每加入一个点只更新一次和式（满了之后先减去最旧的点），斜率、截距和R²都是O(1)。
+ * 和式相对窗口中最旧的点计算（避免绝对时间和字节数相乘丢失精度），
+ * 每加入capacity个点从缓冲区重新求和一次，抵消反复加减累积的舍入误差，均摊仍为O(1)
+ */
+class SlidingRegression {
+public:
+    /**
+     * @param capacity 窗口中的点数（至少为2）
+     */
+    explicit SlidingRegression(size_t capacity);
+
+    /**
+     * 加入一个点（窗口满时丢弃最旧的点）
+     * @param x 自变量（如时间，应单调递增）
+     * @param y 因变量
+     */
+    void add(double x, double y);
+
+    /**
+     * 清空窗口
+     */
+    void clear();
+
+    /**
+     * 斜率（少于2个点或x全部相同时为0）
+     */
+    double slope() const;
+
+    /**
+     * 拟合直线在x处的值
+     */
+    double predict(double x) const;
+
+    /**
+     * 决定系数R²（0-1，越接近1越接近直线；y全部相同时为0）
+     */
+    double r2() const;
+
+    /**
+     * 窗口中最新与最旧的点的x之差
+     */
+    double span() const;
+
+    size_t size() const { return count; }
+    size_t capacity() const { return xs.size(); }
+    bool full() const { return count == xs.size(); }
+
+    /**
+     * 最新的点
+     */
+    double lastX() const { return xs[newest()]; }
+    double lastY() const { return ys[newest()]; }
+
+private:
+    size_t newest() const { return (head + xs.size() - 1) % xs.size(); }
+    size_t oldest() const { return (head + xs.size() - count) % xs.size(); }
+
+    /**
+     * 以最旧的点为原点重新计算和式
+     */
+    void rebuild();
+
+    std::vector<double> xs;
+    std::vector<double> ys;
+    size_t head;        ///< 下一个点写入的位置
+    size_t count;
+    size_t pending;     ///< 距离上一次重新求和加入的点数
+    double originX;     ///< 和式的原点
+    double originY;
+    double sx, sy, sxx, sxy, syy;
+};
+
+} // namespace utils
+} // namespace evan
@@ -0,0 +1,88 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <cstdint>
+
+namespace evan {
+namespace utils {
+
+/**
+ * 默认的EWMA平滑系数（约等于最近40个样本的加权平均）
+ */
+const double STREAMING_DEFAULT_ALPHA = 0.05;
+
+/**
+ * 开始评分之前需要的样本数（之前的样本只用于建立统计量）
+ */
+const uint32_t STREAMING_WARMUP_SAMPLES = 10;
+
+/**
+ * 预热结束后样本截断到EWMA均值±几个标准差再更新（Huber）
+ */
+const double STREAMING_HUBER_K = 3.0;
+
+/**
+ * 离散程度的下限与水平值之比（平稳的指标发生很小的变化时不至于得到极大的z值）
+ */
+const double STREAMING_RELATIVE_FLOOR = 0.01;
+
+/**
+ * 流式统计量：每个样本O(1)更新，不保存历史，内存固定
+ *
+ * 同时维护两组估计：
+ * - EWMA均值和方差：预热结束后样本先截断到均值±STREAMING_HUBER_K个标准差再更新（Huber），
+ *   单个异常值不会把均值和方差拉偏；
+ * - 中位数和MAD（中位数绝对偏差）：预热期间用EWMA初始化，之后按符号以与MAD成比例的步长逼近
+ *   （frugal streaming），对异常值不敏感，用于稳健z值 0.6745 * (x - 中位数) / MAD。
+ *
+ * 用法：先用zScore()/robustZ()对新样本评分（与之前的样本比较），再add()更新
+ */
+class StreamingStats {
+public:
+    StreamingStats() : mean_(0.0), variance_(0.0), median_(0.0), mad_(0.0), count_(0) {}
+
+    /**
+     * 加入一个样本
+     * @param value 样本值
+     * @param alpha 平滑系数（0-1，越大越快适应新水平）
+     */
+    void add(double value, double alpha = STREAMING_DEFAULT_ALPHA);
+
+    /**
+     * 相对EWMA均值和标准差的z值
+     */
+    double zScore(double value) const;
+
+    /**
+     * 相对中位数和MAD的稳健z值
+     */
+    double robustZ(double value) const;
+
+    /**
+     * 是否已经完成预热（可以评分）
+     */
+    bool ready() const { return count_ >= STREAMING_WARMUP_SAMPLES; }
+
+    double mean() const { return mean_; }
+    double variance() const { return variance_; }
+    double median() const { return median_; }
+    double mad() const { return mad_; }
+    uint32_t count() const { return count_; }
+
+private:
+    /**
+     * 离散程度的下限
+     */
+    double floor() const;
+
+    double mean_;
+    double variance_;
+    double median_;
+    double mad_;
+    uint32_t count_;
+};
+
+} // namespace utils
+} // namespace evan
@@ -7,6 +7,16 @@
 #include <vector>
 #include <sstream>
 #include <algorithm>
+#include <cerrno>
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include "utils/simd_scan.h"
+#include "utils/string_view.h"
 
 namespace evan {
 namespace utils {
@@ -112,14 +122,149 @@ public:
     template <typename T>
     static T toNumber(const std::string& str, T defaultValue = T());
     
+    // 以下为不分配内存的视图接口，用于热点路径
+    
+    /**
+     * 去除首尾空白字符，返回原字符串的子视图
+     * @param str 输入视图
+     * @return 去除空白后的视图
+     */
+    static StringView trimView(StringView str);
+    
+    /**
+     * 按分隔符分割到调用方提供的视图数组
+     * @param str 输入视图
+     * @param delimiter 分隔符
+     * @param out 输出视图数组
+     * @param capacity 输出数组长度
+     * @return 字段总数（可能大于capacity，超出部分不写入）
+     */
+    static size_t splitView(StringView str, char delimiter, StringView* out, size_t capacity);
+    
+    /**
+     * 惰性分割迭代器
+     * 每次调用next()返回下一个字段，不分配内存。
+     * 分隔符的位置以64字节为一块由SimdScan::byteMask一次取得，每个字段只需要取一次最低置位
+     * 用法：
+     *   StringUtils::SplitIterator it(content, '\n');
+     *   StringView field;
+     *   while (it.next(field)) { ... }
+     */
+    class SplitIterator {
+    public:
+        /**
+         * 构造函数
+         * @param str 输入视图
+         * @param delimiter 分隔符
+         */
+        SplitIterator(StringView str, char delimiter);
+        
+        /**
+         * 获取下一个字段
+         * @param field [out] 字段视图
+         * @return 还有字段返回true
+         */
+        bool next(StringView& field);
+        
+    private:
+        const char* cursor;  // 当前字段的开头
+        const char* block;   // 当前块的开头
+        const char* end;
+        uint64_t pending;    // 当前块中尚未使用的分隔符
+        char delimiter;
+        bool done;
+    };
+    
+    /**
+     * 按空白分割的惰性迭代器
+     * 连续的空白（' '、'\t'、'\r'、'\n'）视为一个分隔，不产生空字段（与awk的字段分割一致），不分配内存。
+     * 空白位图以64字节为一块由SimdScan::whitespaceMask一次取得，与左移一位的自身异或得到单词的边界，
+     * 边界依次是单词的开头和结尾，每个单词只需要取两次最低置位
+     * 用法：
+     *   StringUtils::WordIterator it(value);
+     *   StringView word;
+     *   while (it.next(word)) { ... }
+     */
+    class WordIterator {
+    public:
+        /**
+         * 构造函数
+         * @param str 输入视图
+         */
+        explicit WordIterator(StringView str);
+        
+        /**
+         * 获取下一个单词
+         * @param word [out] 单词视图
+         * @return 还有单词返回true
+         */
+        bool next(StringView& word);
+        
+    private:
+        /**
+         * 计算当前块的单词边界
+         */
+        void load();
+        
+        /**
+         * 取下一个单词边界
+         * @param pos [out] 边界位置
+         * @return 没有更多边界返回false
+         */
+        bool pop(const char*& pos);
+        
+        const char* block;     // 当前块的开头
+        const char* end;
+        uint64_t boundaries;   // 当前块中尚未使用的单词边界
+        uint64_t previous;     // 上一块最后一个字节是否为空白（输入开头之前视为空白）
+    };
+    
+    /**
+     * 原地将ASCII字符转换为小写
+     * @param data 字符缓冲区
+     * @param length 长度
+     */
+    static void toLowerInPlace(char* data, size_t length);
+    
+    /**
+     * 原地将字符串转换为小写
+     * @param str 字符串
+     */
+    static void toLowerInPlace(std::string& str);
+    
     /**
-     * 格式化字符串
-     * @param format 格式字符串
-     * @param args 可变参数
-     * @return 格式化后的字符串
+     * 原地替换子串（复用字符串已有容量）
+     * @param str 字符串
+     * @param from 要替换的子串
+     * @param to 替换后的子串
+     */
+    static void replaceInPlace(std::string& str, StringView from, StringView to);
+    
+    /**
+     * 通配符匹配（'*'匹配任意个字符，'?'匹配一个字符）
+     * @param text 被匹配的文本
+     * @param pattern 模式
+     * @param ignoreCase 是否忽略ASCII大小写
+     * @return 整个文本与模式匹配返回true
      */
-    template <typename... Args>
-    static std::string format(const std::string& format, Args&&... args);
+    static bool wildcardMatch(StringView text, StringView pattern, bool ignoreCase);
+    
+    /**
+     * 从视图开头解析数值（与std::from_chars语义一致：不跳过空白，不分配内存）
+     * @param str 输入视图
+     * @param value [out] 解析结果，失败时不修改
+     * @return 消耗的字符数，失败（无数字或溢出）返回0
+     */
+    template <typename T>
+    static size_t parseNumber(StringView str, T& value);
+    
+private:
+    // 按是否为整数类型分派
+    template <typename T>
+    static size_t parseNumberImpl(StringView str, T& value, std::true_type);
+    
+    template <typename T>
+    static size_t parseNumberImpl(StringView str, T& value, std::false_type);
 };
 
 // 模板方法实现
@@ -136,6 +281,72 @@ std::string StringUtils::toString(T value) {
     return oss.str();
 }
 
+/**
+ * 获取下一个字段
+ * 相邻分隔符之间以及末尾分隔符之后都会产生空字段，与split(str, string)一致
+ * @param field [out] 字段视图
+ * @return 还有字段返回true
+ */
+inline bool StringUtils::SplitIterator::next(StringView& field) {
+    if (done) {
+        return false;
+    }
+    
+    // 当前块的分隔符用完后取下一块，最后一块之后剩余的部分是最后一个字段
+    while (pending == 0) {
+        if (static_cast<size_t>(end - block) <= SimdScan::BLOCK_BYTES) {
+            field = StringView(cursor, static_cast<size_t>(end - cursor));
+            done = true;
+            return true;
+        }
+        block += SimdScan::BLOCK_BYTES;
+        pending = SimdScan::byteMask(block, static_cast<size_t>(end - block), delimiter);
+    }
+    
+    const char* pos = block + SimdScan::lowestBit(pending);
+    pending &= pending - 1;
+    field = StringView(cursor, static_cast<size_t>(pos - cursor));
+    cursor = pos + 1;
+    return true;
+}
+
+/**
+ * 获取下一个单词
+ * 输入恰好在单词中间结束时（长度为BLOCK_BYTES的整数倍）没有结尾边界，单词到输入末尾为止
+ * @param word [out] 单词视图
+ * @return 还有单词返回true
+ */
+inline bool StringUtils::WordIterator::next(StringView& word) {
+    const char* start;
+    if (!pop(start)) {
+        return false;
+    }
+    const char* stop;
+    if (!pop(stop)) {
+        stop = end;
+    }
+    word = StringView(start, static_cast<size_t>(stop - start));
+    return true;
+}
+
+/**
+ * 取下一个单词边界
+ * @param pos [out] 边界位置
+ * @return 没有更多边界返回false
+ */
+inline bool StringUtils::WordIterator::pop(const char*& pos) {
+    while (boundaries == 0) {
+        if (static_cast<size_t>(end - block) <= SimdScan::BLOCK_BYTES) {
+            return false;
+        }
+        block += SimdScan::BLOCK_BYTES;
+        load();
+    }
+    pos = block + SimdScan::lowestBit(boundaries);
+    boundaries &= boundaries - 1;
+    return true;
+}
+
 /**
  * 将字符串转换为数值
  * @param str 字符串
@@ -145,32 +356,135 @@ std::string StringUtils::toString(T value) {
 template <typename T>
 T StringUtils::toNumber(const std::string& str, T defaultValue) {
     T result = defaultValue;
-    std::istringstream iss(str);
-    iss >> result;
+    parseNumber(trimView(str), result);
     return result;
 }
 
 /**
- * 格式化字符串
- * @param format 格式字符串
- * @param args 可变参数
- * @return 格式化后的字符串
+ * 从视图开头解析数值
+ * @param str 输入视图
+ * @param value [out] 解析结果
+ * @return 消耗的字符数，失败返回0
+ */
+template <typename T>
+size_t StringUtils::parseNumber(StringView str, T& value) {
+    static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value,
+                  "parseNumber requires a non-bool arithmetic type");
+    return parseNumberImpl(str, value, std::is_integral<T>());
+}
+
+/**
+ * 解析整数
+ * 逐位累加并检查溢出，不依赖区域设置
+ */
+template <typename T>
+size_t StringUtils::parseNumberImpl(StringView str, T& value, std::true_type) {
+    typedef typename std::make_unsigned<T>::type U;
+    
+    size_t pos = 0;
+    bool negative = false;
+    if (pos < str.size() && (str[pos] == '-' || str[pos] == '+')) {
+        negative = str[pos] == '-';
+        if (negative && !std::is_signed<T>::value) {
+            return 0;
+        }
+        ++pos;
+    }
+    
+    // 负数允许的绝对值比正数大1
+    const U limit = negative ? static_cast<U>(static_cast<U>(std::numeric_limits<T>::max()) + 1)
+                             : static_cast<U>(std::numeric_limits<T>::max());
+    const size_t digits_begin = pos;
+    U result = 0;
+    
+    while (pos < str.size() && str[pos] >= '0' && str[pos] <= '9') {
+        const U digit = static_cast<U>(str[pos] - '0');
+        if (result > (limit - digit) / 10) {
+            return 0;
+        }
+        result = static_cast<U>(result * 10 + digit);
+        ++pos;
+    }
+    
+    if (pos == digits_begin) {
+        return 0;
+    }
+    
+    value = negative ? static_cast<T>(static_cast<U>(0) - result) : static_cast<T>(result);
+    return pos;
+}
+
+/**
+ * 解析浮点数
+ * 先按十进制格式（[+-]digits[.digits][(e|E)[+-]digits]）确定数值的范围，
+ * 不接受前导空白、十六进制、inf和nan；再复制到栈缓冲区交给strtod，
+ * 小数点替换为当前区域设置的小数点，结果与区域设置无关。
+ * 超出缓冲区、超出T的范围（ERANGE）或结果不是有限值时失败
  */
-template <typename... Args>
-std::string StringUtils::format(const std::string& format, Args&&... args) {
-    // 计算所需缓冲区大小
-    int size = snprintf(nullptr, 0, format.c_str(), std::forward<Args>(args)...);
-    if (size <= 0) {
-        return "";
+template <typename T>
+size_t StringUtils::parseNumberImpl(StringView str, T& value, std::false_type) {
+    char buffer[64];
+    
+    size_t pos = 0;
+    if (pos < str.size() && (str[pos] == '-' || str[pos] == '+')) {
+        ++pos;
+    }
+    const size_t digits_begin = pos;
+    while (pos < str.size() && str[pos] >= '0' && str[pos] <= '9') {
+        ++pos;
+    }
+    size_t digits = pos - digits_begin;
+    if (digits == 1 && str[digits_begin] == '0' && pos < str.size() && (str[pos] == 'x' || str[pos] == 'X')) {
+        return 0;
+    }
+    
+    size_t point = str.size();
+    if (pos < str.size() && str[pos] == '.') {
+        point = pos++;
+        const size_t fraction_begin = pos;
+        while (pos < str.size() && str[pos] >= '0' && str[pos] <= '9') {
+            ++pos;
+        }
+        digits += pos - fraction_begin;
+    }
+    if (digits == 0) {
+        return 0;
     }
     
-    // 分配缓冲区
-    std::vector<char> buffer(size + 1);
+    // 指数部分没有数字时不属于该数值（如 "5e" 只解析 "5"）
+    if (pos < str.size() && (str[pos] == 'e' || str[pos] == 'E')) {
+        size_t exponent = pos + 1;
+        if (exponent < str.size() && (str[exponent] == '-' || str[exponent] == '+')) {
+            ++exponent;
+        }
+        const size_t exponent_begin = exponent;
+        while (exponent < str.size() && str[exponent] >= '0' && str[exponent] <= '9') {
+            ++exponent;
+        }
+        if (exponent > exponent_begin) {
+            pos = exponent;
+        }
+    }
     
-    // 格式化字符串
-    snprintf(buffer.data(), buffer.size(), format.c_str(), std::forward<Args>(args)...);
+    if (pos >= sizeof(buffer)) {
+        return 0;
+    }
+    std::memcpy(buffer, str.data(), pos);
+    buffer[pos] = '\0';
+    if (point < pos) {
+        buffer[point] = *std::localeconv()->decimal_point;
+    }
+    
+    char* end = nullptr;
+    errno = 0;
+    const double result = std::strtod(buffer, &end);
+    if (end != buffer + pos || errno == ERANGE || !std::isfinite(result) ||
+        std::fabs(result) > static_cast<double>(std::numeric_limits<T>::max())) {
+        return 0;
+    }
     
-    return std::string(buffer.data());
+    value = static_cast<T>(result);
+    return pos;
 }
 
 } // namespace utils
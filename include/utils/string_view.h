@@ -0,0 +1,148 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace evan {
+namespace utils {
+
+/**
+ * 只读字符串视图
+ * 项目使用C++11，没有std::string_view，这里提供热点路径需要的最小子集
+ * 视图不拥有数据，调用方需保证被引用的字符串在视图使用期间有效
+ */
+class StringView {
+public:
+    static const size_t npos = static_cast<size_t>(-1);
+
+    StringView() : ptr(""), len(0) {}
+    StringView(const char* str) : ptr(str), len(std::strlen(str)) {}
+    StringView(const char* str, size_t length) : ptr(str), len(length) {}
+    StringView(const std::string& str) : ptr(str.data()), len(str.size()) {}
+
+    const char* data() const { return ptr; }
+    size_t size() const { return len; }
+    size_t length() const { return len; }
+    bool empty() const { return len == 0; }
+    const char* begin() const { return ptr; }
+    const char* end() const { return ptr + len; }
+    char operator[](size_t index) const { return ptr[index]; }
+    char front() const { return ptr[0]; }
+    char back() const { return ptr[len - 1]; }
+
+    /**
+     * 获取子视图（越界时截断，不抛异常）
+     * @param pos 起始位置
+     * @param count 长度
+     * @return 子视图
+     */
+    StringView substr(size_t pos, size_t count = npos) const {
+        if (pos > len) {
+            pos = len;
+        }
+        if (count > len - pos) {
+            count = len - pos;
+        }
+        return StringView(ptr + pos, count);
+    }
+
+    /**
+     * 去掉前n个字符
+     */
+    void removePrefix(size_t count) {
+        if (count > len) {
+            count = len;
+        }
+        ptr += count;
+        len -= count;
+    }
+
+    /**
+     * 去掉后n个字符
+     */
+    void removeSuffix(size_t count) {
+        len -= count > len ? len : count;
+    }
+
+    /**
+     * 查找字符
+     * @return 位置，未找到返回npos
+     */
+    size_t find(char ch, size_t pos = 0) const {
+        if (pos >= len) {
+            return npos;
+        }
+        const void* found = std::memchr(ptr + pos, ch, len - pos);
+        return found ? static_cast<size_t>(static_cast<const char*>(found) - ptr) : npos;
+    }
+
+    /**
+     * 查找子串
+     * @return 位置，未找到返回npos
+     */
+    size_t find(StringView needle, size_t pos = 0) const {
+        if (needle.len == 0) {
+            return pos <= len ? pos : npos;
+        }
+        while (pos + needle.len <= len) {
+            size_t hit = find(needle.ptr[0], pos);
+            if (hit == npos || hit + needle.len > len) {
+                return npos;
+            }
+            if (std::memcmp(ptr + hit, needle.ptr, needle.len) == 0) {
+                return hit;
+            }
+            pos = hit + 1;
+        }
+        return npos;
+    }
+
+    bool startsWith(StringView prefix) const {
+        return len >= prefix.len && std::memcmp(ptr, prefix.ptr, prefix.len) == 0;
+    }
+
+    bool endsWith(StringView suffix) const {
+        return len >= suffix.len && std::memcmp(ptr + len - suffix.len, suffix.ptr, suffix.len) == 0;
+    }
+
+    /**
+     * 按字典序比较
+     * @return 小于返回负数，相等返回0，大于返回正数
+     */
+    int compare(StringView other) const {
+        size_t common = len < other.len ? len : other.len;
+        int result = common ? std::memcmp(ptr, other.ptr, common) : 0;
+        if (result != 0) {
+            return result;
+        }
+        return len < other.len ? -1 : (len > other.len ? 1 : 0);
+    }
+
+    /**
+     * 复制为std::string（会分配内存）
+     */
+    std::string toString() const { return std::string(ptr, len); }
+
+private:
+    const char* ptr;
+    size_t len;
+};
+
+inline bool operator==(StringView a, StringView b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size()) == 0;
+}
+
+inline bool operator!=(StringView a, StringView b) {
+    return !(a == b);
+}
+
+inline bool operator<(StringView a, StringView b) {
+    return a.compare(b) < 0;
+}
+
+} // namespace utils
+} // namespace evan
@@ -0,0 +1,93 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include "utils/mapped_file.h"
+#include "utils/string_view.h"
+
+namespace evan {
+namespace utils {
+
+/**
+ * tar（ustar格式）的块大小
+ */
+const size_t TAR_BLOCK_SIZE = 512;
+
+/**
+ * 写入ustar格式的归档（只包含普通文件，目录由路径隐含）
+ * 路径长度不超过255字节（超过100字节的部分写入prefix字段）
+ */
+class TarWriter {
+public:
+    TarWriter();
+    ~TarWriter();
+
+    /**
+     * 创建归档文件
+     * @param path 文件路径
+     * @return 成功返回true
+     */
+    bool open(const std::string& path);
+
+    /**
+     * 追加一个文件
+     * @param name 归档内的路径（使用'/'分隔）
+     * @param data 文件内容
+     * @return 成功返回true，路径过长或写入失败返回false
+     */
+    bool add(StringView name, StringView data);
+
+    /**
+     * 写入结束标记并关闭文件
+     * @return 所有写入都成功返回true
+     */
+    bool close();
+
+private:
+    TarWriter(const TarWriter&);
+    TarWriter& operator=(const TarWriter&);
+
+    FILE* file;
+    bool failed;
+};
+
+/**
+ * 归档中的一个文件
+ */
+struct TarEntry {
+    std::string name;   ///< 归档内的路径
+    StringView data;    ///< 文件内容（指向映射的归档，在TarReader关闭之前有效）
+};
+
+/**
+ * 读取ustar格式的归档
+ * 整个归档映射到内存，文件内容以视图返回，不复制
+ */
+class TarReader {
+public:
+    TarReader() : offset(0) {}
+
+    /**
+     * 打开归档
+     * @param path 文件路径
+     * @return 成功返回true
+     */
+    bool open(const std::string& path);
+
+    /**
+     * 读取下一个普通文件（跳过目录等其他类型的条目）
+     * @param entry [out] 文件
+     * @return 还有文件返回true，到达结束标记、文件末尾或头部校验失败返回false
+     */
+    bool next(TarEntry& entry);
+
+private:
+    MappedFile file;
+    size_t offset;
+};
+
+} // namespace utils
+} // namespace evan
@@ -0,0 +1,1069 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "core/alert_rules.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include "core/alert_sink.h"
+#include "core/collector.h"
+#include "core/process_query.h"
+#include "utils/format.h"
+#include "utils/simd_scan.h"
+#include "utils/string_utils.h"
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+namespace evan {
+    /**
+     * 节点类型
+     */
+    enum AlertNodeKind {
+        NODE_CONST,    ///< 常量（low为0或1）
+        NODE_SYSTEM,   ///< 系统字段与常量比较
+        NODE_RANGE,    ///< 数值列在[low, low + span]内（negate取反）
+        NODE_NAME,     ///< 进程名与patterns[left]匹配（negate取反）
+        NODE_AND,
+        NODE_OR,
+        NODE_NOT       ///< left为子节点
+    };
+
+    /**
+     * 比较运算符
+     */
+    enum AlertOperator {
+        OP_GT, OP_GE, OP_LT, OP_LE, OP_EQ, OP_NE, OP_MATCH, OP_NOT_MATCH
+    };
+
+    /**
+     * 运算符文本（两个字符的在前，按顺序匹配）
+     */
+    static const struct {
+        const char* text;
+        AlertOperator op;
+    } ALERT_OPERATORS[] = {
+        {">=", OP_GE}, {"<=", OP_LE}, {"==", OP_EQ}, {"!=", OP_NE}, {"!~", OP_NOT_MATCH},
+        {">", OP_GT}, {"<", OP_LT}, {"~", OP_MATCH}
+    };
+
+    /**
+     * 字段
+     */
+    static const struct AlertFieldInfo {
+        const char* name;
+        bool process;     ///< 进程字段
+        bool text;        ///< 字符串字段（只有proc.name）
+        uint8_t index;    ///< AlertColumn或AlertSystemField
+        double unit;      ///< 数值列每个单位对应的值（字节列按KB保存）
+    } ALERT_FIELDS[] = {
+        {"proc.rss",           true,  false, ALERT_COLUMN_RSS,        1024.0},
+        {"proc.pagefile",      true,  false, ALERT_COLUMN_PAGEFILE,   1024.0},
+        {"proc.pid",           true,  false, ALERT_COLUMN_PID,        1.0},
+        {"proc.name",          true,  true,  0,                       1.0},
+        {"sys.mem.used_pct",   false, false, ALERT_SYS_MEM_USED_PCT,  1.0},
+        {"sys.mem.used",       false, false, ALERT_SYS_MEM_USED,      1.0},
+        {"sys.mem.avail",      false, false, ALERT_SYS_MEM_AVAIL,     1.0},
+        {"sys.mem.total",      false, false, ALERT_SYS_MEM_TOTAL,     1.0},
+        {"sys.swap.used_pct",  false, false, ALERT_SYS_SWAP_USED_PCT, 1.0},
+        {"sys.proc_count",     false, false, ALERT_SYS_PROC_COUNT,    1.0}
+    };
+
+    /**
+     * 数值列的最大值
+     */
+    static const uint32_t ALERT_COLUMN_MAX = 0xFFFFFFFFu;
+
+    /**
+     * 字段名和规则名中可以使用的字符
+     */
+    static bool evos_alert_name_char(char ch) {
+        return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') || ch == '_' || ch == '.';
+    }
+
+    /**
+     * 获取最低置位的下标（bits不能为0）
+     */
+    static inline unsigned int evos_alert_lowest_bit(uint64_t bits) {
+    #ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return static_cast<unsigned int>(index);
+    #else
+        return static_cast<unsigned int>(__builtin_ctzll(bits));
+    #endif
+    }
+
+    AlertInputs::AlertInputs() : rows(0) {
+        for (size_t c = 0; c < ALERT_COLUMN_COUNT; ++c) {
+            lowest[c] = 0;
+            highest[c] = 0;
+        }
+        for (size_t i = 0; i < ALERT_SYS_FIELD_COUNT; ++i) {
+            system[i] = 0.0;
+        }
+    }
+
+    /**
+     * 字节数转换为KB（超过列的范围时取最大值）
+     */
+    static uint32_t evos_alert_kb(unsigned long long bytes) {
+        const unsigned long long kb = bytes >> 10;
+        return kb > ALERT_COLUMN_MAX ? ALERT_COLUMN_MAX : static_cast<uint32_t>(kb);
+    }
+
+    /**
+     * 系统字段名
+     * @param field 字段
+     */
+    const char* evos_alert_system_field_name(AlertSystemField field) {
+        for (size_t i = 0; i < sizeof(ALERT_FIELDS) / sizeof(ALERT_FIELDS[0]); ++i) {
+            if (!ALERT_FIELDS[i].process && ALERT_FIELDS[i].index == field) {
+                return ALERT_FIELDS[i].name;
+            }
+        }
+        return "";
+    }
+
+    /**
+     * 从本次循环的数据源计算系统字段
+     * @param sources 数据源
+     * @param system [out] 字段值
+     */
+    void evos_alert_system_load(const TickSources& sources, double* system) {
+        for (size_t i = 0; i < ALERT_SYS_FIELD_COUNT; ++i) {
+            system[i] = 0.0;
+        }
+        if (sources.has(SOURCE_MEMORY_STATUS)) {
+            const MEMORYSTATUSEX& status = sources.memory_status;
+            const double total = static_cast<double>(status.ullTotalPhys);
+            const double used = static_cast<double>(status.ullTotalPhys - status.ullAvailPhys);
+            system[ALERT_SYS_MEM_USED_PCT] = total > 0 ? used * 100.0 / total : 0.0;
+            system[ALERT_SYS_MEM_USED] = used;
+            system[ALERT_SYS_MEM_AVAIL] = static_cast<double>(status.ullAvailPhys);
+            system[ALERT_SYS_MEM_TOTAL] = total;
+            if (status.ullTotalPageFile > 0) {
+                system[ALERT_SYS_SWAP_USED_PCT] =
+                    static_cast<double>(status.ullTotalPageFile - status.ullAvailPageFile) * 100.0 /
+                    static_cast<double>(status.ullTotalPageFile);
+            }
+        }
+        if (sources.has(SOURCE_PROCESS_TABLE)) {
+            system[ALERT_SYS_PROC_COUNT] = static_cast<double>(sources.processes.size());
+        }
+    }
+
+    /**
+     * 从本次循环的数据源转换
+     * @param sources 数据源
+     */
+    void AlertInputs::load(const TickSources& sources) {
+        rows = sources.has(SOURCE_PROCESS_TABLE) ? sources.processes.size() : 0;
+        for (size_t c = 0; c < ALERT_COLUMN_COUNT; ++c) {
+            columns[c].resize(rows);
+        }
+        names.resize(rows);
+        uint32_t* rss = columns[ALERT_COLUMN_RSS].data();
+        uint32_t* pagefile = columns[ALERT_COLUMN_PAGEFILE].data();
+        uint32_t* pid = columns[ALERT_COLUMN_PID].data();
+        for (size_t i = 0; i < rows; ++i) {
+            const ProcessSample& sample = sources.processes[i];
+            rss[i] = evos_alert_kb(sample.working_set);
+            pagefile[i] = evos_alert_kb(sample.pagefile);
+            pid[i] = static_cast<uint32_t>(sample.pid);
+            names[i] = sample.name;
+        }
+
+        evos_alert_system_load(sources, system);
+        summarize();
+    }
+
+    /**
+     * 计算每组的最小值和最大值
+     */
+    void AlertInputs::summarize() {
+        const size_t words = (rows + 63) / 64;
+        for (size_t c = 0; c < ALERT_COLUMN_COUNT; ++c) {
+            minimum[c].resize(words);
+            maximum[c].resize(words);
+            const uint32_t* values = columns[c].data();
+            for (size_t w = 0; w < words; ++w) {
+                // 完整的组固定64次循环，便于编译器向量化
+                const uint32_t* block = values + w * 64;
+                const size_t count = rows - w * 64 < 64 ? rows - w * 64 : 64;
+                uint32_t low = block[0];
+                uint32_t high = block[0];
+                if (count == 64) {
+                    for (size_t i = 0; i < 64; ++i) {
+                        low = block[i] < low ? block[i] : low;
+                        high = block[i] > high ? block[i] : high;
+                    }
+                } else {
+                    for (size_t i = 1; i < count; ++i) {
+                        low = block[i] < low ? block[i] : low;
+                        high = block[i] > high ? block[i] : high;
+                    }
+                }
+                minimum[c][w] = low;
+                maximum[c][w] = high;
+            }
+
+            lowest[c] = ALERT_COLUMN_MAX;
+            highest[c] = 0;
+            for (size_t w = 0; w < words; ++w) {
+                lowest[c] = minimum[c][w] < lowest[c] ? minimum[c][w] : lowest[c];
+                highest[c] = maximum[c][w] > highest[c] ? maximum[c][w] : highest[c];
+            }
+        }
+    }
+
+    /**
+     * 单条规则的语法分析和编译（递归下降）
+     *     expr    := and ('||' and)*
+     *     and     := unary ('&&' unary)*
+     *     unary   := '!' unary | '(' expr ')' | field op value
+     */
+    class AlertRuleSet::Parser {
+    public:
+        Parser(utils::StringView line, size_t start, Rule& rule) :
+            line(line), pos(start), rule(rule), message(nullptr), errorPos(0) {}
+
+        /**
+         * 编译表达式和可选的持续时间
+         * @return 成功返回true，失败时message和errorPos为错误信息和位置
+         */
+        bool run();
+
+        const char* error() const { return message; }
+        size_t errorColumn() const { return errorPos + 1; }
+
+        /**
+         * 从根节点可达的节点树的深度，同时记录是否含有进程字段
+         */
+        uint32_t depth(uint32_t index, bool& process) const;
+
+    private:
+        bool expression(uint32_t& out);
+        bool conjunction(uint32_t& out);
+        bool unary(uint32_t& out);
+        bool comparison(uint32_t& out);
+        bool number(double& value);
+        bool duration(unsigned long long& value);
+
+        void skip();
+        bool peek(const char* token) const;
+        bool fail(const char* text, size_t at) {
+            message = text;
+            errorPos = at;
+            return false;
+        }
+
+        uint32_t add(const Node& node);
+        uint32_t constant(bool value);
+        uint32_t combine(AlertNodeKind kind, uint32_t left, uint32_t right);
+        uint32_t negate(uint32_t child);
+        uint32_t range(uint8_t column, AlertOperator op, double value, double unit);
+        unsigned int cost(uint32_t index) const;
+
+        utils::StringView line;
+        size_t pos;
+        Rule& rule;
+        const char* message;
+        size_t errorPos;
+    };
+
+    void AlertRuleSet::Parser::skip() {
+        while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t')) {
+            ++pos;
+        }
+    }
+
+    bool AlertRuleSet::Parser::peek(const char* token) const {
+        const utils::StringView text(token);
+        return line.size() - pos >= text.size() && line.substr(pos, text.size()) == text;
+    }
+
+    uint32_t AlertRuleSet::Parser::add(const Node& node) {
+        rule.nodes.push_back(node);
+        return static_cast<uint32_t>(rule.nodes.size() - 1);
+    }
+
+    uint32_t AlertRuleSet::Parser::constant(bool value) {
+        Node node = Node();
+        node.kind = NODE_CONST;
+        node.low = value ? 1 : 0;
+        return add(node);
+    }
+
+    /**
+     * 节点的执行代价（常量 < 系统字段 < 数值列 < 进程名），用于交换&&和||的操作数
+     */
+    unsigned int AlertRuleSet::Parser::cost(uint32_t index) const {
+        const Node& node = rule.nodes[index];
+        switch (node.kind) {
+            case NODE_CONST:
+                return 0;
+            case NODE_SYSTEM:
+                return 1;
+            case NODE_RANGE:
+                return 4;
+            case NODE_NAME:
+                return 64;
+            case NODE_NOT:
+                return cost(node.left) + 1;
+            default:
+                return cost(node.left) + cost(node.right);
+        }
+    }
+
+    /**
+     * 创建&&或||节点（折叠常量操作数，代价低的操作数放在左侧先执行）
+     */
+    uint32_t AlertRuleSet::Parser::combine(AlertNodeKind kind, uint32_t left, uint32_t right) {
+        const bool absorbing = kind == NODE_OR;   ///< 使结果确定的常量值
+        for (int side = 0; side < 2; ++side) {
+            const uint32_t operand = side == 0 ? left : right;
+            const uint32_t other = side == 0 ? right : left;
+            if (rule.nodes[operand].kind == NODE_CONST) {
+                return (rule.nodes[operand].low != 0) == absorbing ? operand : other;
+            }
+        }
+
+        Node node = Node();
+        node.kind = static_cast<uint8_t>(kind);
+        node.left = left;
+        node.right = right;
+        if (cost(right) < cost(left)) {
+            node.left = right;
+            node.right = left;
+        }
+        return add(node);
+    }
+
+    uint32_t AlertRuleSet::Parser::negate(uint32_t child) {
+        const Node& operand = rule.nodes[child];
+        if (operand.kind == NODE_CONST) {
+            return constant(operand.low == 0);
+        }
+        if (operand.kind == NODE_RANGE || operand.kind == NODE_NAME) {
+            Node node = operand;
+            node.negate = !node.negate;
+            return add(node);
+        }
+        Node node = Node();
+        node.kind = NODE_NOT;
+        node.left = child;
+        return add(node);
+    }
+
+    /**
+     * 数值列比较转换为列单位上的闭区间
+     * 列按unit取整保存（字节列为KB），比较按列值乘以unit进行：
+     * > v 为 [floor(v/unit)+1, max]，>= v 为 [ceil(v/unit), max]，< v 为 [0, ceil(v/unit)-1]，
+     * <= v 为 [0, floor(v/unit)]，== v 为 [ceil(v/unit), floor(v/unit)]，!= 为==取反；
+     * 空区间和完整区间折叠为常量
+     */
+    uint32_t AlertRuleSet::Parser::range(uint8_t column, AlertOperator op, double value, double unit) {
+        const double scaled = value / unit;
+        double low = 0.0;
+        double high = static_cast<double>(ALERT_COLUMN_MAX);
+        switch (op) {
+            case OP_GT:
+                low = std::floor(scaled) + 1.0;
+                break;
+            case OP_GE:
+                low = std::ceil(scaled);
+                break;
+            case OP_LT:
+                high = std::ceil(scaled) - 1.0;
+                break;
+            case OP_LE:
+                high = std::floor(scaled);
+                break;
+            default:
+                low = std::ceil(scaled);
+                high = std::floor(scaled);
+                break;
+        }
+        if (low < 0.0) {
+            low = 0.0;
+        }
+        if (high > static_cast<double>(ALERT_COLUMN_MAX)) {
+            high = static_cast<double>(ALERT_COLUMN_MAX);
+        }
+
+        const bool inverted = op == OP_NE;
+        if (low > high) {
+            return constant(inverted);
+        }
+        if (low == 0.0 && high == static_cast<double>(ALERT_COLUMN_MAX)) {
+            return constant(!inverted);
+        }
+
+        Node node = Node();
+        node.kind = NODE_RANGE;
+        node.field = column;
+        node.negate = inverted;
+        node.low = static_cast<uint32_t>(low);
+        node.span = static_cast<uint32_t>(high) - node.low;
+        return add(node);
+    }
+
+    bool AlertRuleSet::Parser::run() {
+        if (!expression(rule.root)) {
+            return false;
+        }
+        skip();
+        rule.duration_ms = 0;
+        if (peek("for") && pos + 3 < line.size() && (line[pos + 3] == ' ' || line[pos + 3] == '\t')) {
+            pos += 3;
+            skip();
+            if (!duration(rule.duration_ms)) {
+                return false;
+            }
+            skip();
+        }
+        if (pos < line.size()) {
+            return fail("unexpected text", pos);
+        }
+        return true;
+    }
+
+    bool AlertRuleSet::Parser::expression(uint32_t& out) {
+        if (!conjunction(out)) {
+            return false;
+        }
+        for (;;) {
+            skip();
+            if (!peek("||")) {
+                return true;
+            }
+            pos += 2;
+            uint32_t right;
+            if (!conjunction(right)) {
+                return false;
+            }
+            out = combine(NODE_OR, out, right);
+        }
+    }
+
+    bool AlertRuleSet::Parser::conjunction(uint32_t& out) {
+        if (!unary(out)) {
+            return false;
+        }
+        for (;;) {
+            skip();
+            if (!peek("&&")) {
+                return true;
+            }
+            pos += 2;
+            uint32_t right;
+            if (!unary(right)) {
+                return false;
+            }
+            out = combine(NODE_AND, out, right);
+        }
+    }
+
+    bool AlertRuleSet::Parser::unary(uint32_t& out) {
+        skip();
+        if (peek("!") && !peek("!=") && !peek("!~")) {
+            ++pos;
+            uint32_t child;
+            if (!unary(child)) {
+                return false;
+            }
+            out = negate(child);
+            return true;
+        }
+        if (peek("(")) {
+            const size_t open = pos++;
+            if (!expression(out)) {
+                return false;
+            }
+            skip();
+            if (!peek(")")) {
+                return fail(pos < line.size() ? "expected ')'" : "unbalanced '('", pos < line.size() ? pos : open);
+            }
+            ++pos;
+            return true;
+        }
+        return comparison(out);
+    }
+
+    /**
+     * 数值，可以带K/M/G/T后缀（1024进制，后面可以再跟B）
+     * 乘以后缀后不是有限值的数值（如1e308T）报错，range()中的整数转换只处理有限值
+     */
+    bool AlertRuleSet::Parser::number(double& value) {
+        const size_t start = pos;
+        const size_t consumed = utils::StringUtils::parseNumber(line.substr(pos), value);
+        if (consumed == 0 || !std::isfinite(value)) {
+            return fail("expected number", pos);
+        }
+        pos += consumed;
+        if (pos < line.size()) {
+            static const char SUFFIXES[] = "KMGT";
+            for (size_t i = 0; SUFFIXES[i] != '\0'; ++i) {
+                if (line[pos] == SUFFIXES[i] || line[pos] == SUFFIXES[i] - 'A' + 'a') {
+                    value *= static_cast<double>(1ULL << (10 * (i + 1)));
+                    ++pos;
+                    if (pos < line.size() && (line[pos] == 'B' || line[pos] == 'b')) {
+                        ++pos;
+                    }
+                    break;
+                }
+            }
+        }
+        if (!std::isfinite(value)) {
+            return fail("number out of range", start);
+        }
+        return true;
+    }
+
+    /**
+     * 持续时间（ms、s、m、h，默认s）
+     * 换算为毫秒后超出unsigned long long的持续时间（如1e30h）报错
+     */
+    bool AlertRuleSet::Parser::duration(unsigned long long& value) {
+        const size_t start = pos;
+        double amount = 0.0;
+        const size_t consumed = utils::StringUtils::parseNumber(line.substr(pos), amount);
+        if (consumed == 0 || !std::isfinite(amount) || amount < 0.0) {
+            return fail("expected duration", pos);
+        }
+        pos += consumed;
+        double scale = 1000.0;
+        if (peek("ms")) {
+            scale = 1.0;
+            pos += 2;
+        } else if (peek("s")) {
+            ++pos;
+        } else if (peek("m")) {
+            scale = 60.0 * 1000.0;
+            ++pos;
+        } else if (peek("h")) {
+            scale = 3600.0 * 1000.0;
+            ++pos;
+        }
+        const double milliseconds = amount * scale;
+        if (!(milliseconds < std::ldexp(1.0, 64))) {
+            return fail("duration out of range", start);
+        }
+        value = static_cast<unsigned long long>(milliseconds);
+        return true;
+    }
+
+    bool AlertRuleSet::Parser::comparison(uint32_t& out) {
+        skip();
+        const size_t start = pos;
+        while (pos < line.size() && evos_alert_name_char(line[pos])) {
+            ++pos;
+        }
+        if (pos == start) {
+            return fail("expected field", start);
+        }
+        const utils::StringView name = line.substr(start, pos - start);
+        const AlertFieldInfo* field = nullptr;
+        for (size_t i = 0; i < sizeof(ALERT_FIELDS) / sizeof(ALERT_FIELDS[0]); ++i) {
+            if (name == utils::StringView(ALERT_FIELDS[i].name)) {
+                field = &ALERT_FIELDS[i];
+                break;
+            }
+        }
+        if (field == nullptr) {
+            return fail("unknown field", start);
+        }
+
+        skip();
+        const size_t opStart = pos;
+        AlertOperator op = OP_EQ;
+        bool found = false;
+        for (size_t i = 0; i < sizeof(ALERT_OPERATORS) / sizeof(ALERT_OPERATORS[0]) && !found; ++i) {
+            if (peek(ALERT_OPERATORS[i].text)) {
+                op = ALERT_OPERATORS[i].op;
+                pos += utils::StringView(ALERT_OPERATORS[i].text).size();
+                found = true;
+            }
+        }
+        if (!found) {
+            return fail("expected comparison operator", opStart);
+        }
+        if (field->text ? (op != OP_EQ && op != OP_NE && op != OP_MATCH && op != OP_NOT_MATCH)
+                        : (op == OP_MATCH || op == OP_NOT_MATCH)) {
+            return fail(field->text ? "proc.name supports ==, !=, ~ and !~" : "'~' requires proc.name", opStart);
+        }
+
+        skip();
+        if (field->text) {
+            if (!peek("\"")) {
+                return fail("expected string", pos);
+            }
+            const size_t close = line.find('"', pos + 1);
+            if (close == utils::StringView::npos) {
+                return fail("unterminated string", pos);
+            }
+            std::string pattern = line.substr(pos + 1, close - pos - 1).toString();
+            pos = close + 1;
+            // 不含通配符的~模式按子串匹配
+            if ((op == OP_MATCH || op == OP_NOT_MATCH) && pattern.find_first_of("*?") == std::string::npos) {
+                pattern = "*" + pattern + "*";
+            }
+            rule.patterns.push_back(pattern);
+
+            Node node = Node();
+            node.kind = NODE_NAME;
+            node.negate = op == OP_NE || op == OP_NOT_MATCH;
+            node.left = static_cast<uint32_t>(rule.patterns.size() - 1);
+            out = add(node);
+            return true;
+        }
+
+        double value = 0.0;
+        if (peek("\"")) {
+            return fail("expected number", pos);
+        }
+        if (!number(value)) {
+            return false;
+        }
+        if (field->process) {
+            out = range(field->index, op, value, field->unit);
+            return true;
+        }
+
+        Node node = Node();
+        node.kind = NODE_SYSTEM;
+        node.field = field->index;
+        node.op = static_cast<uint8_t>(op);
+        node.value = value;
+        out = add(node);
+        return true;
+    }
+
+    /**
+     * 读取规则文件
+     * @param path 文件路径
+     * @return 全部编译成功返回true
+     */
+    bool AlertRuleSet::load(const std::string& path) {
+        FILE* file = fopen(path.c_str(), "rb");
+        if (file == nullptr) {
+            EVAN_PRINT("Error: Unable to open rules file: {}\n", path);
+            return false;
+        }
+        std::string content;
+        char buffer[4096];
+        size_t read;
+        while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            content.append(buffer, read);
+        }
+        fclose(file);
+        return parse(content, path);
+    }
+
+    /**
+     * 编译规则文本
+     * @param text 规则文本
+     * @param origin 来源名称
+     * @return 全部编译成功返回true
+     */
+    bool AlertRuleSet::parse(utils::StringView text, const std::string& origin) {
+        utils::StringUtils::SplitIterator lines(text, '\n');
+        utils::StringView line;
+        size_t number = 0;
+        bool ok = true;
+        while (lines.next(line)) {
+            ++number;
+            if (!line.empty() && line[line.size() - 1] == '\r') {
+                line = line.substr(0, line.size() - 1);
+            }
+            const utils::StringView trimmed = utils::StringUtils::trimView(line);
+            if (trimmed.empty() || trimmed[0] == '#') {
+                continue;
+            }
+
+            Rule rule;
+            rule.root = 0;
+            rule.depth = 0;
+            rule.duration_ms = 0;
+            rule.per_process = false;
+            rule.matching = false;
+            rule.firing = false;
+            rule.since = 0;
+
+            // 可选的"名称:"前缀
+            size_t start = 0;
+            while (start < line.size() && (line[start] == ' ' || line[start] == '\t')) {
+                ++start;
+            }
+            size_t end = start;
+            while (end < line.size() && (evos_alert_name_char(line[end]) || line[end] == '-')) {
+                ++end;
+            }
+            size_t colon = end;
+            while (colon < line.size() && (line[colon] == ' ' || line[colon] == '\t')) {
+                ++colon;
+            }
+            if (end > start && colon < line.size() && line[colon] == ':') {
+                rule.name = line.substr(start, end - start).toString();
+                start = colon + 1;
+            } else {
+                rule.name = EVAN_FORMAT_STRING("rule{}", rules.size() + 1);
+            }
+
+            Parser parser(line, start, rule);
+            if (!parser.run()) {
+                EVAN_PRINT("Error: {}:{}:{}: {}\n", origin, number, parser.errorColumn(), parser.error());
+                ok = false;
+                continue;
+            }
+            rule.text = utils::StringUtils::trimView(line.substr(start)).toString();
+            rule.depth = parser.depth(rule.root, rule.per_process);
+            rules.push_back(rule);
+        }
+        return ok;
+    }
+
+    uint32_t AlertRuleSet::Parser::depth(uint32_t index, bool& process) const {
+        const Node& node = rule.nodes[index];
+        switch (node.kind) {
+            case NODE_RANGE:
+            case NODE_NAME:
+                process = true;
+                return 1;
+            case NODE_NOT:
+                return depth(node.left, process) + 1;
+            case NODE_AND:
+            case NODE_OR: {
+                const uint32_t left = depth(node.left, process);
+                const uint32_t right = depth(node.right, process);
+                return (left > right ? left : right) + 1;
+            }
+            default:
+                return 1;
+        }
+    }
+
+    /**
+     * 系统字段比较
+     */
+    static bool evos_alert_compare(double value, uint8_t op, double constant) {
+        switch (op) {
+            case OP_GT: return value > constant;
+            case OP_GE: return value >= constant;
+            case OP_LT: return value < constant;
+            case OP_LE: return value <= constant;
+            case OP_EQ: return value == constant;
+            default: return value != constant;
+        }
+    }
+
+    /**
+     * 在候选位图上求值一个节点
+     * candidates至少有一位为1；out可以与candidates是同一数组；scratch为每层两个位图的临时空间
+     * @param rule 规则
+     * @param index 节点下标
+     * @param inputs 输入
+     * @param words 位图的字数
+     * @param candidates 候选行
+     * @param out [out] 候选行中满足条件的行
+     * @param scratch 临时位图
+     * @return out中有任意一位为1返回true（&&和||据此跳过另一侧）
+     */
+    bool AlertRuleSet::evalNode(const Rule& rule, uint32_t index, const AlertInputs& inputs, size_t words,
+                                const uint64_t* candidates, uint64_t* out, uint64_t* scratch) const {
+        const Node& node = rule.nodes[index];
+        uint64_t any = 0;
+        switch (node.kind) {
+            case NODE_CONST:
+            case NODE_SYSTEM: {
+                const bool value = node.kind == NODE_CONST ? node.low != 0
+                                                           : evos_alert_compare(inputs.system[node.field], node.op, node.value);
+                for (size_t w = 0; w < words; ++w) {
+                    out[w] = value ? candidates[w] : 0;
+                }
+                return value;
+            }
+            case NODE_RANGE: {
+                // 包含整组的直接取候选行，不相交的整组为0，只扫描部分相交的组
+                const uint32_t high = node.low + node.span;
+                const uint32_t* lows = inputs.minimum[node.field].data();
+                const uint32_t* highs = inputs.maximum[node.field].data();
+                if (inputs.highest[node.field] < node.low || inputs.lowest[node.field] > high) {
+                    // 与整列不相交（如proc.rss > 8G而没有这么大的进程）
+                    for (size_t w = 0; w < words; ++w) {
+                        out[w] = node.negate ? candidates[w] : 0;
+                    }
+                    return node.negate;
+                }
+                uint64_t* pending = scratch;
+                uint64_t* matched = scratch + words;
+                uint64_t partial = 0;
+                for (size_t w = 0; w < words; ++w) {
+                    // 按位运算而不是分支，便于编译器向量化
+                    const uint64_t overlap = 0 - static_cast<uint64_t>((highs[w] >= node.low) & (lows[w] <= high));
+                    const uint64_t inside = 0 - static_cast<uint64_t>((lows[w] >= node.low) & (highs[w] <= high));
+                    pending[w] = candidates[w] & overlap & ~inside;
+                    matched[w] = candidates[w] & inside;
+                    partial |= pending[w];
+                }
+                if (partial != 0) {
+                    utils::SimdScan::rangeMask(inputs.columns[node.field].data(), inputs.rows, node.low, node.span,
+                                               pending, pending);
+                }
+                for (size_t w = 0; w < words; ++w) {
+                    const uint64_t in = matched[w] | pending[w];
+                    out[w] = node.negate ? candidates[w] & ~in : in;
+                    any |= out[w];
+                }
+                return any != 0;
+            }
+            case NODE_NAME: {
+                const utils::StringView pattern(rule.patterns[node.left]);
+                for (size_t w = 0; w < words; ++w) {
+                    uint64_t matched = 0;
+                    for (uint64_t bits = candidates[w]; bits != 0; bits &= bits - 1) {
+                        const unsigned int j = evos_alert_lowest_bit(bits);
+                        if (utils::StringUtils::wildcardMatch(inputs.names[w * 64 + j], pattern, true) != node.negate) {
+                            matched |= 1ULL << j;
+                        }
+                    }
+                    out[w] = matched;
+                    any |= matched;
+                }
+                return any != 0;
+            }
+            case NODE_AND:
+                return evalNode(rule, node.left, inputs, words, candidates, out, scratch) &&
+                       evalNode(rule, node.right, inputs, words, out, out, scratch);
+            case NODE_OR: {
+                // 右侧只处理左侧为假的候选行
+                uint64_t* matched = scratch;
+                uint64_t* rest = scratch + words;
+                evalNode(rule, node.left, inputs, words, candidates, matched, scratch + 2 * words);
+                uint64_t remaining = 0;
+                for (size_t w = 0; w < words; ++w) {
+                    rest[w] = candidates[w] & ~matched[w];
+                    remaining |= rest[w];
+                }
+                if (remaining != 0) {
+                    evalNode(rule, node.right, inputs, words, rest, rest, scratch + 2 * words);
+                }
+                for (size_t w = 0; w < words; ++w) {
+                    out[w] = matched[w] | rest[w];
+                    any |= out[w];
+                }
+                return any != 0;
+            }
+            default: {
+                uint64_t* inner = scratch;
+                evalNode(rule, node.left, inputs, words, candidates, inner, scratch + 2 * words);
+                for (size_t w = 0; w < words; ++w) {
+                    out[w] = candidates[w] & ~inner[w];
+                    any |= out[w];
+                }
+                return any != 0;
+            }
+        }
+    }
+
+    /**
+     * 根据本次结果更新规则状态并生成事件
+     * @param rule 规则
+     * @param index 规则下标
+     * @param inputs 输入
+     * @param mask 满足条件的行（系统规则只有第0位）
+     * @param now_ms 当前时间
+     * @param events [out] 事件
+     */
+    void AlertRuleSet::track(Rule& rule, size_t index, const AlertInputs& inputs, const uint64_t* mask,
+                             unsigned long long now_ms, std::vector<AlertEvent>& events) {
+        AlertEvent event;
+        event.rule = index;
+        event.pid = 0;
+        if (!rule.per_process) {
+            if ((mask[0] & 1) == 0) {
+                rule.matching = false;
+                if (rule.firing) {
+                    rule.firing = false;
+                    event.firing = false;
+                    events.push_back(event);
+                }
+                return;
+            }
+            if (!rule.matching) {
+                rule.matching = true;
+                rule.since = now_ms;
+            }
+            if (!rule.firing && now_ms - rule.since >= rule.duration_ms) {
+                rule.firing = true;
+                event.firing = true;
+                events.push_back(event);
+            }
+            return;
+        }
+
+        const size_t words = (inputs.rows + 63) / 64;
+        const uint32_t* pids = inputs.columns[ALERT_COLUMN_PID].data();
+        for (size_t w = 0; w < words; ++w) {
+            for (uint64_t bits = mask[w]; bits != 0; bits &= bits - 1) {
+                const size_t row = w * 64 + evos_alert_lowest_bit(bits);
+                ProcessState& state = rule.processes[pids[row]];
+                if (state.tick == 0) {
+                    state.since = now_ms;
+                }
+                state.tick = generation;
+                if (!state.firing && now_ms - state.since >= rule.duration_ms) {
+                    state.firing = true;
+                    state.process = inputs.names[row].toString();
+                    event.firing = true;
+                    event.pid = pids[row];
+                    event.process = state.process;
+                    events.push_back(event);
+                }
+            }
+        }
+
+        // 本次不再满足条件（或已经退出）的进程
+        for (std::unordered_map<unsigned long, ProcessState>::iterator it = rule.processes.begin();
+             it != rule.processes.end();) {
+            if (it->second.tick == generation) {
+                ++it;
+                continue;
+            }
+            if (it->second.firing) {
+                event.firing = false;
+                event.pid = it->first;
+                event.process = it->second.process;
+                events.push_back(event);
+            }
+            it = rule.processes.erase(it);
+        }
+    }
+
+    /**
+     * 求值所有规则
+     * @param inputs 输入
+     * @param now_ms 当前时间（毫秒）
+     * @param events [out] 状态变化
+     */
+    void AlertRuleSet::evaluate(const AlertInputs& inputs, unsigned long long now_ms, std::vector<AlertEvent>& events) {
+        ++generation;
+        for (size_t r = 0; r < rules.size(); ++r) {
+            Rule& rule = rules[r];
+            const size_t rows = rule.per_process ? inputs.rows : 1;
+            const size_t words = (rows + 63) / 64;
+            candidates.assign(words, ~0ULL);
+            if (rows % 64 != 0) {
+                candidates[words - 1] = (1ULL << (rows % 64)) - 1;
+            }
+            result.resize(words);
+            if (scratch.size() < words * 2 * rule.depth) {
+                scratch.resize(words * 2 * rule.depth);
+            }
+            const bool any = words != 0 &&
+                             evalNode(rule, rule.root, inputs, words, candidates.data(), result.data(), scratch.data());
+            if (any || rule.firing || rule.matching || !rule.processes.empty()) {
+                track(rule, r, inputs, result.data(), now_ms, events);
+            }
+        }
+    }
+
+    /**
+     * 正在告警的数量
+     */
+    size_t AlertRuleSet::firing() const {
+        size_t count = 0;
+        for (size_t r = 0; r < rules.size(); ++r) {
+            if (!rules[r].per_process) {
+                count += rules[r].firing ? 1 : 0;
+                continue;
+            }
+            for (std::unordered_map<unsigned long, ProcessState>::const_iterator it = rules[r].processes.begin();
+                 it != rules[r].processes.end(); ++it) {
+                count += it->second.firing ? 1 : 0;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * 生成告警事件的JSON行
+     * @param rules 规则集
+     * @param event 事件
+     * @return JSON行
+     */
+    std::string evos_alert_event_json(const AlertRuleSet& rules, const AlertEvent& event) {
+        char time[32];
+        const std::time_t now = std::time(nullptr);
+        const std::tm* local = std::localtime(&now);
+        if (local == nullptr || std::strftime(time, sizeof(time), "%Y-%m-%dT%H:%M:%S", local) == 0) {
+            time[0] = '\0';
+        }
+
+        std::string line;
+        utils::StringSink sink(line);
+        EVAN_FORMAT(sink, "{{\"time\":\"{}\",\"rule\":", time);
+        evos_json_string_write(sink, rules.name(event.rule));
+        EVAN_FORMAT(sink, ",\"state\":\"{}\",\"expr\":", event.firing ? "firing" : "resolved");
+        evos_json_string_write(sink, rules.text(event.rule));
+        if (event.pid != 0 || !event.process.empty()) {
+            EVAN_FORMAT(sink, ",\"pid\":{},\"process\":", event.pid);
+            evos_json_string_write(sink, event.process);
+        }
+        sink.write("}", 1);
+        return line;
+    }
+
+    namespace {
+    /**
+     * 告警采集器
+     */
+    class AlertsCollector : public Collector {
+    public:
+        AlertsCollector(AlertRuleSet* rules, const std::shared_ptr<AlertSink>& sink)
+            : rules(rules), sink(sink ? sink : evos_alert_sink_create(std::string())) {}
+
+        const char* name() const override { return "alerts"; }
+        DataSourceMask sources() const override { return SOURCE_MEMORY_STATUS | SOURCE_PROCESS_TABLE; }
+
+        void display(const TickSources& sources, const Configuration&) override {
+            if (rules == nullptr || rules->size() == 0) {
+                EVAN_PRINT("\n[Alerts]\n\tNo rules, use --rules <file>.\n");
+                return;
+            }
+
+            inputs.load(sources);
+            events.clear();
+            const unsigned long long now = static_cast<unsigned long long>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+            rules->evaluate(inputs, now, events);
+
+            EVAN_PRINT("\n[Alerts]\n\tRules: {}, Firing: {}\n", rules->size(), rules->firing());
+            for (size_t i = 0; i < events.size(); ++i) {
+                sink->send(evos_alert_event_json(*rules, events[i]));
+            }
+        }
+
+    private:
+        std::unique_ptr<AlertRuleSet> rules;
+        std::shared_ptr<AlertSink> sink;
+        AlertInputs inputs;                 ///< 跨循环复用各列的容量
+        std::vector<AlertEvent> events;
+    };
+    }
+
+    /**
+     * 创建告警采集器
+     * @param rules 规则集
+     * @param sink 告警输出
+     * @return 采集器
+     */
+    Collector* evos_alerts_collector_create(AlertRuleSet* rules, const std::shared_ptr<AlertSink>& sink) {
+        return new AlertsCollector(rules, sink);
+    }
+}
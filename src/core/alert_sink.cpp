@@ -0,0 +1,264 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "core/alert_sink.h"
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "utils/format.h"
+#include "utils/metrics.h"
+
+#include <winsock2.h>
+#include <afunix.h>
+#include <windows.h>
+
+namespace evan {
+    namespace {
+    /**
+     * 写入标准输出（并行执行时由StdoutCapture按采集器顺序输出）
+     */
+    class StdoutAlertSink : public AlertSink {
+    public:
+        void send(const std::string& line) override {
+            EVAN_PRINT("\t{}\n", line);
+        }
+    };
+
+    /**
+     * 追加到文件（每行之后刷新，便于tail -f等工具读取）
+     */
+    class FileAlertSink : public AlertSink {
+    public:
+        explicit FileAlertSink(FILE* file) : file(file) {}
+        ~FileAlertSink() override { fclose(file); }
+
+        void send(const std::string& line) override {
+            fwrite(line.data(), 1, line.size(), file);
+            fputc('\n', file);
+            fflush(file);
+        }
+
+    private:
+        FILE* file;
+    };
+
+    /**
+     * 在一个后台线程中启动命令，不阻塞采集循环
+     * 事件先放入有界队列，工作线程每次取出队列中的全部事件，启动一次命令并逐行写入它的标准输入
+     * （同一次循环的多个事件通常合并为一次命令）；队列已满时丢弃新事件并计入alerts.exec_dropped
+     */
+    class ExecAlertSink : public AlertSink {
+    public:
+        explicit ExecAlertSink(const std::string& command) : command(command), stopping(false) {
+            worker = std::thread(&ExecAlertSink::run, this);
+        }
+
+        /**
+         * 等待工作线程输出队列中剩余的事件后退出
+         */
+        ~ExecAlertSink() override {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            ready.notify_one();
+            worker.join();
+        }
+
+        void send(const std::string& line) override {
+            static utils::MetricCounter& dropped = utils::MetricsRegistry::instance().counter("alerts.exec_dropped");
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (pending.size() >= ALERT_EXEC_QUEUE_MAX) {
+                    dropped.add();
+                    return;
+                }
+                pending.push_back(line);
+            }
+            ready.notify_one();
+        }
+
+    private:
+        void run() {
+            std::vector<std::string> batch;
+            for (;;) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    ready.wait(lock, [this]() { return stopping || !pending.empty(); });
+                    if (pending.empty()) {
+                        return;  ///< 已停止且没有剩余事件
+                    }
+                    batch.swap(pending);
+                }
+
+                FILE* pipe = _popen(command.c_str(), "w");
+                if (pipe != nullptr) {
+                    for (size_t i = 0; i < batch.size(); ++i) {
+                        fwrite(batch[i].data(), 1, batch[i].size(), pipe);
+                        fputc('\n', pipe);
+                    }
+                    _pclose(pipe);
+                }
+                batch.clear();
+            }
+        }
+
+        std::string command;
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::vector<std::string> pending;   ///< 等待输出的事件（最多ALERT_EXEC_QUEUE_MAX个）
+        bool stopping;
+        std::thread worker;
+    };
+
+    /**
+     * Unix域套接字客户端（对端关闭后在下一个事件时重新连接，仍然失败则丢弃该事件）
+     */
+    class UnixAlertSink : public AlertSink {
+    public:
+        typedef SOCKET Handle;
+
+        explicit UnixAlertSink(const std::string& path) : path(path), connected(false), sock() {
+            WSADATA wsaData;
+            WSAStartup(MAKEWORD(2, 2), &wsaData);
+        }
+
+        ~UnixAlertSink() override {
+            disconnect();
+            WSACleanup();
+        }
+
+        void send(const std::string& line) override {
+            std::string payload = line;
+            payload += '\n';
+            for (int attempt = 0; attempt < 2; ++attempt) {
+                if (!connected && !connect()) {
+                    return;
+                }
+                if (sendAll(payload.data(), payload.size())) {
+                    return;
+                }
+                disconnect();
+            }
+        }
+
+    private:
+        bool connect() {
+            sockaddr_un address;
+            memset(&address, 0, sizeof(address));
+            address.sun_family = AF_UNIX;
+            if (path.size() >= sizeof(address.sun_path)) {
+                return false;
+            }
+            memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+            sock = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (sock == INVALID_SOCKET) {
+                return false;
+            }
+            if (::connect(sock, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+                close();
+                return false;
+            }
+            connected = true;
+            return true;
+        }
+
+        bool sendAll(const char* data, size_t length) {
+            while (length > 0) {
+                const int sent = ::send(sock, data, static_cast<int>(length), 0);
+                if (sent <= 0) {
+                    return false;
+                }
+                data += sent;
+                length -= static_cast<size_t>(sent);
+            }
+            return true;
+        }
+
+        void close() {
+            closesocket(sock);
+        }
+
+        void disconnect() {
+            if (connected) {
+                close();
+                connected = false;
+            }
+        }
+
+        std::string path;
+        bool connected;
+        Handle sock;
+    };
+
+    /**
+     * 共享的告警输出：以互斥锁串行化多个采集器线程对同一个输出的send()
+     */
+    class LockedAlertSink : public AlertSink {
+    public:
+        explicit LockedAlertSink(AlertSink* sink) : sink(sink) {}
+
+        void send(const std::string& line) override {
+            std::lock_guard<std::mutex> lock(mutex);
+            sink->send(line);
+        }
+
+    private:
+        std::unique_ptr<AlertSink> sink;
+        std::mutex mutex;
+    };
+
+    /**
+     * 按输出说明创建输出
+     * @param spec 输出说明
+     * @return 输出对象，失败返回nullptr
+     */
+    AlertSink* evos_alert_sink_open(const std::string& spec) {
+        if (spec.empty() || spec == "stdout") {
+            return new StdoutAlertSink();
+        }
+
+        const size_t colon = spec.find(':');
+        const std::string kind = colon == std::string::npos ? spec : spec.substr(0, colon);
+        const std::string target = colon == std::string::npos ? std::string() : spec.substr(colon + 1);
+        if (target.empty()) {
+            EVAN_PRINT("Error: Invalid alert sink: {} (expected stdout, file:<path>, exec:<command> or unix:<path>)\n", spec);
+            return nullptr;
+        }
+        if (kind == "file") {
+            FILE* file = fopen(target.c_str(), "a");
+            if (file == nullptr) {
+                EVAN_PRINT("Error: Unable to open alert file: {}\n", target);
+                return nullptr;
+            }
+            return new FileAlertSink(file);
+        }
+        if (kind == "exec") {
+            return new ExecAlertSink(target);
+        }
+        if (kind == "unix") {
+            return new UnixAlertSink(target);
+        }
+        EVAN_PRINT("Error: Invalid alert sink: {} (expected stdout, file:<path>, exec:<command> or unix:<path>)\n", spec);
+        return nullptr;
+    }
+    }
+
+    /**
+     * 创建告警输出
+     * @param spec 输出说明
+     * @return 输出对象，失败返回空指针
+     */
+    std::shared_ptr<AlertSink> evos_alert_sink_create(const std::string& spec) {
+        AlertSink* sink = evos_alert_sink_open(spec);
+        if (sink == nullptr) {
+            return std::shared_ptr<AlertSink>();
+        }
+        return std::make_shared<LockedAlertSink>(sink);
+    }
+}
@@ -0,0 +1,223 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "core/anomaly_detector.h"
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <memory>
+#include "core/alert_sink.h"
+#include "core/collector.h"
+#include "core/configuration.h"
+#include "core/process_query.h"
+#include "utils/format.h"
+
+namespace evan {
+    namespace {
+    const char* const ANOMALY_PROC_NAMES[ANOMALY_PROC_METRIC_COUNT] = {"proc.rss", "proc.pagefile"};
+
+    /**
+     * 系统字段的值是否为字节数
+     */
+    bool evos_anomaly_system_bytes(size_t field) {
+        return field == ALERT_SYS_MEM_USED || field == ALERT_SYS_MEM_AVAIL || field == ALERT_SYS_MEM_TOTAL;
+    }
+
+    /**
+     * 系统字段的数据源（未读取时evos_alert_system_load填0，不能作为样本）
+     */
+    DataSource evos_anomaly_system_source(AlertSystemField field) {
+        switch (field) {
+        case ALERT_SYS_PROC_COUNT:
+            return SOURCE_PROCESS_TABLE;
+        case ALERT_SYS_MEM_USED_PCT:
+        case ALERT_SYS_MEM_USED:
+        case ALERT_SYS_MEM_AVAIL:
+        case ALERT_SYS_MEM_TOTAL:
+        case ALERT_SYS_SWAP_USED_PCT:
+        case ALERT_SYS_FIELD_COUNT:
+            break;
+        }
+        return SOURCE_MEMORY_STATUS;
+    }
+    }
+
+    /**
+     * 对一个样本评分并加入统计量
+     * @param stats 字段的统计量
+     * @param value 样本值
+     * @param finding [out] 被标记时的评分
+     * @return 是否被标记
+     */
+    bool AnomalyDetector::score(utils::StreamingStats& stats, double value, AnomalyFinding& finding) {
+        bool flagged = false;
+        if (stats.ready()) {
+            const double robust = stats.robustZ(value);
+            if (std::fabs(robust) >= threshold) {
+                finding.value = value;
+                finding.median = stats.median();
+                finding.mad = stats.mad();
+                finding.z = stats.zScore(value);
+                finding.robust_z = robust;
+                flagged = true;
+            }
+        }
+        stats.add(value, alpha);
+        return flagged;
+    }
+
+    /**
+     * 处理本次循环的样本
+     * @param sources 数据源
+     * @param findings [out] 被标记的样本
+     */
+    void AnomalyDetector::observe(const TickSources& sources, std::vector<AnomalyFinding>& findings) {
+        ++generation;
+
+        evos_alert_system_load(sources, values);
+        for (size_t i = 0; i < ANOMALY_SYS_METRIC_COUNT; ++i) {
+            const AlertSystemField field = ANOMALY_SYS_METRICS[i];
+            // 数据源读取失败的字段是填充的0，加入统计量会污染基线
+            if (!sources.has(evos_anomaly_system_source(field))) {
+                continue;
+            }
+            AnomalyFinding finding;
+            if (score(system[field], values[field], finding)) {
+                finding.metric = evos_alert_system_field_name(field);
+                finding.bytes = evos_anomaly_system_bytes(field);
+                finding.pid = 0;
+                findings.push_back(finding);
+            }
+        }
+
+        if (top == 0 || !sources.has(SOURCE_PROCESS_TABLE)) {
+            return;
+        }
+
+        // 按工作集选出前N个进程（只部分排序）
+        const ProcessList& list = sources.processes;
+        order.clear();
+        for (size_t i = 0; i < list.size(); ++i) {
+            if (list[i].accessible) {
+                order.push_back(i);
+            }
+        }
+        const size_t count = std::min(top, order.size());
+        if (count < order.size()) {
+            std::nth_element(order.begin(), order.begin() + count, order.end(), [&list](size_t a, size_t b) {
+                return list[a].working_set > list[b].working_set;
+            });
+        }
+
+        for (size_t k = 0; k < count; ++k) {
+            const ProcessSample& sample = list[order[k]];
+            ProcessStats& stats = processes[sample.pid];
+            stats.seen = generation;
+            const double metrics[ANOMALY_PROC_METRIC_COUNT] = {
+                static_cast<double>(sample.working_set), static_cast<double>(sample.pagefile)};
+            for (size_t m = 0; m < ANOMALY_PROC_METRIC_COUNT; ++m) {
+                AnomalyFinding finding;
+                if (score(stats.metrics[m], metrics[m], finding)) {
+                    finding.metric = ANOMALY_PROC_NAMES[m];
+                    finding.bytes = true;
+                    finding.pid = sample.pid;
+                    finding.process.assign(sample.name.data(), sample.name.size());
+                    findings.push_back(finding);
+                }
+            }
+        }
+
+        // 丢弃已退出或跌出前N名的进程，内存保持在N个进程以内
+        for (std::unordered_map<unsigned long, ProcessStats>::iterator it = processes.begin(); it != processes.end();) {
+            if (it->second.seen != generation) {
+                it = processes.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    /**
+     * 生成异常样本的JSON行
+     * @param finding 样本
+     * @return JSON行
+     */
+    std::string evos_anomaly_finding_json(const AnomalyFinding& finding) {
+        char time[32];
+        const std::time_t now = std::time(nullptr);
+        const std::tm* local = std::localtime(&now);
+        if (local == nullptr || std::strftime(time, sizeof(time), "%Y-%m-%dT%H:%M:%S", local) == 0) {
+            time[0] = '\0';
+        }
+
+        std::string line;
+        utils::StringSink sink(line);
+        EVAN_FORMAT(sink, "{{\"time\":\"{}\",\"rule\":\"anomaly\",\"state\":\"anomaly\",\"metric\":\"{}\"",
+                    time, finding.metric);
+        EVAN_FORMAT(sink, ",\"value\":{:.2f},\"median\":{:.2f},\"mad\":{:.2f},\"z\":{:.2f},\"robust_z\":{:.2f}",
+                    finding.value, finding.median, finding.mad, finding.z, finding.robust_z);
+        if (finding.pid != 0 || !finding.process.empty()) {
+            EVAN_FORMAT(sink, ",\"pid\":{},\"process\":", finding.pid);
+            evos_json_string_write(sink, finding.process);
+        }
+        sink.write("}", 1);
+        return line;
+    }
+
+    namespace {
+    /**
+     * 异常检测采集器
+     */
+    class AnomaliesCollector : public Collector {
+    public:
+        AnomaliesCollector(double threshold, size_t top, const std::shared_ptr<AlertSink>& sink)
+            : detector(threshold, top), sink(sink) {}
+
+        const char* name() const override { return "anomalies"; }
+        DataSourceMask sources() const override { return SOURCE_MEMORY_STATUS | SOURCE_PROCESS_TABLE; }
+
+        void display(const TickSources& sources, const Configuration& config) override {
+            findings.clear();
+            detector.observe(sources, findings);
+
+            EVAN_PRINT("\n[Anomalies]\n\tTracked: {} metrics, Threshold: {:.1f}, Flagged: {}\n",
+                       detector.tracked(), detector.limit(), findings.size());
+            if (findings.empty()) {
+                return;
+            }
+            EVAN_PRINT("\t{:<24} {:>8} {:>14} {:>14} {:>10} {:>10}\n", "Metric", "PID", "Value", "Median", "Robust Z", "Z");
+            for (size_t i = 0; i < findings.size(); ++i) {
+                const AnomalyFinding& finding = findings[i];
+                if (finding.bytes) {
+                    EVAN_PRINT("\t{:<24} {:>8} {:>14} {:>14} {:>10.2f} {:>10.2f}\n", finding.metric, finding.pid,
+                               config.config_byte_to_str(static_cast<unsigned long long>(finding.value)),
+                               config.config_byte_to_str(static_cast<unsigned long long>(finding.median)),
+                               finding.robust_z, finding.z);
+                } else {
+                    EVAN_PRINT("\t{:<24} {:>8} {:>14.2f} {:>14.2f} {:>10.2f} {:>10.2f}\n", finding.metric, finding.pid,
+                               finding.value, finding.median, finding.robust_z, finding.z);
+                }
+                if (sink != nullptr) {
+                    sink->send(evos_anomaly_finding_json(finding));
+                }
+            }
+        }
+
+    private:
+        AnomalyDetector detector;
+        std::shared_ptr<AlertSink> sink;
+        std::vector<AnomalyFinding> findings;
+    };
+    }
+
+    /**
+     * 创建异常检测采集器
+     * @param threshold 稳健z值的阈值
+     * @param top 跟踪的进程数
+     * @param sink 告警输出
+     * @return 采集器
+     */
+    Collector* evos_anomalies_collector_create(double threshold, size_t top, const std::shared_ptr<AlertSink>& sink) {
+        return new AnomaliesCollector(threshold, top, sink);
+    }
+}
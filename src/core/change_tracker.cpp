@@ -0,0 +1,167 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "core/change_tracker.h"
+#include <algorithm>
+#include <cmath>
+#include "utils/format.h"
+
+namespace evan {
+
+/**
+ * 构造函数
+ * @param thresholdPercent 变化阈值（相对百分比）
+ * @param keyframeInterval 关键帧间隔（循环次数）
+ */
+ChangeTracker::ChangeTracker(unsigned int thresholdPercent, unsigned int keyframeInterval) :
+    threshold(thresholdPercent / 100.0),
+    keyframe_interval(keyframeInterval),
+    tick(0),
+    keyframe(false),
+    header_written(false) {
+}
+
+/**
+ * 开始新的一次循环
+ * @param out 输出流
+ * @return 本次是否为关键帧
+ */
+bool ChangeTracker::beginTick(FILE* out) {
+    keyframe = tick == 0 || (keyframe_interval != 0 && tick % keyframe_interval == 0);
+    header_written = false;
+    if (keyframe) {
+        writeHeader(out);
+    }
+    return keyframe;
+}
+
+/**
+ * 判断数值变化是否超过阈值
+ * 阈值相对于上一次的值，上一次为0时任何变化都算超过阈值
+ */
+bool ChangeTracker::exceedsThreshold(double previous, double current) const {
+    if (previous == current) {
+        return false;
+    }
+    return std::fabs(current - previous) > threshold * std::fabs(previous);
+}
+
+/**
+ * 记录字段
+ * @param key 字段键
+ * @param value 用于比较的数值
+ * @param text 用于显示的文本
+ */
+void ChangeTracker::field(utils::StringView key, double value, utils::StringView text) {
+    std::vector<FieldState>::iterator it = std::lower_bound(fields.begin(), fields.end(), key, FieldKeyLess());
+    if (it == fields.end() || utils::StringView(it->key) != key) {
+        FieldState state;
+        state.key = key.toString();
+        state.value = value;
+        state.text = text.toString();
+        state.dirty = true;
+        fields.insert(it, state);
+        return;
+    }
+
+    FieldState& state = *it;
+    if (keyframe || exceedsThreshold(state.value, value)) {
+        // 只有输出时才更新基准值，缓慢漂移的值累计超过阈值后也会被输出
+        // 交换后原地赋值，两个字符串的缓冲区都被复用
+        state.previous_text.swap(state.text);
+        state.text.assign(text.data(), text.size());
+        state.value = value;
+        state.dirty = true;
+    }
+}
+
+/**
+ * 记录进程行
+ * @param pid 进程ID
+ * @param value 用于比较的数值
+ * @param text 用于显示的整行文本
+ */
+void ChangeTracker::row(unsigned long pid, double value, utils::StringView text) {
+    std::unordered_map<unsigned long, RowState>::iterator it = rows.find(pid);
+    if (it == rows.end()) {
+        RowState state;
+        state.value = value;
+        state.text = text.toString();
+        state.tick = tick;
+        state.marker = '+';
+        rows.insert(std::make_pair(pid, state));
+        return;
+    }
+
+    RowState& state = it->second;
+    state.tick = tick;
+    if (keyframe || exceedsThreshold(state.value, value)) {
+        state.value = value;
+        state.text.assign(text.data(), text.size());
+        state.marker = '~';
+    }
+}
+
+/**
+ * 在第一次输出前写入本次循环的标题
+ */
+void ChangeTracker::writeHeader(FILE* out) {
+    if (!header_written) {
+        if (keyframe) {
+            EVAN_FPRINT(out, "[KEYFRAME {}]\n", tick);
+        } else {
+            EVAN_FPRINT(out, "[TICK {}]\n", tick);
+        }
+        header_written = true;
+    }
+}
+
+/**
+ * 结束本次循环，输出变化并清理已消失的进程行
+ * @param out 输出流
+ */
+void ChangeTracker::endTick(FILE* out) {
+    for (std::vector<FieldState>::iterator it = fields.begin(); it != fields.end(); ++it) {
+        FieldState& state = *it;
+        if (!state.dirty) {
+            continue;
+        }
+        writeHeader(out);
+        if (keyframe || state.previous_text.empty()) {
+            EVAN_FPRINT(out, "{}: {}\n", state.key, state.text);
+        } else {
+            EVAN_FPRINT(out, "{}: {} -> {}\n", state.key, state.previous_text, state.text);
+        }
+        state.dirty = false;
+    }
+
+    // 进程行按PID排序输出，保证多次运行的结果可以直接比较
+    row_order.clear();
+    for (std::unordered_map<unsigned long, RowState>::const_iterator it = rows.begin(); it != rows.end(); ++it) {
+        row_order.push_back(it->first);
+    }
+    std::sort(row_order.begin(), row_order.end());
+
+    for (size_t i = 0; i < row_order.size(); ++i) {
+        std::unordered_map<unsigned long, RowState>::iterator it = rows.find(row_order[i]);
+        RowState& state = it->second;
+
+        if (state.tick != tick) {
+            writeHeader(out);
+            EVAN_FPRINT(out, "- process {}: {}\n", it->first, state.text);
+            rows.erase(it);
+            continue;
+        }
+
+        if (state.marker != 0) {
+            writeHeader(out);
+            EVAN_FPRINT(out, "{} process {}: {}\n", keyframe ? '=' : state.marker, it->first, state.text);
+            state.marker = 0;
+        }
+    }
+
+    fflush(out);
+    ++tick;
+}
+
+} // namespace evan
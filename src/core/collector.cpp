@@ -0,0 +1,63 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "core/collector.h"
+
+namespace evan {
+    /**
+     * 构造函数
+     * @param arena 本次循环的Arena
+     */
+    TickSources::TickSources(utils::Arena& arena) :
+        loaded(0),
+        processes(utils::ArenaAllocator<ProcessSample>(arena)) {
+    }
+
+    CollectorRegistry::~CollectorRegistry() {
+        for (std::map<std::string, Collector*>::iterator it = collectors.begin(); it != collectors.end(); ++it) {
+            delete it->second;
+        }
+    }
+
+    /**
+     * 注册采集器
+     * @param collector 采集器
+     */
+    void CollectorRegistry::add(Collector* collector) {
+        Collector*& slot = collectors[collector->name()];
+        if (slot != collector) {
+            delete slot;
+            slot = collector;
+        }
+    }
+
+    /**
+     * 按名称查找采集器
+     * @param name 名称
+     * @return 采集器，不存在返回nullptr
+     */
+    Collector* CollectorRegistry::find(const std::string& name) const {
+        std::map<std::string, Collector*>::const_iterator it = collectors.find(name);
+        return it != collectors.end() ? it->second : nullptr;
+    }
+
+    /**
+     * 追加采集器，合并其依赖的数据源，并注册耗时直方图
+     * @param collector 采集器
+     */
+    void CollectorPlan::add(Collector* collector) {
+        steps.push_back(collector);
+        latencies.push_back(&utils::MetricsRegistry::instance().latency(std::string("collector.") + collector->name() + "_us"));
+        required |= collector->sources();
+    }
+
+    /**
+     * 读取本次循环需要的数据源
+     * @param out [out] 数据源
+     * @param arena 本次循环的Arena
+     * @return 全部读取成功返回true
+     */
+    bool CollectorPlan::load(TickSources& out, utils::Arena& arena) const {
+        return evos_tick_sources_load(required, out, arena);
+    }
+}
@@ -2,7 +2,6 @@
 // Licensed under the Apache License, Version 2.0
 
 #include "core/configuration.h"
-#include <cstdio>
 
 namespace evan {
     // 静态常量定义
@@ -56,17 +55,35 @@ namespace evan {
      * @return 转换后的字符串
      */
     std::string Configuration::config_byte_to_str(unsigned long long byte) const {
-        auto currentDivByte = divByte;
-        
-        if (currentDivByte.second == 0 || currentDivByte.second == 1) {
+        utils::StackBuffer<64> buffer;
+        writeBytes(byte, buffer);
+        return std::string(buffer.data(), buffer.size());
+    }
+    
+    /**
+     * 将字节数转换为可读字符串，结果保存在Arena中
+     * @param byte 字节数
+     * @param arena 本次循环的Arena
+     * @return 指向Arena中字符串的视图
+     */
+    utils::StringView Configuration::config_byte_to_str(unsigned long long byte, utils::Arena& arena) const {
+        utils::StackBuffer<64> buffer;
+        writeBytes(byte, buffer);
+        return arena.copy(buffer.view());
+    }
+    
+    /**
+     * 将字节数格式化到输出目标
+     * @param byte 字节数
+     * @param sink 输出目标
+     */
+    void Configuration::writeBytes(unsigned long long byte, utils::FormatSink& sink) const {
+        if (divByte.second == 0 || divByte.second == 1) {
             // 自动模式
-            return autoConvertBytes(byte);
+            autoConvertBytes(byte, sink);
         } else {
             // 固定单位模式
-            if (currentDivByte.second == 0) {
-                return std::to_string(byte);
-            }
-            return std::to_string(byte / currentDivByte.second) + currentDivByte.first;
+            EVAN_FORMAT(sink, "{}{}", byte / divByte.second, divByte.first);
         }
     }
     
@@ -80,31 +97,26 @@ namespace evan {
     /**
      * 自动转换字节数
      * @param byte 字节数
-     * @return 转换后的字符串
+     * @param sink 输出目标
      */
-    std::string Configuration::autoConvertBytes(unsigned long long byte) const {
-        char buffer[100] = {0};
+    void Configuration::autoConvertBytes(unsigned long long byte, utils::FormatSink& sink) const {
         const char *units[] = {"B", "KB", "MB", "GB", "TB", "PB"};
-        int unitIndex = 0;
+        const size_t unitCount = sizeof(units) / sizeof(units[0]);
+        size_t unitIndex = 0;
         unsigned long long size = byte;
         
         // 计算合适的单位
-        while (size >= 1024 && unitIndex < (sizeof(units) / sizeof(units[0]) - 1)) {
+        while (size >= 1024 && unitIndex < unitCount - 1) {
             size /= 1024;
             unitIndex++;
         }
         
         // 格式化输出
-        if (size >= 1024 && unitIndex < (sizeof(units) / sizeof(units[0]) - 1)) {
+        if (size >= 1024 && unitIndex < unitCount - 1) {
             // 超过MB时保留一位小数
-            sprintf(buffer, "%lu.%01lu %s", 
-                    static_cast<unsigned long>(size / 1024), 
-                    static_cast<unsigned long>((size % 1024) * 10 / 1024), 
-                    units[unitIndex + 1]);
+            EVAN_FORMAT(sink, "{}.{} {}", size / 1024, (size % 1024) * 10 / 1024, units[unitIndex + 1]);
         } else {
-            sprintf(buffer, "%lu %s", static_cast<unsigned long>(size), units[unitIndex]);
+            EVAN_FORMAT(sink, "{} {}", size, units[unitIndex]);
         }
-        
-        return std::string(buffer);
     }
 } // namespace evan
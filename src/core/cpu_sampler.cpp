@@ -0,0 +1,160 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "core/cpu_sampler.h"
+#include <windows.h>
+#include <cstring>
+
+namespace evan {
+
+namespace {
+    /**
+     * SystemProcessorPerformanceInformation信息类编号
+     */
+    const int SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION_CLASS = 8;
+
+    /**
+     * ntdll返回的每处理器性能信息（与SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION布局一致）
+     */
+    struct ProcessorPerformanceInfo {
+        LARGE_INTEGER idle_time;      // 空闲时间（100ns）
+        LARGE_INTEGER kernel_time;    // 内核时间（包含空闲时间）
+        LARGE_INTEGER user_time;      // 用户时间
+        LARGE_INTEGER dpc_time;       // DPC时间
+        LARGE_INTEGER interrupt_time; // 中断时间
+        ULONG interrupt_count;        // 中断次数
+    };
+}
+
+/**
+ * 构造函数
+ */
+CpuSampler::CpuSampler() :
+    ntQuerySystemInformation(nullptr),
+    ntQuerySystemInformationEx(nullptr),
+    core_count(0),
+    group_count(0),
+    is_initialized(false),
+    has_baseline(false) {
+}
+
+/**
+ * 析构函数
+ * ntdll始终驻留在进程中，无需释放
+ */
+CpuSampler::~CpuSampler() {
+}
+
+/**
+ * 初始化采样器
+ * @return 是否初始化成功
+ */
+bool CpuSampler::initialize() {
+    if (is_initialized) {
+        return true;
+    }
+
+    HMODULE ntdll = GetModuleHandle(TEXT("ntdll.dll"));
+    if (ntdll == nullptr) {
+        return false;
+    }
+
+    ntQuerySystemInformation = (NtQuerySystemInformation_t)GetProcAddress(ntdll, "NtQuerySystemInformation");
+    ntQuerySystemInformationEx = (NtQuerySystemInformationEx_t)GetProcAddress(ntdll, "NtQuerySystemInformationEx");
+    if (!ntQuerySystemInformation) {
+        return false;
+    }
+
+    // 超过64核的机器存在多个处理器组，只有Ex版本可以按组查询
+    group_count = ntQuerySystemInformationEx ? GetActiveProcessorGroupCount() : 1;
+    if (group_count == 0) {
+        group_count = 1;
+    }
+
+    core_count = ntQuerySystemInformationEx ? GetActiveProcessorCount(ALL_PROCESSOR_GROUPS) : 0;
+    if (core_count == 0) {
+        SYSTEM_INFO sysInfo;
+        GetSystemInfo(&sysInfo);
+        core_count = sysInfo.dwNumberOfProcessors;
+        group_count = 1;
+    }
+
+    raw_buffer.assign(core_count * sizeof(ProcessorPerformanceInfo), 0);
+    prev_idle.assign(core_count, 0);
+    prev_total.assign(core_count, 0);
+
+    is_initialized = readRawCounters();
+    return is_initialized;
+}
+
+/**
+ * 读取所有处理器组的原始计数到raw_buffer
+ * @return 成功返回true
+ */
+bool CpuSampler::readRawCounters() {
+    unsigned char* cursor = raw_buffer.data();
+    size_t remaining = raw_buffer.size();
+
+    for (unsigned short group = 0; group < group_count; ++group) {
+        unsigned long returned = 0;
+        long status;
+
+        if (group_count > 1) {
+            USHORT group_id = group;
+            status = ntQuerySystemInformationEx(SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION_CLASS,
+                                                &group_id, sizeof(group_id),
+                                                cursor, static_cast<unsigned long>(remaining), &returned);
+        } else {
+            status = ntQuerySystemInformation(SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION_CLASS,
+                                              cursor, static_cast<unsigned long>(remaining), &returned);
+        }
+
+        if (status < 0 || returned > remaining) {
+            return false;
+        }
+
+        cursor += returned;
+        remaining -= returned;
+    }
+
+    return true;
+}
+
+/**
+ * 采样每核使用率
+ * @param utilization [out] 每核使用率（0-100）
+ * @param capacity utilization缓冲区长度
+ * @return 实际写入的核心数量，失败返回0
+ */
+size_t CpuSampler::sample(float* utilization, size_t capacity) {
+    if (!is_initialized || !readRawCounters()) {
+        return 0;
+    }
+
+    const ProcessorPerformanceInfo* info =
+        reinterpret_cast<const ProcessorPerformanceInfo*>(raw_buffer.data());
+    const size_t count = core_count < capacity ? core_count : capacity;
+
+    for (size_t i = 0; i < count; ++i) {
+        const unsigned long long idle = static_cast<unsigned long long>(info[i].idle_time.QuadPart);
+        const unsigned long long total = static_cast<unsigned long long>(info[i].kernel_time.QuadPart) +
+                                         static_cast<unsigned long long>(info[i].user_time.QuadPart);
+
+        float value = 0.0f;
+        if (has_baseline && total > prev_total[i]) {
+            const unsigned long long delta_total = total - prev_total[i];
+            const unsigned long long delta_idle = idle > prev_idle[i] ? idle - prev_idle[i] : 0;
+            const unsigned long long busy = delta_total > delta_idle ? delta_total - delta_idle : 0;
+            value = static_cast<float>(busy * 100.0 / delta_total);
+        }
+
+        utilization[i] = value;
+        prev_idle[i] = idle;
+        prev_total[i] = total;
+    }
+
+    has_baseline = true;
+    return count;
+}
+
+} // namespace evan
@@ -11,6 +11,90 @@
     #include <dlfcn.h>
 #endif
 
+namespace {
+    // NVML显存信息（与nvmlMemory_t布局一致）
+    struct NVMLMemoryInfo {
+        unsigned long long total;  // 总显存字节数
+        unsigned long long free;  // 可用显存字节数
+        unsigned long long used;  // 已用显存字节数
+    };
+}
+
+/**
+ * 把标识和采样组合为GPUInfo
+ * @param identity 设备标识
+ * @param sample 动态采样
+ * @return GPU信息（显存单位为MB）
+ */
+GPUInfo gpu_info_compose(const GPUDeviceIdentity& identity, const GPUSample& sample) {
+    const unsigned long long MB = 1024ULL * 1024ULL;
+    GPUInfo gpu_info;
+    gpu_info.name = identity.name;
+    gpu_info.vendor = identity.vendor;
+    gpu_info.driver_version = identity.driver_version;
+    gpu_info.memory_total = static_cast<unsigned int>(identity.memory_total / MB);
+    gpu_info.memory_used = static_cast<unsigned int>(sample.memory_used / MB);
+    gpu_info.memory_free = static_cast<unsigned int>(sample.memory_free / MB);
+    gpu_info.utilization = static_cast<float>(sample.utilization_centi) / 100.0f;
+    gpu_info.temperature = static_cast<float>(sample.temperature_centi) / 100.0f;
+    gpu_info.power_usage = static_cast<float>(sample.power_mw) / 1000.0f;
+    gpu_info.clock_core = static_cast<float>(sample.clock_core_mhz);
+    gpu_info.clock_memory = static_cast<float>(sample.clock_memory_mhz);
+    return gpu_info;
+}
+
+// GPU采样历史实现
+void GPUSampleHistory::addDevice(const GPUDeviceIdentity& identity) {
+    DeviceHistory* existing = find(identity.device_id);
+    if (existing != nullptr) {
+        existing->identity = identity;
+        return;
+    }
+    
+    DeviceHistory history;
+    history.identity = identity;
+    history.samples = evan::utils::RingBuffer<GPUSample>(capacity_);
+    devices.push_back(history);
+}
+
+bool GPUSampleHistory::push(const GPUSample& sample) {
+    DeviceHistory* history = find(sample.device_id);
+    if (history == nullptr) {
+        return false;
+    }
+    history->samples.push(sample);
+    return true;
+}
+
+const evan::utils::RingBuffer<GPUSample>* GPUSampleHistory::samples(unsigned int device_id) const {
+    const DeviceHistory* history = find(device_id);
+    return history ? &history->samples : nullptr;
+}
+
+const GPUDeviceIdentity* GPUSampleHistory::identity(unsigned int device_id) const {
+    const DeviceHistory* history = find(device_id);
+    return history ? &history->identity : nullptr;
+}
+
+// 设备数量很少（通常1-4个），线性查找即可
+GPUSampleHistory::DeviceHistory* GPUSampleHistory::find(unsigned int device_id) {
+    for (auto& history : devices) {
+        if (history.identity.device_id == device_id) {
+            return &history;
+        }
+    }
+    return nullptr;
+}
+
+const GPUSampleHistory::DeviceHistory* GPUSampleHistory::find(unsigned int device_id) const {
+    for (const auto& history : devices) {
+        if (history.identity.device_id == device_id) {
+            return &history;
+        }
+    }
+    return nullptr;
+}
+
 // GPU监控管理器实现
 GPUMonitorManager::GPUMonitorManager() : is_initialized(false) {
 }
@@ -65,6 +149,31 @@ bool GPUMonitorManager::getAllGPUInfo(std::vector<GPUInfo>& gpu_info_list) {
     return !gpu_info_list.empty();
 }
 
+bool GPUMonitorManager::getDeviceIdentities(std::vector<GPUDeviceIdentity>& identities) {
+    if (!is_initialized) {
+        return false;
+    }
+    
+    for (auto monitor : gpu_monitors) {
+        monitor->getDeviceIdentities(identities);
+    }
+    
+    return !identities.empty();
+}
+
+bool GPUMonitorManager::sampleAll(std::vector<GPUSample>& samples) {
+    samples.clear();
+    if (!is_initialized) {
+        return false;
+    }
+    
+    for (auto monitor : gpu_monitors) {
+        monitor->sampleAll(samples);
+    }
+    
+    return !samples.empty();
+}
+
 void GPUMonitorManager::cleanup() {
     for (auto monitor : gpu_monitors) {
         monitor->cleanup();
@@ -165,47 +274,57 @@ bool NVIDIA_GPUMonitor::initialize() {
     return true;
 }
 
-bool NVIDIA_GPUMonitor::getGPUInfo(GPUInfo& gpu_info) {
-    if (!is_initialized || device_count == 0) {
-        return false;
-    }
-    
-    // 获取第一个GPU的信息
-    void* device;
-    if (nvmlDeviceGetHandleByIndex(0, &device) != 0) {
-        return false;
-    }
-    
+/**
+ * 读取单个设备的静态标识
+ * @param index 设备序号
+ * @param device NVML设备句柄
+ * @param identity 输出的设备标识
+ * @return 是否读取成功
+ */
+bool NVIDIA_GPUMonitor::readIdentity(unsigned int index, void* device, GPUDeviceIdentity& identity) {
     // 获取GPU名称
     char name[256];
     if (nvmlDeviceGetName(device, name, sizeof(name)) != 0) {
         return false;
     }
-    gpu_info.name = name;
-    gpu_info.vendor = "NVIDIA";
+    identity.device_id = gpu_device_id(GPU_VENDOR_NVIDIA, index);
+    identity.name = name;
+    identity.vendor = "NVIDIA";
     
     // 获取驱动版本
     char driver_version[256];
     if (nvmlSystemGetDriverVersion(driver_version, sizeof(driver_version)) != 0) {
-        gpu_info.driver_version = "Unknown";
+        identity.driver_version = "Unknown";
     } else {
-        gpu_info.driver_version = driver_version;
+        identity.driver_version = driver_version;
     }
     
-    // 获取显存信息
-    struct NVMLMemoryInfo {
-        unsigned long long total;  // 总显存字节数
-        unsigned long long free;  // 可用显存字节数
-        unsigned long long used;  // 已用显存字节数
-    } memory_info;
-    
+    NVMLMemoryInfo memory_info;
     if (nvmlDeviceGetMemoryInfo(device, &memory_info) != 0) {
         return false;
     }
+    identity.memory_total = memory_info.total;
+    return true;
+}
+
+/**
+ * 读取单个设备的动态读数
+ * 显存、使用率、温度读取失败时返回false，功耗和频率读取失败时记为0
+ * @param index 设备序号
+ * @param device NVML设备句柄
+ * @param sample 输出的采样
+ * @return 是否读取成功
+ */
+bool NVIDIA_GPUMonitor::readSample(unsigned int index, void* device, GPUSample& sample) {
+    sample.device_id = gpu_device_id(GPU_VENDOR_NVIDIA, index);
     
-    gpu_info.memory_total = static_cast<unsigned int>(memory_info.total / (1024 * 1024));
-    gpu_info.memory_used = static_cast<unsigned int>(memory_info.used / (1024 * 1024));
-    gpu_info.memory_free = static_cast<unsigned int>(memory_info.free / (1024 * 1024));
+    // 获取显存信息
+    NVMLMemoryInfo memory_info;
+    if (nvmlDeviceGetMemoryInfo(device, &memory_info) != 0) {
+        return false;
+    }
+    sample.memory_used = memory_info.used;
+    sample.memory_free = memory_info.free;
     
     // 获取使用率
     struct NVMLUtilizationRates {
@@ -216,40 +335,44 @@ bool NVIDIA_GPUMonitor::getGPUInfo(GPUInfo& gpu_info) {
     if (nvmlDeviceGetUtilizationRates(device, &utilization) != 0) {
         return false;
     }
-    
-    gpu_info.utilization = static_cast<float>(utilization.gpu);
+    sample.utilization_centi = utilization.gpu * 100;
     
     // 获取温度
     unsigned int temp;
     if (nvmlDeviceGetTemperature(device, 0, &temp) != 0) {
         return false;
     }
-    gpu_info.temperature = static_cast<float>(temp);
+    sample.temperature_centi = static_cast<int>(temp) * 100;
     
-    // 获取功耗
+    // 获取功耗（NVML本身以毫瓦为单位）
     unsigned int power_usage;
-    if (nvmlDeviceGetPowerUsage(device, &power_usage) != 0) {
-        gpu_info.power_usage = 0.0f;
-    } else {
-        gpu_info.power_usage = static_cast<float>(power_usage) / 1000.0f; // 转换为瓦
-    }
+    sample.power_mw = nvmlDeviceGetPowerUsage(device, &power_usage) != 0 ? 0 : power_usage;
     
-    // 获取核心频率
-    unsigned int clock_core;
-    if (nvmlDeviceGetClockInfo(device, 0, &clock_core) != 0) {
-        gpu_info.clock_core = 0.0f;
-    } else {
-        gpu_info.clock_core = static_cast<float>(clock_core);
+    // 获取核心频率和显存频率
+    unsigned int clock;
+    sample.clock_core_mhz = nvmlDeviceGetClockInfo(device, 0, &clock) != 0 ? 0 : clock;
+    sample.clock_memory_mhz = nvmlDeviceGetClockInfo(device, 1, &clock) != 0 ? 0 : clock;
+    
+    return true;
+}
+
+bool NVIDIA_GPUMonitor::getGPUInfo(GPUInfo& gpu_info) {
+    if (!is_initialized || device_count == 0) {
+        return false;
     }
     
-    // 获取显存频率
-    unsigned int clock_memory;
-    if (nvmlDeviceGetClockInfo(device, 1, &clock_memory) != 0) {
-        gpu_info.clock_memory = 0.0f;
-    } else {
-        gpu_info.clock_memory = static_cast<float>(clock_memory);
+    // 获取第一个GPU的信息
+    void* device;
+    if (nvmlDeviceGetHandleByIndex(0, &device) != 0) {
+        return false;
     }
     
+    GPUDeviceIdentity identity;
+    GPUSample sample;
+    if (!readIdentity(0, device, identity) || !readSample(0, device, sample)) {
+        return false;
+    }
+    gpu_info = gpu_info_compose(identity, sample);
     return true;
 }
 
@@ -259,92 +382,63 @@ bool NVIDIA_GPUMonitor::getAllGPUInfo(std::vector<GPUInfo>& gpu_info_list) {
     }
     
     for (unsigned int i = 0; i < device_count; ++i) {
-        GPUInfo gpu_info;
-        
         // 获取GPU句柄
         void* device;
         if (nvmlDeviceGetHandleByIndex(i, &device) != 0) {
             continue;
         }
         
-        // 获取GPU名称
-        char name[256];
-        if (nvmlDeviceGetName(device, name, sizeof(name)) != 0) {
+        GPUDeviceIdentity identity;
+        GPUSample sample;
+        if (!readIdentity(i, device, identity) || !readSample(i, device, sample)) {
             continue;
         }
-        gpu_info.name = name;
-        gpu_info.vendor = "NVIDIA";
-        
-        // 获取驱动版本
-        char driver_version[256];
-        if (nvmlSystemGetDriverVersion(driver_version, sizeof(driver_version)) != 0) {
-            gpu_info.driver_version = "Unknown";
-        } else {
-            gpu_info.driver_version = driver_version;
-        }
-        
-        // 获取显存信息
-        struct NVMLMemoryInfo {
-            unsigned long long total;  // 总显存字节数
-            unsigned long long free;  // 可用显存字节数
-            unsigned long long used;  // 已用显存字节数
-        } memory_info;
-        
-        if (nvmlDeviceGetMemoryInfo(device, &memory_info) != 0) {
+        gpu_info_list.push_back(gpu_info_compose(identity, sample));
+    }
+    
+    return !gpu_info_list.empty();
+}
+
+bool NVIDIA_GPUMonitor::getDeviceIdentities(std::vector<GPUDeviceIdentity>& identities) {
+    if (!is_initialized || device_count == 0) {
+        return false;
+    }
+    
+    const size_t before = identities.size();
+    for (unsigned int i = 0; i < device_count; ++i) {
+        void* device;
+        if (nvmlDeviceGetHandleByIndex(i, &device) != 0) {
             continue;
         }
         
-        gpu_info.memory_total = static_cast<unsigned int>(memory_info.total / (1024 * 1024));
-        gpu_info.memory_used = static_cast<unsigned int>(memory_info.used / (1024 * 1024));
-        gpu_info.memory_free = static_cast<unsigned int>(memory_info.free / (1024 * 1024));
-        
-        // 获取使用率
-        struct NVMLUtilizationRates {
-            unsigned int gpu;    // GPU使用率
-            unsigned int memory; // 显存使用率
-        } utilization;
-        
-        if (nvmlDeviceGetUtilizationRates(device, &utilization) != 0) {
-            continue;
+        GPUDeviceIdentity identity;
+        if (readIdentity(i, device, identity)) {
+            identities.push_back(identity);
         }
-        
-        gpu_info.utilization = static_cast<float>(utilization.gpu);
-        
-        // 获取温度
-        unsigned int temp;
-        if (nvmlDeviceGetTemperature(device, 0, &temp) != 0) {
+    }
+    
+    return identities.size() > before;
+}
+
+bool NVIDIA_GPUMonitor::sampleAll(std::vector<GPUSample>& samples) {
+    if (!is_initialized || device_count == 0) {
+        return false;
+    }
+    
+    const size_t before = samples.size();
+    for (unsigned int i = 0; i < device_count; ++i) {
+        void* device;
+        if (nvmlDeviceGetHandleByIndex(i, &device) != 0) {
             continue;
         }
-        gpu_info.temperature = static_cast<float>(temp);
         
-        // 获取功耗
-        unsigned int power_usage;
-        if (nvmlDeviceGetPowerUsage(device, &power_usage) != 0) {
-            gpu_info.power_usage = 0.0f;
-        } else {
-            gpu_info.power_usage = static_cast<float>(power_usage) / 1000.0f; // 转换为瓦
+        GPUSample sample;
+        if (readSample(i, device, sample)) {
+            samples.push_back(sample);
         }
-        
-        // 获取核心频率
-        unsigned int clock_core;
-        if (nvmlDeviceGetClockInfo(device, 0, &clock_core) != 0) {
-            gpu_info.clock_core = 0.0f;
-        } else {
-            gpu_info.clock_core = static_cast<float>(clock_core);
-        }
-        
-        // 获取显存频率
-        unsigned int clock_memory;
-        if (nvmlDeviceGetClockInfo(device, 1, &clock_memory) != 0) {
-            gpu_info.clock_memory = 0.0f;
-        } else {
-            gpu_info.clock_memory = static_cast<float>(clock_memory);
-        }
-        
-        gpu_info_list.push_back(gpu_info);
     }
     
-    return !gpu_info_list.empty();
+    return samples.size() > before;
 }
 
 void NVIDIA_GPUMonitor::cleanup() {
@@ -387,6 +481,14 @@ bool AMD_GPUMonitor::getAllGPUInfo(std::vector<GPUInfo>& gpu_info_list) {
     return false;
 }
 
+bool AMD_GPUMonitor::getDeviceIdentities(std::vector<GPUDeviceIdentity>& identities) {
+    return false;
+}
+
+bool AMD_GPUMonitor::sampleAll(std::vector<GPUSample>& samples) {
+    return false;
+}
+
 void AMD_GPUMonitor::cleanup() {
     is_initialized = false;
 }
@@ -413,6 +515,14 @@ bool Intel_GPUMonitor::getAllGPUInfo(std::vector<GPUInfo>& gpu_info_list) {
     return false;
 }
 
+bool Intel_GPUMonitor::getDeviceIdentities(std::vector<GPUDeviceIdentity>& identities) {
+    return false;
+}
+
+bool Intel_GPUMonitor::sampleAll(std::vector<GPUSample>& samples) {
+    return false;
+}
+
 void Intel_GPUMonitor::cleanup() {
     is_initialized = false;
 }
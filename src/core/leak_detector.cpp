@@ -0,0 +1,240 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "core/leak_detector.h"
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include "core/alert_sink.h"
+#include "core/collector.h"
+#include "core/configuration.h"
+#include "core/process_query.h"
+#include "utils/format.h"
+
+namespace evan {
+    /**
+     * 构造函数
+     * @param rate 增长速度阈值（字节每秒）
+     * @param duration_ms 最短增长时间（毫秒）
+     */
+    LeakDetector::LeakDetector(double rate, unsigned long long duration_ms)
+        : rate(rate), duration_ms(duration_ms), interval_ms(duration_ms / (LEAK_WINDOW_POINTS - 1)),
+          available(-1.0), generation(0) {}
+
+    /**
+     * 填充一个进程的结果
+     * @param state 进程状态
+     * @param pid 进程ID
+     * @param kind 泄漏状态
+     * @param now_ms 当前时间
+     * @param finding [out] 结果
+     */
+    void LeakDetector::fill(const ProcessState& state, unsigned long pid, LeakState kind, unsigned long long now_ms,
+                            LeakFinding& finding) const {
+        finding.state = kind;
+        finding.pid = pid;
+        finding.process = state.name;
+        finding.working_set = static_cast<unsigned long long>(state.window.lastY());
+        finding.rate = state.window.slope();
+        finding.r2 = state.window.r2();
+        finding.leaking_ms = now_ms - state.since_ms;
+        finding.exhaust_seconds = available >= 0.0 && finding.rate > 0.0 ? available / finding.rate : -1.0;
+    }
+
+    /**
+     * 处理本次循环的进程表
+     * @param sources 数据源
+     * @param now_ms 单调时钟（毫秒）
+     * @param findings [out] 正在增长和状态变化的进程
+     */
+    void LeakDetector::observe(const TickSources& sources, unsigned long long now_ms, std::vector<LeakFinding>& findings) {
+        ++generation;
+        available = sources.has(SOURCE_MEMORY_STATUS) ? static_cast<double>(sources.memory_status.ullAvailPhys) : -1.0;
+        if (!sources.has(SOURCE_PROCESS_TABLE)) {
+            return;
+        }
+
+        const double span = static_cast<double>(duration_ms) / 1000.0;
+        const ProcessList& list = sources.processes;
+        for (size_t i = 0; i < list.size(); ++i) {
+            const ProcessSample& sample = list[i];
+            if (!sample.accessible) {
+                continue;
+            }
+
+            ProcessState& state = processes[sample.pid];
+            if (state.seen != 0 && sample.name != utils::StringView(state.name)) {
+                // PID被重用：之前的进程已经退出
+                if (state.leaking) {
+                    LeakFinding finding;
+                    fill(state, sample.pid, LEAK_EXITED, now_ms, finding);
+                    findings.push_back(finding);
+                }
+                state = ProcessState();
+            }
+            if (state.seen == 0) {
+                state.name.assign(sample.name.data(), sample.name.size());
+                state.first_ms = now_ms;
+            }
+            state.seen = generation;
+
+            if (state.window.size() != 0 && now_ms - state.sampled_ms < interval_ms) {
+                if (state.leaking) {
+                    LeakFinding finding;
+                    fill(state, sample.pid, LEAK_ONGOING, now_ms, finding);
+                    findings.push_back(finding);
+                }
+                continue;
+            }
+            state.window.add(static_cast<double>(now_ms - state.first_ms) / 1000.0,
+                             static_cast<double>(sample.working_set));
+            state.sampled_ms = now_ms;
+
+            const double slope = state.window.slope();
+            const double r2 = state.window.r2();
+            if (!state.leaking) {
+                if (state.window.size() >= LEAK_MIN_POINTS && state.window.span() >= span &&
+                    slope >= rate && r2 >= LEAK_MIN_R2) {
+                    state.leaking = true;
+                    state.since_ms = now_ms;
+                    LeakFinding finding;
+                    fill(state, sample.pid, LEAK_STARTED, now_ms, finding);
+                    findings.push_back(finding);
+                }
+                continue;
+            }
+
+            LeakFinding finding;
+            if (slope < rate * LEAK_RESOLVE_RATIO || r2 < LEAK_MIN_R2 * LEAK_RESOLVE_RATIO) {
+                fill(state, sample.pid, LEAK_RESOLVED, now_ms, finding);
+                state.leaking = false;
+            } else {
+                fill(state, sample.pid, LEAK_ONGOING, now_ms, finding);
+            }
+            findings.push_back(finding);
+        }
+
+        // 丢弃已退出的进程
+        for (std::unordered_map<unsigned long, ProcessState>::iterator it = processes.begin(); it != processes.end();) {
+            if (it->second.seen == generation) {
+                ++it;
+                continue;
+            }
+            if (it->second.leaking) {
+                LeakFinding finding;
+                fill(it->second, it->first, LEAK_EXITED, now_ms, finding);
+                findings.push_back(finding);
+            }
+            it = processes.erase(it);
+        }
+    }
+
+    namespace {
+    const char* const LEAK_STATE_NAMES[] = {"leaking", "leaking", "resolved", "exited"};
+
+    /**
+     * 格式化时间长度（如"2d 3h"、"3h 12m"、"12m 5s"）
+     * @param seconds 秒数，负数表示未知
+     */
+    std::string evos_leak_duration_str(double seconds) {
+        if (seconds < 0.0) {
+            return "-";
+        }
+        const unsigned long long total = static_cast<unsigned long long>(seconds);
+        if (total >= 86400) {
+            return EVAN_FORMAT_STRING("{}d {}h", total / 86400, total % 86400 / 3600);
+        }
+        if (total >= 3600) {
+            return EVAN_FORMAT_STRING("{}h {}m", total / 3600, total % 3600 / 60);
+        }
+        return EVAN_FORMAT_STRING("{}m {}s", total / 60, total % 60);
+    }
+    }
+
+    /**
+     * 生成泄漏状态变化的JSON行
+     * @param finding 进程
+     * @return JSON行
+     */
+    std::string evos_leak_finding_json(const LeakFinding& finding) {
+        char time[32];
+        const std::time_t now = std::time(nullptr);
+        const std::tm* local = std::localtime(&now);
+        if (local == nullptr || std::strftime(time, sizeof(time), "%Y-%m-%dT%H:%M:%S", local) == 0) {
+            time[0] = '\0';
+        }
+
+        std::string line;
+        utils::StringSink sink(line);
+        EVAN_FORMAT(sink, "{{\"time\":\"{}\",\"rule\":\"leak\",\"state\":\"{}\",\"pid\":{},\"process\":",
+                    time, LEAK_STATE_NAMES[finding.state], finding.pid);
+        evos_json_string_write(sink, finding.process);
+        EVAN_FORMAT(sink, ",\"working_set\":{},\"rate_per_hour\":{:.0f},\"r2\":{:.3f},\"exhaust_s\":{:.0f}}}",
+                    finding.working_set, finding.rate * 3600.0, finding.r2, finding.exhaust_seconds);
+        return line;
+    }
+
+    namespace {
+    /**
+     * 内存泄漏检测采集器
+     */
+    class LeaksCollector : public Collector {
+    public:
+        LeaksCollector(double rate, unsigned long long duration_ms, const std::shared_ptr<AlertSink>& sink)
+            : detector(rate, duration_ms), sink(sink) {}
+
+        const char* name() const override { return "leaks"; }
+        DataSourceMask sources() const override { return SOURCE_MEMORY_STATUS | SOURCE_PROCESS_TABLE; }
+
+        void display(const TickSources& sources, const Configuration& config) override {
+            findings.clear();
+            const unsigned long long now = static_cast<unsigned long long>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+            detector.observe(sources, now, findings);
+
+            size_t leaking = 0;
+            for (size_t i = 0; i < findings.size(); ++i) {
+                leaking += findings[i].state == LEAK_STARTED || findings[i].state == LEAK_ONGOING ? 1 : 0;
+            }
+            EVAN_PRINT("\n[Leaks]\n\tTracked: {} processes, Threshold: {}/h over {} min, Leaking: {}\n",
+                       detector.tracked(), config.config_byte_to_str(static_cast<unsigned long long>(detector.threshold() * 3600.0)),
+                       detector.duration() / 60000, leaking);
+            if (leaking != 0) {
+                EVAN_PRINT("\t{:<8} {:<24} {:>12} {:>12} {:>6} {:>10} {:>12}\n",
+                           "PID", "Name", "Working Set", "Rate/h", "R2", "Leaking", "Exhaust In");
+            }
+            for (size_t i = 0; i < findings.size(); ++i) {
+                const LeakFinding& finding = findings[i];
+                if (finding.state == LEAK_STARTED || finding.state == LEAK_ONGOING) {
+                    EVAN_PRINT("\t{:<8} {:<24} {:>12} {:>12} {:>6.3f} {:>10} {:>12}\n", finding.pid, finding.process,
+                               config.config_byte_to_str(finding.working_set),
+                               config.config_byte_to_str(static_cast<unsigned long long>(finding.rate * 3600.0)),
+                               finding.r2, evos_leak_duration_str(finding.leaking_ms / 1000.0),
+                               evos_leak_duration_str(finding.exhaust_seconds));
+                }
+                if (sink != nullptr && finding.state != LEAK_ONGOING) {
+                    sink->send(evos_leak_finding_json(finding));
+                }
+            }
+        }
+
+    private:
+        LeakDetector detector;
+        std::shared_ptr<AlertSink> sink;
+        std::vector<LeakFinding> findings;
+    };
+    }
+
+    /**
+     * 创建内存泄漏检测采集器
+     * @param rate 增长速度阈值（字节每秒）
+     * @param duration_ms 最短增长时间（毫秒）
+     * @param sink 告警输出
+     * @return 采集器
+     */
+    Collector* evos_leaks_collector_create(double rate, unsigned long long duration_ms,
+                                           const std::shared_ptr<AlertSink>& sink) {
+        return new LeaksCollector(rate, duration_ms, sink);
+    }
+}
@@ -4,7 +4,24 @@
 #include "utils/command_line.h"
 #include "core/system_monitor.h"
 #include "core/gpu_monitor.h"
+#include "core/remote_monitor.h"
+#include "core/alert_rules.h"
+#include "core/alert_sink.h"
+#include "core/anomaly_detector.h"
+#include "core/leak_detector.h"
+#include "core/proc_capture.h"
+#include "core/perf_counters.h"
+#include "core/process_controls.h"
+#include "core/process_query.h"
+#include "core/procfs_source.h"
+#include "core/self_stats.h"
+#include "utils/alloc_tracker.h"
+#include "utils/executor.h"
+#include "utils/metrics.h"
+#include <chrono>
 #include <functional>
+#include <memory>
+#include <thread>
 
 namespace evan {
     /**
@@ -23,6 +40,8 @@ namespace evan {
              ArguFunc('e', "show each process info.", NULL)},
             {"hardware",  // hardware参数 - 显示PC硬件信息
              ArguFunc('w', "show PC hardware information.", NULL)},
+            {"cpu-heatmap", // cpu-heatmap参数 - 显示每核CPU热力图及内存/交换区历史
+             ArguFunc('m', "show per-core CPU heatmap with memory/swap history.", &evan::evos_cpu_heatmap_display)},
             {"gpu",       // gpu参数 - 显示GPU信息
              ArguFunc('g', "show GPU information.", &evan::evos_gpu_info_display)},
             {"gpu-advanced", // gpu-advanced参数 - 显示GPU高级信息
@@ -47,6 +66,14 @@ namespace evan {
              ArguFunc('A', "show network connection analysis.", &evan::evos_net_connection_display)},
             {"net-interfaces", // net-interfaces参数 - 显示网络接口状态
              ArguFunc('I', "show network interfaces status.", &evan::evos_net_interfaces_display)},
+            {"perf-counters", // perf-counters参数 - 显示性能计数器（目标由--perf-target指定）
+             ArguFunc('L', "show per-process performance counters (cycles, CPU time, context switches, faults) for --perf-target.", NULL)},
+            {"alerts",    // alerts参数 - 按--rules中的规则告警
+             ArguFunc('U', "evaluate the alert rules in --rules every tick and report state changes to --alert-sink.", NULL)},
+            {"anomalies", // anomalies参数 - 按流式统计量标记异常样本
+             ArguFunc('j', "flag system (and --anomaly-top process) metrics that deviate from their running median.", NULL)},
+            {"leaks",     // leaks参数 - 标记工作集持续增长的进程
+             ArguFunc('h', "flag processes whose working set grows steadily and project when they exhaust available memory.", NULL)},
             {"port-scan", // port-scan参数 - 扫描指定主机的端口
              ArguFunc('P', "scan ports on specified host.", NULL)}}
             ;
@@ -58,6 +85,241 @@ namespace evan {
      * 用于管理所有GPU监控器
      */
     GPUMonitorManager gpuManager;
+    
+    /**
+     * 功能映射表的迭代器
+     */
+    typedef std::map<std::string, ArguFunc>::const_iterator FeatureIter;
+    
+    /**
+     * 构建执行计划
+     * 选中的功能按funcMap顺序加入计划；内置采集器声明了依赖的数据源，
+     * 其余功能包装为FunctionCollector注册到注册表中
+     * @param registry 采集器注册表（已注册内置采集器）
+     * @param isSelected 判断功能是否被选中
+     * @param plan [out] 执行计划
+     */
+    template <typename Predicate>
+    void evos_plan_build(CollectorRegistry& registry, Predicate isSelected, CollectorPlan& plan) {
+        for (FeatureIter it = funcMap.begin(); it != funcMap.end(); ++it) {
+            if (!isSelected(it->first)) {
+                continue;
+            }
+            
+            Collector* collector = registry.find(it->first);
+            if (collector == nullptr && it->second.func != NULL) {
+                collector = new FunctionCollector(it->first, it->second.func);
+                registry.add(collector);
+            }
+            if (collector != nullptr) {
+                plan.add(collector);
+            }
+        }
+    }
+    
+    /**
+     * 读取本次循环的数据源
+     * @param plan 执行计划
+     * @param sources [out] 数据源
+     */
+    void evos_plan_load(const CollectorPlan& plan, TickSources& sources) {
+        utils::AllocScope allocScope("sources");  ///< 分配计入共享数据源
+        plan.load(sources, evos_tick_arena());
+    }
+    
+    /**
+     * 执行一次计划
+     * 先统一读取所有采集器依赖的数据源（每个数据源只读一次），再执行采集器。
+     * executor为空时在当前线程依次执行；否则各采集器在线程池中并行执行，
+     * 每个采集器的输出先写入自己的缓冲区，全部完成后按计划顺序输出，结果与依次执行相同
+     * @param plan 执行计划
+     * @param executor 执行器，可以为nullptr
+     */
+    void evos_plan_run(const CollectorPlan& plan, utils::Executor* executor) {
+        static utils::MetricCounter& ticks = utils::MetricsRegistry::instance().counter("ticks");
+        static utils::MetricHistogram& collectTime = utils::MetricsRegistry::instance().latency("tick.collect_us");
+        static utils::MetricHistogram& outputTime = utils::MetricsRegistry::instance().latency("sink.stdout_us");
+        
+        ticks.add();
+        
+        if (executor == nullptr) {
+            utils::LatencyTimer tickTimer(collectTime);
+            
+            // 数据源保存在主线程的Arena中，下次循环开始时才回收
+            TickSources sources(evos_tick_arena());
+            evos_plan_load(plan, sources);
+            for (size_t i = 0; i < plan.size(); ++i) {
+                utils::AllocScope allocScope(plan[i]->name());  ///< 分配计入当前采集器
+                utils::LatencyTimer timer(plan.latency(i));     ///< 依次执行时耗时包含直接写入标准输出
+                plan[i]->display(sources, globalConfig);
+            }
+            return;
+        }
+        
+        // 缓冲区跨循环复用，预热后不再分配
+        static std::vector<std::string> outputs;
+        static std::vector<utils::Executor::Task> tasks;
+        {
+            utils::LatencyTimer tickTimer(collectTime);
+            
+            // 数据源保存在主线程的Arena中，工作线程只读访问，下次循环开始时才回收
+            TickSources sources(evos_tick_arena());
+            evos_plan_load(plan, sources);
+            
+            outputs.resize(plan.size());
+            tasks.clear();
+            for (size_t i = 0; i < plan.size(); ++i) {
+                outputs[i].clear();
+                std::string* output = &outputs[i];
+                Collector* collector = plan[i];
+                utils::MetricHistogram* latency = &plan.latency(i);
+                const TickSources* shared = &sources;
+                tasks.push_back([output, collector, latency, shared]() {
+                    utils::StringSink sink(*output);
+                    {
+                        utils::StdoutCapture capture(sink);
+                        utils::AllocScope allocScope(collector->name());  ///< 分配计入当前采集器
+                        utils::LatencyTimer timer(*latency);
+                        collector->display(*shared, globalConfig);
+                    }
+                    evos_tick_reset();  ///< 输出已复制到缓冲区，回收工作线程的Arena
+                });
+            }
+            
+            executor->run(tasks);  ///< 等待所有采集器完成（循环屏障）
+        }
+        
+        utils::LatencyTimer timer(outputTime);
+        for (size_t i = 0; i < outputs.size(); ++i) {
+            fwrite(outputs[i].data(), 1, outputs[i].size(), stdout);
+        }
+    }
+    
+    /**
+     * 按固定间隔调度循环
+     * 每次循环的截止时间是上一次的截止时间加间隔（而不是上一次结束后再等待一个间隔），
+     * 采集耗时不会累积为漂移；醒来时刻与截止时间之差记录到tick.jitter_us。
+     * 某次循环超过了下一个截止时间时立即开始，并从当前时刻重新计算截止时间，不补跑错过的循环
+     */
+    class TickScheduler {
+    public:
+        /**
+         * 构造函数
+         * @param interval 循环间隔
+         */
+        explicit TickScheduler(std::chrono::milliseconds interval) :
+            interval(interval), deadline(std::chrono::steady_clock::now() + interval) {}
+        
+        /**
+         * 等待到下一次循环的截止时间
+         */
+        void wait() {
+            static utils::MetricHistogram& jitter = utils::MetricsRegistry::instance().latency("tick.jitter_us");
+            
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            if (now < deadline) {
+                std::this_thread::sleep_until(deadline);
+                now = std::chrono::steady_clock::now();
+            }
+            jitter.observe(static_cast<unsigned long long>(
+                std::chrono::duration_cast<std::chrono::microseconds>(now - deadline).count()));
+            
+            deadline += interval;
+            if (deadline < now) {
+                deadline = now + interval;
+            }
+        }
+        
+    private:
+        std::chrono::milliseconds interval;
+        std::chrono::steady_clock::time_point deadline;
+    };
+    
+    /**
+     * 以后台进程方式重新启动自身的采集服务器
+     * @param socketPath 套接字路径
+     * @return 成功返回0
+     */
+    int evos_serve_detach(const std::string& socketPath) {
+        char exePath[MAX_PATH];
+        DWORD length = GetModuleFileName(NULL, exePath, sizeof(exePath));
+        if (length == 0 || length >= sizeof(exePath)) {
+            evos_error_print("GetModuleFileName");
+            return 1;
+        }
+        
+        std::string commandLine = std::string("\"") + exePath + "\" --serve --foreground --socket \"" +
+                                  socketPath + "\"";
+        std::vector<char> mutableCommandLine(commandLine.begin(), commandLine.end());
+        mutableCommandLine.push_back('\0');
+        
+        STARTUPINFO si;
+        memset(&si, 0, sizeof(si));
+        si.cb = sizeof(si);
+        PROCESS_INFORMATION pi;
+        
+        if (!CreateProcess(exePath, mutableCommandLine.data(), NULL, NULL, FALSE,
+                           DETACHED_PROCESS | CREATE_NEW_PROCESS_GROUP, NULL, NULL, &si, &pi)) {
+            evos_error_print("CreateProcess");
+            return 1;
+        }
+        
+        printf("evanOS server started in background (PID %lu), listening on %s\n",
+               pi.dwProcessId, socketPath.c_str());
+        CloseHandle(pi.hThread);
+        CloseHandle(pi.hProcess);
+        return 0;
+    }
+    
+    /**
+     * 运行采集服务器
+     * 每秒采集一次快照，并广播给所有通过--attach连接的客户端
+     * 无论连接了多少客户端，采集都只执行一次
+     * @param socketPath 套接字路径
+     * @return 退出码
+     */
+    int evos_serve_run(const std::string& socketPath) {
+        MonitorServer server;
+        if (!server.start(socketPath)) {
+            return 1;
+        }
+        
+        static utils::MetricHistogram& broadcastTime = utils::MetricsRegistry::instance().latency("sink.remote_us");
+        
+        MonitorSnapshot snapshot;
+        TickScheduler scheduler(std::chrono::milliseconds(1000));
+        for (;;) {
+            server.acceptClients();
+            if (evos_snapshot_collect(snapshot)) {
+                utils::AllocScope allocScope("sink.remote");
+                utils::LatencyTimer timer(broadcastTime);
+                server.broadcast(snapshot);
+            }
+            scheduler.wait();
+        }
+    }
+    
+    /**
+     * 附加到采集服务器并渲染收到的快照
+     * @param socketPath 套接字路径
+     * @return 服务器关闭时返回0，连接失败返回1
+     */
+    int evos_attach_run(const std::string& socketPath) {
+        MonitorClient client;
+        if (!client.connect(socketPath)) {
+            return 1;
+        }
+        
+        MonitorSnapshot snapshot;
+        while (client.receive(snapshot)) {
+            system("cls");  ///< 清屏，为下次显示做准备
+            evos_snapshot_render(snapshot);
+            printf("[ATTACHED]:%s\n", socketPath.c_str());
+        }
+        
+        printf("Server at %s closed the connection.\n", socketPath.c_str());
+        return 0;
+    }
 }
 
 /**
@@ -123,6 +385,14 @@ int main(int argc, char **argv) {
     par.add("inquire", 'i', "Inquire the selected process info.",
                            false, evan::PID_MIN);
     
+    /**
+     * inquire-batch参数 - 批量查询进程
+     * 类型：string (查询文件路径，"-"表示标准输入)
+     * 说明：每行一个PID或进程名通配符，共用一次进程快照，结果以NDJSON输出
+     */
+    par.add("inquire-batch", 'b', "Inquire PIDs or name patterns listed in a file (- for stdin), one per line, as NDJSON.",
+                                 false, std::string(""));
+    
     /**
      * loop参数 - 循环执行程序
      * 类型：unsigned int (循环次数)
@@ -141,6 +411,147 @@ int main(int argc, char **argv) {
     par.add("type", 'y', "Set the show byte type[0=B,1=KB,2=MB,3=GB],Auto decide if not use this.",
                  false, evan::DEFAULT_BTYPE);
 
+    /**
+     * changes-only参数 - 增量输出模式
+     * 说明：与--loop配合使用，只输出变化超过阈值的字段和进程行，定期输出完整关键帧
+     */
+    par.add("changes-only", 'W', "with --loop, print only fields/process rows that changed.");
+    
+    /**
+     * change-threshold参数 - 变化阈值
+     * 类型：unsigned int (相对上一次输出值的百分比)
+     * 说明：默认1%，0表示任何变化都输出
+     */
+    par.add("change-threshold", 'r', "set the --changes-only threshold in percent (default 1).",
+            false, evan::DEFAULT_CHANGE_THRESHOLD);
+    
+    /**
+     * keyframe参数 - 关键帧间隔
+     * 类型：unsigned int (循环次数)
+     * 说明：默认每60次循环输出一次完整关键帧，0表示只在开始时输出
+     */
+    par.add("keyframe", 'K', "print a full --changes-only keyframe every N ticks (default 60).",
+            false, evan::DEFAULT_KEYFRAME_INTERVAL);
+    
+    /**
+     * jobs参数 - 并行采集线程数
+     * 类型：unsigned int (线程数)
+     * 说明：选中的功能互相独立，默认每个功能一个线程并行执行，一次循环的耗时等于最慢的功能；
+     *       输出仍按固定顺序显示。1表示在主线程中依次执行；--changes-only模式始终依次执行
+     */
+    par.add("jobs", 'J', "run selected features on N threads in parallel (default: one per feature, 1 = sequential).",
+            false, evan::DEFAULT_JOBS);
+    
+    /**
+     * cpu-affinity参数 - 限制监控进程可用的CPU
+     * 类型：string (CPU列表，如"0,2-3")
+     * 说明：在延迟敏感的主机上把采集线程固定在housekeeping核心上
+     */
+    par.add("cpu-affinity", 'Q', "pin evanOS (all collector threads) to a CPU list such as \"0,2-3\".",
+            false, std::string(""));
+    
+    /**
+     * sched-class参数 - 调度类别
+     * 类型：string (idle/batch/normal)
+     * 说明：idle对应IDLE_PRIORITY_CLASS，batch对应BELOW_NORMAL_PRIORITY_CLASS
+     */
+    par.add("sched-class", 'Y', "run evanOS in scheduling class idle, batch or normal.",
+            false, std::string("normal"));
+    
+    /**
+     * io-idle参数 - 后台I/O模式
+     * 说明：进入进程后台模式，I/O优先级和内存页优先级降为最低
+     */
+    par.add("io-idle", 'O', "run evanOS in background mode (lowest I/O and memory priority).");
+    
+    /**
+     * numa-node参数 - 绑定NUMA节点
+     * 类型：unsigned int (节点编号)
+     * 说明：只在该节点的处理器上运行，内存随之从该节点分配
+     */
+    par.add("numa-node", 'N', "bind evanOS to the processors (and memory) of a NUMA node.",
+            false, 0u);
+    
+    /**
+     * proc-root参数 - 从procfs格式的目录读取数据
+     * 类型：string (目录路径)
+     * 说明：进程表、内存状态和处理器数量从该目录读取（如合成的fixture），用于复现和基准测试
+     */
+    par.add("proc-root", 'R', "read processes, memory and CPU count from a procfs-format directory or .tar capture.",
+            false, std::string(""));
+    
+    /**
+     * perf-target参数 - 性能计数器的目标
+     * 类型：string (逗号分隔的PID)
+     * 说明：--perf-counters统计这些进程；与--inquire一起使用时统计被查询的进程
+     */
+    par.add("perf-target", 'M', "comma-separated PIDs counted by --perf-counters.",
+            false, std::string(""));
+    
+    /**
+     * rules参数 - 告警规则文件
+     * 类型：string (文件路径)
+     * 说明：每行一条规则，如 java_rss: proc.rss > 8G && proc.name ~ "java"，
+     *       或 mem_pressure: sys.mem.used_pct > 90 for 30s；启动时编译一次
+     */
+    par.add("rules", 'V', "alert rules file for --alerts, one rule per line ([name:] expr [for 30s]).",
+            false, std::string(""));
+    
+    /**
+     * alert-sink参数 - 告警输出
+     * 类型：string (stdout、file:<路径>、exec:<命令>或unix:<路径>)
+     * 说明：告警开始和恢复时输出一行JSON，默认写入标准输出
+     */
+    par.add("alert-sink", 'Z', "where --alerts sends firing/resolved events: stdout, file:<path>, exec:<cmd> or unix:<path>.",
+            false, std::string(""));
+    
+    /**
+     * anomaly-threshold参数 - 异常阈值
+     * 类型：double (稳健z值)
+     * 说明：样本相对运行中位数的稳健z值（0.6745 * 偏差 / MAD）的绝对值达到该值时标记
+     */
+    par.add("anomaly-threshold", 'x', "robust z-score at which --anomalies flags a sample (default 4).",
+            false, evan::DEFAULT_ANOMALY_THRESHOLD);
+    
+    /**
+     * anomaly-top参数 - 异常检测跟踪的进程数
+     * 类型：unsigned int
+     * 说明：另外跟踪工作集最大的N个进程的proc.rss和proc.pagefile，0表示只跟踪系统字段
+     */
+    par.add("anomaly-top", 'q', "also track proc.rss/proc.pagefile of the N largest processes in --anomalies.",
+            false, 0u);
+    
+    /**
+     * leak-rate参数 - 泄漏阈值（没有短选项）
+     * 类型：double (MB每小时)
+     * 说明：工作集在滑动窗口内的最小二乘斜率达到该速度时标记进程
+     */
+    par.add("leak-rate", 0, "working set growth in MB per hour at which --leaks flags a process (default 10).",
+            false, evan::DEFAULT_LEAK_RATE_MB_PER_HOUR);
+    
+    /**
+     * leak-duration参数 - 最短增长时间（没有短选项）
+     * 类型：unsigned int (分钟)
+     * 说明：滑动窗口覆盖的时间，进程的工作集至少持续增长这么久才会被标记
+     */
+    par.add("leak-duration", 0, "minutes a process must keep growing before --leaks flags it (default 30).",
+            false, evan::DEFAULT_LEAK_DURATION_MIN);
+    
+    /**
+     * capture-proc参数 - 保存当前数据源
+     * 类型：string (归档路径)
+     * 说明：把进程表、内存状态和处理器信息保存为procfs格式的tar归档，之后用--proc-root回放
+     */
+    par.add("capture-proc", 'd', "capture processes, memory and CPU info to a procfs-format .tar (replay with --proc-root).",
+            false, std::string(""));
+    
+    /**
+     * stats参数 - 显示自身运行统计
+     * 说明：程序结束前显示evanOS自身的统计（按采集器统计的耗时和内存分配、循环抖动等），
+     *       分配统计需要使用-DEVANOS_ALLOC_TRACKING=ON构建
+     */
+    par.add("stats", 'X', "print evanOS self statistics (latency and allocations per collector) before exit.");
+
     /**
      * help参数 - 显示帮助信息
      * 短选项：'?'
@@ -192,6 +603,31 @@ int main(int argc, char **argv) {
      */
     par.add("end-port", 'E', "specify end port for port scan.", false, 100);
 
+    /**
+     * serve参数 - 以后台进程运行采集服务器
+     * 说明：采集结果通过Unix域套接字广播给所有--attach客户端
+     */
+    par.add("serve", 'D', "run collection in a background server behind a Unix socket.");
+    
+    /**
+     * attach参数 - 附加到采集服务器
+     * 说明：从--serve进程接收快照并渲染，不在本进程中采集
+     */
+    par.add("attach", 'T', "attach to a running --serve process and render its CPU heatmap and memory history.");
+    
+    /**
+     * socket参数 - 采集服务器套接字路径
+     * 类型：string (文件路径)
+     * 说明：默认使用%TEMP%\evanOS.sock
+     */
+    par.add("socket", 'k', "specify the Unix socket path for --serve/--attach.", false, std::string(""));
+    
+    /**
+     * foreground参数 - 在当前进程中运行采集服务器
+     * 说明：与--serve配合使用，不再派生后台进程
+     */
+    par.add("foreground", 'F', "run --serve in the current process instead of detaching.");
+
     /**
      * 动态添加功能参数
      * 遍历funcMap，将所有功能参数添加到解析器中
@@ -253,13 +689,66 @@ int main(int argc, char **argv) {
         evan::globalConfig.config_byte_unit_set(type);
     }
 
+    /**
+     * 应用监控进程自身的资源控制
+     * 在开始采集之前设置，对之后创建的并行采集线程和--serve同样生效；
+     * 某一项失败时输出错误并继续运行
+     */
+    if (par.exist("cpu-affinity") || par.exist("sched-class") || par.exist("io-idle") || par.exist("numa-node")) {
+        evan::ProcessControls controls;
+        if (par.exist("cpu-affinity")) {
+            controls.cpu_list = par.get<std::string>("cpu-affinity");
+        }
+        if (par.exist("sched-class") && !evan::evos_sched_class_parse(par.get<std::string>("sched-class"), controls.sched_class)) {
+            printf("Error: Unknown scheduling class: %s (expected idle, batch or normal)\n",
+                   par.get<std::string>("sched-class").c_str());
+            return 1;
+        }
+        controls.io_idle = par.exist("io-idle");
+        if (par.exist("numa-node")) {
+            controls.numa_node = static_cast<int>(par.get<unsigned int>("numa-node"));
+        }
+        evan::evos_process_controls_apply(controls);
+    }
+
+    /**
+     * 设置procfs格式的数据根目录，必须在创建并行采集线程之前
+     */
+    if (par.exist("proc-root")) {
+        evan::evos_proc_root_set(par.get<std::string>("proc-root"));
+    }
+    if (par.exist("capture-proc")) {
+        return evan::evos_proc_capture_run(par.get<std::string>("capture-proc"));
+    }
+
+    /**
+     * 检查是否运行采集服务器或附加到采集服务器
+     * 两种模式都会一直运行，不再执行下面的单次/循环显示
+     */
+    if (par.exist("serve") || par.exist("attach")) {
+        std::string socketPath = par.exist("socket") ? par.get<std::string>("socket") : std::string();
+        if (socketPath.empty()) {
+            socketPath = evan::remote_default_socket_path();
+        }
+        
+        if (par.exist("attach")) {
+            return evan::evos_attach_run(socketPath);
+        }
+        if (par.exist("foreground")) {
+            return evan::evos_serve_run(socketPath);
+        }
+        return evan::evos_serve_detach(socketPath);
+    }
+
     /**
      * 检查是否查询特定进程信息
      * 如果用户使用--inquire参数，显示指定进程的详细信息
      */
+    if (par.exist("inquire-batch")) {
+        return evan::evos_inquire_batch_run(par.get<std::string>("inquire-batch"));
+    }
     if (par.exist("inquire")) {
-        // 注意：get函数在C++11中无法推导返回类型，这里简化处理
-        unsigned long pid = evan::PID_MIN;  ///< 进程ID
+        unsigned long pid = par.get<unsigned long>("inquire");  ///< 进程ID
         
         // 直接在这里实现权限处理逻辑，避免调用可能有问题的函数
         printf("\n[Process Information - PID: %lu]\n", pid);
@@ -292,17 +781,121 @@ int main(int argc, char **argv) {
             }
             CloseHandle(hProcess);  ///< 关闭进程句柄
         }
+        if (par.exist("perf-counters")) {
+            evan::evos_perf_counters_inquire(pid);
+        }
         return 0;  ///< 退出程序
     }
     
+    /**
+     * 启动时构建一次执行计划（选中的采集器及其依赖的数据源），并按--jobs创建并行执行器
+     * 只选中一个功能或--jobs 1时在主线程中依次执行，不创建线程
+     */
+    evan::CollectorRegistry collectors;
+    evan::evos_builtin_collectors_register(collectors);
+    if (par.exist("perf-counters")) {
+        std::vector<evan::PerfTarget> perfTargets;
+        if (par.exist("perf-target") &&
+            !evan::evos_perf_targets_parse(par.get<std::string>("perf-target"), perfTargets)) {
+            return 1;
+        }
+        collectors.add(evan::evos_perf_counters_collector_create(perfTargets));
+    }
+    // --alerts、--anomalies和--leaks共用同一个告警输出（只打开一次文件、套接字或命令）
+    std::shared_ptr<evan::AlertSink> alertSink;
+    if (par.exist("alert-sink") && (par.exist("alerts") || par.exist("anomalies") || par.exist("leaks"))) {
+        alertSink = evan::evos_alert_sink_create(par.get<std::string>("alert-sink"));
+        if (!alertSink) {
+            return 1;
+        }
+    }
+    if (par.exist("alerts")) {
+        std::unique_ptr<evan::AlertRuleSet> rules(new evan::AlertRuleSet());
+        if (par.exist("rules") && !rules->load(par.get<std::string>("rules"))) {
+            return 1;
+        }
+        // 未指定--alert-sink时告警事件写入标准输出
+        collectors.add(evan::evos_alerts_collector_create(rules.release(), alertSink));
+    }
+    if (par.exist("anomalies")) {
+        // 只有显式指定--alert-sink时才输出JSON行，否则只在控制台显示
+        const double threshold = par.exist("anomaly-threshold") ? par.get<double>("anomaly-threshold")
+                                                                : evan::DEFAULT_ANOMALY_THRESHOLD;
+        const unsigned int top = par.exist("anomaly-top") ? par.get<unsigned int>("anomaly-top") : 0;
+        collectors.add(evan::evos_anomalies_collector_create(threshold, top, alertSink));
+    }
+    if (par.exist("leaks")) {
+        const double rate = par.exist("leak-rate") ? par.get<double>("leak-rate") : evan::DEFAULT_LEAK_RATE_MB_PER_HOUR;
+        const unsigned int minutes = par.exist("leak-duration") ? par.get<unsigned int>("leak-duration")
+                                                                : evan::DEFAULT_LEAK_DURATION_MIN;
+        collectors.add(evan::evos_leaks_collector_create(rate * 1024.0 * 1024.0 / 3600.0,
+                                                         static_cast<unsigned long long>(minutes) * 60000, alertSink));
+    }
+    evan::CollectorPlan plan;
+    evan::evos_plan_build(collectors, [&par](const std::string& arg) {
+        return par.exist("all") || par.exist(arg);
+    }, plan);
+    
+    unsigned int jobs = par.exist("jobs") ? par.get<unsigned int>("jobs") : evan::DEFAULT_JOBS;
+    if (jobs == 0 || jobs > plan.size()) {
+        jobs = static_cast<unsigned int>(plan.size());
+    }
+    if (jobs > evan::MAX_JOBS) {
+        jobs = evan::MAX_JOBS;
+    }
+    std::unique_ptr<evan::utils::Executor> executor;
+    if (jobs > 1 && !par.exist("changes-only")) {
+        executor.reset(new evan::utils::Executor(jobs));
+    }
+    
     /**
      * 检查是否需要循环执行
      * 如果用户使用--loop参数，按指定间隔循环执行程序
      */
     if (par.exist("loop")) {
-        // 注意：get函数在C++11中无法推导返回类型，这里简化处理
-        unsigned int loopCount = evan::MIN_TIME;  ///< 循环次数
+        unsigned int loopCount = par.get<unsigned int>("loop");  ///< 循环次数
+        if (loopCount < evan::MIN_TIME) {
+            loopCount = evan::MIN_TIME;
+        }
+        
+        /**
+         * 增量输出模式
+         * 输出通常被重定向到文件，不清屏，只输出变化超过阈值的字段和进程行
+         */
+        const bool changesOnly = par.exist("changes-only");
+        evan::ChangeTracker tracker(
+            par.exist("change-threshold") ? par.get<unsigned int>("change-threshold") : evan::DEFAULT_CHANGE_THRESHOLD,
+            par.exist("keyframe") ? par.get<unsigned int>("keyframe") : evan::DEFAULT_KEYFRAME_INTERVAL);
+        evan::TickScheduler scheduler(std::chrono::milliseconds(1000));  ///< 每秒一次
+        
         while (loopCount--) {
+            evan::evos_tick_reset();  ///< 回收上一次循环的快照内存（内存块保留复用）
+            
+            if (changesOnly) {
+                const bool keyframe = tracker.beginTick(stdout);
+                evan::TickSources sources(evan::evos_tick_arena());
+                evan::evos_plan_load(plan, sources);
+                for (size_t i = 0; i < plan.size(); ++i) {
+                    evan::Collector* collector = plan[i];
+                    evan::utils::AllocScope allocScope(collector->name());  ///< 分配计入当前采集器
+                    evan::utils::LatencyTimer timer(plan.latency(i));
+                    
+                    // 不支持字段级跟踪的采集器只在关键帧中完整显示
+                    if (!collector->watch(sources, tracker, evan::globalConfig) && keyframe) {
+                        collector->display(sources, evan::globalConfig);
+                    }
+                }
+                {
+                    static evan::utils::MetricHistogram& changesTime =
+                        evan::utils::MetricsRegistry::instance().latency("sink.changes_us");
+                    evan::utils::AllocScope allocScope("sink.changes");
+                    evan::utils::LatencyTimer timer(changesTime);
+                    tracker.endTick(stdout);
+                }
+                scheduler.wait();
+                continue;
+            }
+            
             system("cls");  ///< 清屏，为下次显示做准备
             
             // 检查是否需要执行端口扫描
@@ -315,31 +908,11 @@ int main(int argc, char **argv) {
                 // 执行端口扫描
                 evan::evos_port_scan_display(host, start_port, end_port);
             } else {
-                // 直接执行功能函数，不使用lambda
-                for (std::map<std::string, evan::ArguFunc>::const_iterator it = evan::funcMap.begin(); it != evan::funcMap.end(); ++it) {
-                    const std::string& arg = it->first;  ///< 命令行参数名
-                    const evan::ArguFunc& arf = it->second;  ///< 参数对应的功能信息
-                    if (par.exist("all") || par.exist(arg)) {
-                        // 手动执行对应功能，因为FuncPtr类型不匹配
-                        if (arg == "perf") {
-                            evan::evos_system_performance_display(evan::globalConfig);
-                        } else if (arg == "sys") {
-                            evan::evos_system_info_display(evan::globalConfig);
-                        } else if (arg == "total") {
-                            evan::evos_memory_total_display(evan::globalConfig);
-                        } else if (arg == "each") {
-                            evan::evos_process_enum_display(evan::globalConfig);
-                        } else if (arg == "hardware") {
-                            evan::evos_hardware_info_display(evan::globalConfig);
-                        } else if (arf.func != NULL) {
-                            arf.func();  ///< 调用对应的功能函数
-                        }
-                    }
-                }
+                evan::evos_plan_run(plan, executor.get());
             }
             
             printf("[LEFT TIME]:%d", loopCount);  ///< 显示剩余时间
-            Sleep(1000);    ///< 等待1秒
+            scheduler.wait();
         }
     } else {
         /**
@@ -373,28 +946,12 @@ int main(int argc, char **argv) {
             // 执行端口扫描
             evan::evos_port_scan_display(host, start_port, end_port);
         } else {
-            // 直接执行功能函数，不使用lambda
-            for (std::map<std::string, evan::ArguFunc>::const_iterator it = evan::funcMap.begin(); it != evan::funcMap.end(); ++it) {
-                const std::string& arg = it->first;  ///< 命令行参数名
-                const evan::ArguFunc& arf = it->second;  ///< 参数对应的功能信息
-                if (par.exist("all") || par.exist(arg)) {
-                    // 手动执行对应功能，因为FuncPtr类型不匹配
-                        if (arg == "perf") {
-                            evan::evos_system_performance_display(evan::globalConfig);
-                        } else if (arg == "sys") {
-                            evan::evos_system_info_display(evan::globalConfig);
-                        } else if (arg == "total") {
-                            evan::evos_memory_total_display(evan::globalConfig);
-                        } else if (arg == "each") {
-                            evan::evos_process_enum_display(evan::globalConfig);
-                        } else if (arg == "hardware") {
-                            evan::evos_hardware_info_display(evan::globalConfig);
-                        } else if (arf.func != NULL) {
-                            arf.func();  ///< 调用对应的功能函数
-                        }
-                }
-            }
+            evan::evos_plan_run(plan, executor.get());
         }
     }
+    
+    if (par.exist("stats")) {
+        evan::evos_self_stats_display();
+    }
     return 0;  ///< 程序正常退出
 }
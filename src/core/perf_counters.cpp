@@ -0,0 +1,354 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "core/perf_counters.h"
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <windows.h>
+#include "core/collector.h"
+#include "utils/format.h"
+#include "utils/string_utils.h"
+
+namespace evan {
+    /**
+     * 解析计数目标列表
+     * @param spec 逗号分隔的PID
+     * @param targets [out] 目标
+     * @return 全部解析成功返回true
+     */
+    bool evos_perf_targets_parse(const std::string& spec, std::vector<PerfTarget>& targets) {
+        utils::StringUtils::SplitIterator fields(spec, ',');
+        utils::StringView field;
+        while (fields.next(field)) {
+            field = utils::StringUtils::trimView(field);
+            if (field.empty()) {
+                continue;
+            }
+
+            PerfTarget target;
+            target.pid = 0;
+            if (utils::StringUtils::parseNumber(field, target.pid) != field.size() || target.pid == 0) {
+                EVAN_FPRINT(stderr, "Error: Invalid perf target '{}' (expected a PID).\n", field);
+                return false;
+            }
+            targets.push_back(target);
+        }
+        return true;
+    }
+
+    PerfCounterSampler::PerfCounterSampler() : ntQuerySystemInformation(nullptr), hardware_(false) {
+    }
+
+    PerfCounterSampler::~PerfCounterSampler() {
+        close();
+    }
+
+    namespace {
+        /**
+         * SystemProcessInformation信息类编号
+         */
+        const int SYSTEM_PROCESS_INFORMATION_CLASS = 5;
+
+        /**
+         * 缓冲区不足时NtQuerySystemInformation返回的状态
+         */
+        const long STATUS_INFO_LENGTH_MISMATCH_CODE = static_cast<long>(0xC0000004L);
+
+        /**
+         * ntdll返回的线程信息（与SYSTEM_THREAD_INFORMATION布局一致）
+         */
+        struct ThreadInformation {
+            LARGE_INTEGER kernel_time;
+            LARGE_INTEGER user_time;
+            LARGE_INTEGER create_time;
+            ULONG wait_time;
+            void* start_address;
+            HANDLE unique_process;
+            HANDLE unique_thread;
+            LONG priority;
+            LONG base_priority;
+            ULONG context_switches;
+            ULONG thread_state;
+            ULONG wait_reason;
+        };
+
+        /**
+         * ntdll返回的进程信息（与SYSTEM_PROCESS_INFORMATION布局一致，之后紧跟number_of_threads个线程信息）
+         */
+        struct ProcessInformation {
+            ULONG next_entry_offset;
+            ULONG number_of_threads;
+            LARGE_INTEGER working_set_private_size;
+            ULONG hard_fault_count;
+            ULONG number_of_threads_high_watermark;
+            ULONGLONG cycle_time;
+            LARGE_INTEGER create_time;
+            LARGE_INTEGER user_time;
+            LARGE_INTEGER kernel_time;
+            USHORT image_name_length;
+            USHORT image_name_maximum_length;
+            wchar_t* image_name_buffer;
+            LONG base_priority;
+            HANDLE unique_process_id;
+            HANDLE inherited_from_unique_process_id;
+            ULONG handle_count;
+            ULONG session_id;
+            ULONG_PTR unique_process_key;
+            SIZE_T peak_virtual_size;
+            SIZE_T virtual_size;
+            ULONG page_fault_count;
+            // 之后的内存和I/O计数不使用
+        };
+
+        /**
+         * 进程信息之后的线程信息偏移（x64与x86上SYSTEM_PROCESS_INFORMATION的大小）
+         */
+        const size_t PROCESS_INFORMATION_SIZE = sizeof(void*) == 8 ? 256 : 184;
+    }
+
+    /**
+     * 打开所有目标的计数器
+     * @param targets 目标
+     * @return 成功返回true
+     *
+     * 实现：不需要为每个进程打开句柄，受保护的进程同样可以读取
+     */
+    bool PerfCounterSampler::open(const std::vector<PerfTarget>& targets) {
+        close();
+        targets_ = targets;
+        hardware_ = false;
+
+        HMODULE ntdll = GetModuleHandle(TEXT("ntdll.dll"));
+        if (ntdll == nullptr) {
+            return false;
+        }
+        ntQuerySystemInformation = (NtQuerySystemInformation_t)GetProcAddress(ntdll, "NtQuerySystemInformation");
+        return ntQuerySystemInformation != nullptr && !targets_.empty();
+    }
+
+    /**
+     * 读取所有目标的累计计数
+     * @param readings [out] 每个目标一项
+     * @return 成功返回true
+     */
+    bool PerfCounterSampler::sample(std::vector<PerfReading>& readings) {
+        readings.resize(targets_.size());
+        for (size_t t = 0; t < readings.size(); ++t) {
+            memset(&readings[t], 0, sizeof(readings[t]));
+        }
+        if (ntQuerySystemInformation == nullptr) {
+            return false;
+        }
+
+        // 进程和线程数量会变化，缓冲区不足时按返回的长度加余量重试
+        if (buffer.empty()) {
+            buffer.resize(512 * 1024);
+        }
+        LONG status;
+        for (;;) {
+            ULONG returned = 0;
+            status = ntQuerySystemInformation(SYSTEM_PROCESS_INFORMATION_CLASS, buffer.data(),
+                                              static_cast<ULONG>(buffer.size()), &returned);
+            if (status != STATUS_INFO_LENGTH_MISMATCH_CODE) {
+                break;
+            }
+            buffer.resize((returned > buffer.size() ? returned : buffer.size()) + 64 * 1024);
+        }
+        if (status < 0) {
+            return false;
+        }
+
+        size_t offset = 0;
+        for (;;) {
+            const ProcessInformation& process = *reinterpret_cast<const ProcessInformation*>(buffer.data() + offset);
+            const unsigned long pid = static_cast<unsigned long>(reinterpret_cast<ULONG_PTR>(process.unique_process_id));
+            for (size_t t = 0; t < targets_.size(); ++t) {
+                if (targets_[t].pid != pid) {
+                    continue;
+                }
+
+                PerfReading& reading = readings[t];
+                reading.valid = true;
+                reading.values[PERF_CYCLES] = process.cycle_time;
+                reading.values[PERF_TASK_CLOCK] =
+                    static_cast<unsigned long long>(process.user_time.QuadPart + process.kernel_time.QuadPart) * 100;
+                reading.values[PERF_PAGE_FAULTS] = process.page_fault_count;
+                const ThreadInformation* threads = reinterpret_cast<const ThreadInformation*>(
+                    buffer.data() + offset + PROCESS_INFORMATION_SIZE);
+                for (ULONG i = 0; i < process.number_of_threads; ++i) {
+                    reading.values[PERF_CONTEXT_SWITCHES] += threads[i].context_switches;
+                }
+                reading.available[PERF_CYCLES] = true;
+                reading.available[PERF_TASK_CLOCK] = true;
+                reading.available[PERF_CONTEXT_SWITCHES] = true;
+                reading.available[PERF_PAGE_FAULTS] = true;
+            }
+
+            if (process.next_entry_offset == 0) {
+                break;
+            }
+            offset += process.next_entry_offset;
+        }
+        return true;
+    }
+
+    /**
+     * 关闭所有计数器（Windows上没有需要关闭的句柄）
+     */
+    void PerfCounterSampler::close() {
+        targets_.clear();
+    }
+
+    /**
+     * 写入一个计数单元格，不可用时写入n/a
+     */
+    template <size_t N>
+    static void evos_perf_cell(utils::StackBuffer<N>& cell, bool available, unsigned long long value) {
+        cell.clear();
+        if (available) {
+            EVAN_FORMAT(cell, "{}", value);
+        } else {
+            EVAN_FORMAT(cell, "n/a");
+        }
+    }
+
+    /**
+     * 写入一个比率单元格，任一计数不可用或分母为0时写入n/a
+     * @param scale 比率的倍数（百分比为100）
+     */
+    template <size_t N>
+    static void evos_perf_ratio_cell(utils::StackBuffer<N>& cell, bool available,
+                                     unsigned long long numerator, unsigned long long denominator, double scale) {
+        cell.clear();
+        if (available && denominator > 0) {
+            EVAN_FORMAT(cell, "{:.2f}", static_cast<double>(numerator) / static_cast<double>(denominator) * scale);
+        } else {
+            EVAN_FORMAT(cell, "n/a");
+        }
+    }
+
+    /**
+     * 显示两次采样之间的计数
+     * @param targets 目标
+     * @param before 开始时的计数
+     * @param after 结束时的计数
+     * @param hardware 是否有硬件事件可用
+     */
+    void evos_perf_counters_report(const std::vector<PerfTarget>& targets, const std::vector<PerfReading>& before,
+                                   const std::vector<PerfReading>& after, bool hardware) {
+        EVAN_PRINT("\n[Performance Counters]\n");
+        EVAN_PRINT("-----------------------------------------------\n");
+        if (!hardware) {
+            EVAN_PRINT("\tHardware events unavailable, showing software events only.\n");
+        }
+        EVAN_PRINT("\t{:<24} {:>14} {:>14} {:>6} {:>8} {:>8}", "Target", "Cycles", "Instructions", "IPC", "Cache%", "Branch%");
+        EVAN_PRINT(" {:>10} {:>8} {:>8}\n", "CPU(ms)", "CtxSw", "Faults");
+
+        utils::StackBuffer<64> label;
+        utils::StackBuffer<24> cells[8];
+        for (size_t t = 0; t < targets.size() && t < before.size() && t < after.size(); ++t) {
+            label.clear();
+            EVAN_FORMAT(label, "{}", targets[t].pid);
+            if (!after[t].valid) {
+                EVAN_PRINT("\t{:<24} not found or exited\n", label.view());
+                continue;
+            }
+
+            unsigned long long delta[PERF_EVENT_COUNT];
+            bool available[PERF_EVENT_COUNT];
+            for (int e = 0; e < PERF_EVENT_COUNT; ++e) {
+                available[e] = before[t].available[e] && after[t].available[e];
+                delta[e] = available[e] && after[t].values[e] >= before[t].values[e]
+                    ? after[t].values[e] - before[t].values[e] : 0;
+            }
+
+            evos_perf_cell(cells[0], available[PERF_CYCLES], delta[PERF_CYCLES]);
+            evos_perf_cell(cells[1], available[PERF_INSTRUCTIONS], delta[PERF_INSTRUCTIONS]);
+            evos_perf_ratio_cell(cells[2], available[PERF_CYCLES] && available[PERF_INSTRUCTIONS],
+                                 delta[PERF_INSTRUCTIONS], delta[PERF_CYCLES], 1.0);
+            evos_perf_ratio_cell(cells[3], available[PERF_CACHE_MISSES] && available[PERF_CACHE_REFERENCES],
+                                 delta[PERF_CACHE_MISSES], delta[PERF_CACHE_REFERENCES], 100.0);
+            evos_perf_ratio_cell(cells[4], available[PERF_BRANCH_MISSES] && available[PERF_BRANCHES],
+                                 delta[PERF_BRANCH_MISSES], delta[PERF_BRANCHES], 100.0);
+            evos_perf_ratio_cell(cells[5], available[PERF_TASK_CLOCK], delta[PERF_TASK_CLOCK], 1000000, 1.0);
+            evos_perf_cell(cells[6], available[PERF_CONTEXT_SWITCHES], delta[PERF_CONTEXT_SWITCHES]);
+            evos_perf_cell(cells[7], available[PERF_PAGE_FAULTS], delta[PERF_PAGE_FAULTS]);
+
+            EVAN_PRINT("\t{:<24} {:>14} {:>14} {:>6} {:>8} {:>8}", label.view(),
+                       cells[0].view(), cells[1].view(), cells[2].view(), cells[3].view(), cells[4].view());
+            EVAN_PRINT(" {:>10} {:>8} {:>8}\n", cells[5].view(), cells[6].view(), cells[7].view());
+        }
+    }
+
+    /**
+     * 测量一个进程的计数并显示
+     * @param pid 进程ID
+     */
+    void evos_perf_counters_inquire(unsigned long pid) {
+        std::vector<PerfTarget> targets(1);
+        targets[0].pid = pid;
+
+        PerfCounterSampler sampler;
+        std::vector<PerfReading> before;
+        std::vector<PerfReading> after;
+        if (!sampler.open(targets) || !sampler.sample(before)) {
+            EVAN_PRINT("\tWarning: Unable to open performance counters for PID {}.\n", pid);
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(PERF_INQUIRE_WINDOW_MS));
+        sampler.sample(after);
+        evos_perf_counters_report(sampler.targets(), before, after, sampler.hardware());
+    }
+
+    namespace {
+    /**
+     * 性能计数器采集器
+     * 计数器在第一次显示时打开并在采集器的生命周期内保持打开，每次显示与上一次之间的增量
+     */
+    class PerfCountersCollector : public Collector {
+    public:
+        explicit PerfCountersCollector(const std::vector<PerfTarget>& targets) : targets(targets), opened(false) {}
+
+        const char* name() const override { return "perf-counters"; }
+
+        void display(const TickSources&, const Configuration&) override {
+            if (targets.empty()) {
+                EVAN_PRINT("\n[Performance Counters]\n\tNo targets, use --perf-target <pid,...>.\n");
+                return;
+            }
+            if (!opened) {
+                opened = true;
+                if (!sampler.open(targets) || !sampler.sample(previous)) {
+                    EVAN_PRINT("\n[Performance Counters]\n\tWarning: Unable to open performance counters.\n");
+                    return;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(PERF_BASELINE_MS));
+            }
+            if (previous.empty()) {
+                return;
+            }
+
+            sampler.sample(current);
+            evos_perf_counters_report(sampler.targets(), previous, current, sampler.hardware());
+            previous.swap(current);
+        }
+
+    private:
+        std::vector<PerfTarget> targets;
+        PerfCounterSampler sampler;
+        std::vector<PerfReading> previous;
+        std::vector<PerfReading> current;
+        bool opened;
+    };
+    }
+
+    /**
+     * 创建性能计数器采集器
+     * @param targets 目标
+     * @return 采集器
+     */
+    Collector* evos_perf_counters_collector_create(const std::vector<PerfTarget>& targets) {
+        return new PerfCountersCollector(targets);
+    }
+}
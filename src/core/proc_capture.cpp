@@ -0,0 +1,154 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "core/proc_capture.h"
+#include <vector>
+#include "core/collector.h"
+#include "core/procfs_source.h"
+#include "core/system_monitor.h"
+#include "utils/format.h"
+#include "utils/tar_archive.h"
+
+namespace evan {
+    /**
+     * 复制的单个文件的最大长度（cpuinfo每个处理器约1KB）
+     */
+    static const size_t CAPTURE_FILE_MAX = 512 * 1024;
+
+    /**
+     * 根目录下原样复制的文件
+     */
+    static const char* const CAPTURE_ROOT_FILES[] = {"meminfo", "cpuinfo", "stat"};
+
+    /**
+     * 每个进程目录下原样复制的文件
+     */
+    static const char* const CAPTURE_PROCESS_FILES[] = {"status", "stat", "cmdline", "cgroup"};
+
+    /**
+     * 从procfs格式的根目录原样复制文件（不存在的文件跳过，如已经退出的进程）
+     * @param root 根目录或归档
+     * @param writer 归档
+     * @param processes 根目录下的进程（只使用PID）
+     * @return 复制的进程数，写入失败返回-1
+     */
+    static long evos_proc_capture_copy(const std::string& root, utils::TarWriter& writer, const ProcessList& processes) {
+        std::vector<char> buffer(CAPTURE_FILE_MAX);
+        for (size_t i = 0; i < sizeof(CAPTURE_ROOT_FILES) / sizeof(CAPTURE_ROOT_FILES[0]); ++i) {
+            const utils::StringView content = evos_procfs_file_read(root, CAPTURE_ROOT_FILES[i], buffer.data(), buffer.size());
+            if (!content.empty() && !writer.add(CAPTURE_ROOT_FILES[i], content)) {
+                return -1;
+            }
+        }
+
+        long captured = 0;
+        utils::StackBuffer<64> name;
+        for (size_t p = 0; p < processes.size(); ++p) {
+            bool any = false;
+            for (size_t i = 0; i < sizeof(CAPTURE_PROCESS_FILES) / sizeof(CAPTURE_PROCESS_FILES[0]); ++i) {
+                name.clear();
+                EVAN_FORMAT(name, "{}/{}", processes[p].pid, CAPTURE_PROCESS_FILES[i]);
+                const utils::StringView content = evos_procfs_file_read(root, name.view(), buffer.data(), buffer.size());
+                if (content.empty()) {
+                    continue;
+                }
+                if (!writer.add(name.view(), content)) {
+                    return -1;
+                }
+                any = true;
+            }
+            if (any) {
+                ++captured;
+            }
+        }
+        return captured;
+    }
+
+    /**
+     * 根据本机的数据源生成procfs格式的文件
+     * @param sources 本次读取的数据源
+     * @param writer 归档
+     * @return 生成的进程数，写入失败返回-1
+     *
+     * 实现：只生成--proc-root读取的字段。页面文件大小包含物理内存，交换区为两者之差；
+     *       无法访问的进程不写VmRSS，回放时同样显示为无法访问
+     */
+    static long evos_proc_capture_synthesize(const TickSources& sources, utils::TarWriter& writer) {
+        std::string content;
+        utils::StringSink sink(content);
+
+        const MEMORYSTATUSEX& memory = sources.memory_status;
+        const unsigned long long swapTotal = memory.ullTotalPageFile > memory.ullTotalPhys
+            ? memory.ullTotalPageFile - memory.ullTotalPhys : 0;
+        const unsigned long long swapUsed = memory.ullTotalPageFile - memory.ullAvailPageFile > memory.ullTotalPhys - memory.ullAvailPhys
+            ? (memory.ullTotalPageFile - memory.ullAvailPageFile) - (memory.ullTotalPhys - memory.ullAvailPhys) : 0;
+        EVAN_FORMAT(sink, "MemTotal:       {:>8} kB\nMemFree:        {:>8} kB\nMemAvailable:   {:>8} kB\n",
+                    memory.ullTotalPhys / 1024, memory.ullAvailPhys / 1024, memory.ullAvailPhys / 1024);
+        EVAN_FORMAT(sink, "SwapTotal:      {:>8} kB\nSwapFree:       {:>8} kB\n",
+                    swapTotal / 1024, (swapTotal > swapUsed ? swapTotal - swapUsed : 0) / 1024);
+        if (!writer.add("meminfo", content)) {
+            return -1;
+        }
+
+        content.clear();
+        for (DWORD cpu = 0; cpu < sources.system_info.dwNumberOfProcessors; ++cpu) {
+            EVAN_FORMAT(sink, "processor\t: {}\n\n", cpu);
+        }
+        if (!writer.add("cpuinfo", content)) {
+            return -1;
+        }
+
+        utils::StackBuffer<64> name;
+        for (size_t i = 0; i < sources.processes.size(); ++i) {
+            const ProcessSample& sample = sources.processes[i];
+            content.clear();
+            EVAN_FORMAT(sink, "Name:\t{}\nPid:\t{}\n", sample.name, sample.pid);
+            if (sample.accessible) {
+                EVAN_FORMAT(sink, "VmRSS:\t{:>8} kB\nVmSwap:\t{:>8} kB\n", sample.working_set / 1024, sample.pagefile / 1024);
+            }
+
+            name.clear();
+            EVAN_FORMAT(name, "{}/status", sample.pid);
+            if (!writer.add(name.view(), content)) {
+                return -1;
+            }
+        }
+        return static_cast<long>(sources.processes.size());
+    }
+
+    /**
+     * 把当前数据源保存为procfs格式的归档
+     * @param output 归档路径
+     * @return 进程退出码
+     */
+    int evos_proc_capture_run(const std::string& output) {
+        utils::Arena& arena = evos_tick_arena();
+        TickSources sources(arena);
+        const DataSourceMask required = SOURCE_MEMORY_STATUS | SOURCE_SYSTEM_INFO | SOURCE_PROCESS_TABLE;
+        if (!evos_tick_sources_load(required, sources, arena)) {
+            EVAN_FPRINT(stderr, "Error: Unable to read the data sources to capture.\n");
+            evos_tick_reset();
+            return 1;
+        }
+
+        utils::TarWriter writer;
+        if (!writer.open(output)) {
+            EVAN_FPRINT(stderr, "Error: Unable to create archive '{}'.\n", output.c_str());
+            evos_tick_reset();
+            return 1;
+        }
+
+        const std::string& root = evos_proc_root();
+        const long captured = root.empty()
+            ? evos_proc_capture_synthesize(sources, writer)
+            : evos_proc_capture_copy(root, writer, sources.processes);
+        evos_tick_reset();
+
+        if (!writer.close() || captured < 0) {
+            EVAN_FPRINT(stderr, "Error: Unable to write archive '{}'.\n", output.c_str());
+            return 1;
+        }
+        EVAN_PRINT("Captured {} processes to {}\n", captured, output.c_str());
+        return 0;
+    }
+}
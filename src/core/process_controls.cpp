@@ -0,0 +1,240 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "core/process_controls.h"
+#include "core/system_monitor.h"
+#include "utils/format.h"
+#include "utils/string_utils.h"
+
+namespace evan {
+    /**
+     * CPU列表最多包含的项数
+     */
+    static const size_t CPU_LIST_MAX_ITEMS = 64;
+
+    /**
+     * 实际应用的资源控制，供--stats显示
+     */
+    struct AppliedControls {
+        ProcessControls requested;  ///< 请求的资源控制
+        bool affinity_ok;           ///< 亲和性（含NUMA节点）是否应用成功
+        bool sched_ok;              ///< 调度类别是否应用成功
+        bool io_idle_ok;            ///< 后台模式是否应用成功
+
+        AppliedControls() : affinity_ok(true), sched_ok(true), io_idle_ok(true) {}
+    };
+
+    static AppliedControls appliedControls;
+
+    /**
+     * 解析CPU列表
+     * @param list CPU列表
+     * @param mask [out] CPU掩码
+     * @return 格式正确返回true
+     */
+    bool evos_cpu_list_parse(const std::string& list, unsigned long long& mask) {
+        utils::StringView items[CPU_LIST_MAX_ITEMS];
+        const size_t count = utils::StringUtils::splitView(list, ',', items, CPU_LIST_MAX_ITEMS);
+        if (count == 0 || count > CPU_LIST_MAX_ITEMS) {
+            return false;
+        }
+
+        unsigned long long result = 0;
+        for (size_t i = 0; i < count; ++i) {
+            utils::StringView item = utils::StringUtils::trimView(items[i]);
+            unsigned int first = 0;
+            size_t used = utils::StringUtils::parseNumber(item, first);
+            if (used == 0) {
+                return false;
+            }
+
+            unsigned int last = first;
+            if (used < item.size()) {
+                // 范围形式"a-b"
+                if (item[used] != '-') {
+                    return false;
+                }
+                const utils::StringView rest = item.substr(used + 1);
+                if (utils::StringUtils::parseNumber(rest, last) != rest.size() || rest.empty()) {
+                    return false;
+                }
+            }
+            if (last < first || last >= 64) {
+                return false;
+            }
+
+            for (unsigned int cpu = first; cpu <= last; ++cpu) {
+                result |= 1ULL << cpu;
+            }
+        }
+
+        mask = result;
+        return true;
+    }
+
+    /**
+     * 解析调度类别名称
+     * @param name 名称
+     * @param sched [out] 调度类别
+     * @return 名称有效返回true
+     */
+    bool evos_sched_class_parse(const std::string& name, SchedClass& sched) {
+        const std::string lower = utils::StringUtils::toLower(name);
+        if (lower == "idle") {
+            sched = SCHED_CLASS_IDLE;
+        } else if (lower == "batch") {
+            sched = SCHED_CLASS_BATCH;
+        } else if (lower == "normal") {
+            sched = SCHED_CLASS_NORMAL;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * 获取调度类别名称
+     */
+    static const char* evos_sched_class_name(SchedClass sched) {
+        switch (sched) {
+            case SCHED_CLASS_IDLE:
+                return "idle";
+            case SCHED_CLASS_BATCH:
+                return "batch";
+            default:
+                return "normal";
+        }
+    }
+
+    /**
+     * 获取优先级类别名称
+     */
+    static const char* evos_priority_class_name(DWORD priorityClass) {
+        switch (priorityClass) {
+            case IDLE_PRIORITY_CLASS:
+                return "Idle";
+            case BELOW_NORMAL_PRIORITY_CLASS:
+                return "Below Normal";
+            case NORMAL_PRIORITY_CLASS:
+                return "Normal";
+            case ABOVE_NORMAL_PRIORITY_CLASS:
+                return "Above Normal";
+            case HIGH_PRIORITY_CLASS:
+                return "High";
+            case REALTIME_PRIORITY_CLASS:
+                return "Realtime";
+            default:
+                return "Unknown";
+        }
+    }
+
+    /**
+     * 应用CPU亲和性和NUMA节点
+     * Windows按线程理想处理器所在的节点分配内存，
+     * 把进程限制在节点的处理器上即可让新分配的内存落在该节点
+     * @param controls 资源控制
+     * @return 成功返回true
+     */
+    static bool evos_affinity_apply(const ProcessControls& controls) {
+        unsigned long long mask = ~0ULL;
+        if (!controls.cpu_list.empty() && !evos_cpu_list_parse(controls.cpu_list, mask)) {
+            EVAN_PRINT("Error: Invalid CPU list: {}\n", controls.cpu_list);
+            return false;
+        }
+
+        if (controls.numa_node != NUMA_NODE_ANY) {
+            ULONG highestNode = 0;
+            ULONGLONG nodeMask = 0;
+            if (!GetNumaHighestNodeNumber(&highestNode)) {
+                evos_error_print("GetNumaHighestNodeNumber");
+                return false;
+            }
+            if (controls.numa_node < 0 || static_cast<ULONG>(controls.numa_node) > highestNode) {
+                EVAN_PRINT("Error: NUMA node {} does not exist (highest node is {}).\n", controls.numa_node, highestNode);
+                return false;
+            }
+            if (!GetNumaNodeProcessorMask(static_cast<UCHAR>(controls.numa_node), &nodeMask)) {
+                evos_error_print("GetNumaNodeProcessorMask");
+                return false;
+            }
+            mask &= nodeMask;
+        }
+
+        DWORD_PTR processMask = 0;
+        DWORD_PTR systemMask = 0;
+        if (!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask)) {
+            evos_error_print("GetProcessAffinityMask");
+            return false;
+        }
+        mask &= static_cast<unsigned long long>(systemMask);
+        if (mask == 0) {
+            EVAN_PRINT("Error: No usable CPU left after applying --cpu-affinity/--numa-node.\n");
+            return false;
+        }
+
+        if (!SetProcessAffinityMask(GetCurrentProcess(), static_cast<DWORD_PTR>(mask))) {
+            evos_error_print("SetProcessAffinityMask");
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * 应用资源控制
+     * @param controls 资源控制
+     * @return 全部应用成功返回true
+     */
+    bool evos_process_controls_apply(const ProcessControls& controls) {
+        appliedControls = AppliedControls();
+        appliedControls.requested = controls;
+
+        if (!controls.cpu_list.empty() || controls.numa_node != NUMA_NODE_ANY) {
+            appliedControls.affinity_ok = evos_affinity_apply(controls);
+        }
+
+        if (controls.sched_class != SCHED_CLASS_NORMAL) {
+            const DWORD priorityClass = controls.sched_class == SCHED_CLASS_IDLE ?
+                                        IDLE_PRIORITY_CLASS : BELOW_NORMAL_PRIORITY_CLASS;
+            if (!SetPriorityClass(GetCurrentProcess(), priorityClass)) {
+                evos_error_print("SetPriorityClass");
+                appliedControls.sched_ok = false;
+            }
+        }
+
+        // 后台模式把I/O优先级降为Very Low、内存页优先级降低，需在设置优先级类别之后进入
+        if (controls.io_idle) {
+            if (!SetPriorityClass(GetCurrentProcess(), PROCESS_MODE_BACKGROUND_BEGIN)) {
+                evos_error_print("SetPriorityClass(PROCESS_MODE_BACKGROUND_BEGIN)");
+                appliedControls.io_idle_ok = false;
+            }
+        }
+
+        return appliedControls.affinity_ok && appliedControls.sched_ok && appliedControls.io_idle_ok;
+    }
+
+    /**
+     * 显示实际生效的资源控制
+     *
+     * 实现：亲和性和优先级类别从系统读回，其余显示请求值及应用结果
+     */
+    void evos_process_controls_display() {
+        const ProcessControls& requested = appliedControls.requested;
+
+        DWORD_PTR processMask = 0;
+        DWORD_PTR systemMask = 0;
+        if (GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask)) {
+            EVAN_PRINT("\tCPU Affinity: 0x{:X} of 0x{:X}{}.\n",
+                       static_cast<unsigned long long>(processMask), static_cast<unsigned long long>(systemMask),
+                       !appliedControls.affinity_ok ? " (requested setting failed)" : "");
+        }
+        if (requested.numa_node != NUMA_NODE_ANY) {
+            EVAN_PRINT("\tNUMA Node: {}{}.\n", requested.numa_node, appliedControls.affinity_ok ? "" : " (failed)");
+        }
+
+        EVAN_PRINT("\tPriority Class: {} (--sched-class {}{}).\n",
+                   evos_priority_class_name(GetPriorityClass(GetCurrentProcess())),
+                   evos_sched_class_name(requested.sched_class), appliedControls.sched_ok ? "" : ", failed");
+        EVAN_PRINT("\tBackground I/O Mode: {}.\n",
+                   !requested.io_idle ? "off" : (appliedControls.io_idle_ok ? "on" : "failed"));
+    }
+}
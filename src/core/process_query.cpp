@@ -0,0 +1,166 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "core/process_query.h"
+#include <algorithm>
+#include <cstdio>
+#include "core/collector.h"
+#include "core/system_monitor.h"
+#include "utils/format.h"
+#include "utils/string_utils.h"
+
+namespace evan {
+    /**
+     * 一个查询
+     */
+    struct BatchQuery {
+        utils::StringView text;   ///< 原始查询（去掉首尾空白）
+        bool by_pid;              ///< 是否按PID查询
+        unsigned long pid;        ///< by_pid为true时的PID
+    };
+
+    typedef utils::ArenaVector<BatchQuery> BatchQueryList;
+
+    /**
+     * 按PID排序进程表的比较函数
+     */
+    static bool evos_sample_pid_less(const ProcessSample& sample, unsigned long pid) {
+        return sample.pid < pid;
+    }
+
+    /**
+     * 写入JSON字符串（含引号，转义引号、反斜杠和控制字符）
+     * @param sink 输出目标
+     * @param str 字符串
+     */
+    void evos_json_string_write(utils::FormatSink& sink, utils::StringView str) {
+        static const char HEX[] = "0123456789abcdef";
+        sink.write("\"", 1);
+        size_t plain = 0;
+        for (size_t i = 0; i < str.size(); ++i) {
+            const unsigned char ch = static_cast<unsigned char>(str[i]);
+            if (ch >= 0x20 && ch != '"' && ch != '\\') {
+                continue;
+            }
+            sink.write(str.data() + plain, i - plain);
+            plain = i + 1;
+            if (ch == '"' || ch == '\\') {
+                const char escaped[2] = {'\\', static_cast<char>(ch)};
+                sink.write(escaped, 2);
+            } else {
+                const char escaped[6] = {'\\', 'u', '0', '0', HEX[ch >> 4], HEX[ch & 0x0F]};
+                sink.write(escaped, 6);
+            }
+        }
+        sink.write(str.data() + plain, str.size() - plain);
+        sink.write("\"", 1);
+    }
+
+    /**
+     * 读取所有查询
+     * @param file 输入文件
+     * @param arena 保存查询文本的Arena
+     * @param queries [out] 查询列表
+     */
+    static void evos_batch_queries_read(FILE* file, utils::Arena& arena, BatchQueryList& queries) {
+        char buffer[512];
+        std::string line;
+        while (fgets(buffer, sizeof(buffer), file) != nullptr) {
+            line.append(buffer);
+            // 超过缓冲区的长行分多次读入
+            if (line.empty() || (line[line.size() - 1] != '\n' && !feof(file))) {
+                continue;
+            }
+
+            const utils::StringView text = utils::StringUtils::trimView(line);
+            if (!text.empty() && text[0] != '#') {
+                BatchQuery query;
+                query.text = arena.copy(text);
+                query.pid = 0;
+                query.by_pid = utils::StringUtils::parseNumber(text, query.pid) == text.size();
+                queries.push_back(query);
+            }
+            line.clear();
+        }
+    }
+
+    /**
+     * 输出一个匹配的进程
+     * @param sink 输出目标
+     * @param query 查询
+     * @param sample 进程采样
+     */
+    static void evos_batch_match_write(utils::FormatSink& sink, const BatchQuery& query, const ProcessSample& sample) {
+        sink.write("{\"query\":", 9);
+        evos_json_string_write(sink, query.text);
+        EVAN_FORMAT(sink, ",\"pid\":{},\"name\":", sample.pid);
+        evos_json_string_write(sink, sample.name);
+        EVAN_FORMAT(sink, ",\"working_set\":{},\"pagefile\":{},\"accessible\":{}}}\n",
+                    sample.working_set, sample.pagefile, sample.accessible);
+    }
+
+    /**
+     * 批量查询进程
+     * @param source 查询文件路径，"-"表示标准输入
+     * @return 进程退出码
+     *
+     * 实现：先读完所有查询再获取一次进程快照（CreateToolhelp32Snapshot，或--proc-root目录），快照按PID排序后
+     *       PID查询用二分查找，名称查询遍历快照；查询文本和快照都在Arena中，不逐条分配
+     */
+    int evos_inquire_batch_run(const std::string& source) {
+        const bool fromStdin = source == "-";
+        FILE* file = fromStdin ? stdin : fopen(source.c_str(), "r");
+        if (file == nullptr) {
+            EVAN_FPRINT(stderr, "Error: Unable to open query file '{}'.\n", source.c_str());
+            return 1;
+        }
+
+        utils::Arena& arena = evos_tick_arena();
+        BatchQueryList queries((utils::ArenaAllocator<BatchQuery>(arena)));
+        evos_batch_queries_read(file, arena, queries);
+        if (!fromStdin) {
+            fclose(file);
+        }
+
+        TickSources sources(arena);
+        if (!evos_tick_sources_load(SOURCE_PROCESS_TABLE, sources, arena)) {
+            return 1;
+        }
+        ProcessList& processes = sources.processes;
+        std::sort(processes.begin(), processes.end(), [](const ProcessSample& a, const ProcessSample& b) {
+            return a.pid < b.pid;
+        });
+
+        utils::FileSink out(stdout);
+        for (size_t q = 0; q < queries.size(); ++q) {
+            const BatchQuery& query = queries[q];
+            bool found = false;
+
+            if (query.by_pid) {
+                ProcessList::const_iterator it = std::lower_bound(processes.begin(), processes.end(),
+                                                                  query.pid, evos_sample_pid_less);
+                if (it != processes.end() && it->pid == query.pid) {
+                    evos_batch_match_write(out, query, *it);
+                    found = true;
+                }
+            } else {
+                for (size_t i = 0; i < processes.size(); ++i) {
+                    if (utils::StringUtils::wildcardMatch(processes[i].name, query.text, true)) {
+                        evos_batch_match_write(out, query, processes[i]);
+                        found = true;
+                    }
+                }
+            }
+
+            if (!found) {
+                out.write("{\"query\":", 9);
+                evos_json_string_write(out, query.text);
+                out.write(",\"error\":\"not found\"}\n", 22);
+            }
+        }
+        out.flush();
+
+        evos_tick_reset();
+        return 0;
+    }
+}
@@ -0,0 +1,376 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "core/procfs_source.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "utils/format.h"
+#include "utils/string_utils.h"
+#include "utils/tar_archive.h"
+
+namespace evan {
+    /**
+     * procfs格式的数据根目录
+     */
+    static std::string procRoot;
+
+    /**
+     * 单个procfs文件的最大读取长度（status约1.5KB，meminfo约1.5KB）
+     */
+    static const size_t PROCFS_FILE_MAX = 8 * 1024;
+
+    /**
+     * cpuinfo的最大读取长度（每个处理器约1KB）
+     */
+    static const size_t PROCFS_CPUINFO_MAX = 512 * 1024;
+
+    /**
+     * 作为根目录打开的归档（--capture-proc的输出）
+     * 按路径排序的索引指向映射的归档，读取文件不需要复制
+     */
+    struct ProcArchive {
+        std::string path;
+        utils::TarReader reader;
+        std::vector<std::pair<std::string, utils::StringView> > files;
+        bool valid;
+
+        ProcArchive() : valid(false) {}
+    };
+
+    static ProcArchive procArchive;
+    static std::mutex procArchiveMutex;
+
+    static bool evos_procfs_entry_less(const std::pair<std::string, utils::StringView>& entry, utils::StringView name) {
+        return utils::StringView(entry.first) < name;
+    }
+
+    /**
+     * 根目录是否是归档
+     * @param root 根目录
+     */
+    static bool evos_procfs_is_archive(const std::string& root) {
+        return root.size() > 4 && root.compare(root.size() - 4, 4, ".tar") == 0;
+    }
+
+    /**
+     * 获取作为根目录的归档（第一次使用时打开并建立索引，根目录改变时重新打开）
+     * @param root 归档路径
+     * @return 归档，无法打开返回nullptr
+     */
+    static const ProcArchive* evos_procfs_archive(const std::string& root) {
+        std::lock_guard<std::mutex> lock(procArchiveMutex);
+        if (procArchive.path != root) {
+            procArchive.path = root;
+            procArchive.files.clear();
+            procArchive.valid = procArchive.reader.open(root);
+
+            utils::TarEntry entry;
+            while (procArchive.valid && procArchive.reader.next(entry)) {
+                procArchive.files.push_back(std::make_pair(entry.name, entry.data));
+            }
+            std::sort(procArchive.files.begin(), procArchive.files.end());
+        }
+        return procArchive.valid ? &procArchive : nullptr;
+    }
+
+    /**
+     * 设置procfs格式的数据根目录
+     * @param root 根目录
+     */
+    void evos_proc_root_set(const std::string& root) {
+        procRoot = root;
+    }
+
+    /**
+     * 获取procfs格式的数据根目录
+     */
+    const std::string& evos_proc_root() {
+        return procRoot;
+    }
+
+    /**
+     * 读取整个文件（procfs文件不能可靠地获取大小，按块读到缓冲区满或文件结束）
+     * @param path 文件路径
+     * @param buffer 缓冲区
+     * @param capacity 缓冲区大小
+     * @return 读到的内容，失败返回空视图
+     */
+    static utils::StringView evos_procfs_read(const char* path, char* buffer, size_t capacity) {
+        FILE* file = fopen(path, "rb");
+        if (file == nullptr) {
+            return utils::StringView();
+        }
+        size_t length = 0;
+        while (length < capacity) {
+            const size_t n = fread(buffer + length, 1, capacity - length, file);
+            if (n == 0) {
+                break;
+            }
+            length += n;
+        }
+        fclose(file);
+        return utils::StringView(buffer, length);
+    }
+
+    /**
+     * 读取根目录下的文件
+     * @param root 根目录或归档
+     * @param relative 相对路径
+     * @param buffer 缓冲区
+     * @param capacity 缓冲区大小
+     * @return 文件内容，失败返回空视图
+     */
+    utils::StringView evos_procfs_file_read(const std::string& root, utils::StringView relative, char* buffer, size_t capacity) {
+        if (evos_procfs_is_archive(root)) {
+            const ProcArchive* archive = evos_procfs_archive(root);
+            if (archive == nullptr) {
+                return utils::StringView();
+            }
+            std::vector<std::pair<std::string, utils::StringView> >::const_iterator it =
+                std::lower_bound(archive->files.begin(), archive->files.end(), relative, evos_procfs_entry_less);
+            if (it == archive->files.end() || !(utils::StringView(it->first) == relative)) {
+                return utils::StringView();
+            }
+            return it->second.size() <= capacity ? it->second : it->second.substr(0, capacity);
+        }
+
+        utils::StackBuffer<512> path;
+        EVAN_FORMAT(path, "{}/{}", root, relative);
+        if (path.truncated()) {
+            return utils::StringView();
+        }
+        return evos_procfs_read(path.c_str(), buffer, capacity);
+    }
+
+    /**
+     * 解析"键: 值"格式的一行
+     * @param line 行
+     * @param key [out] 键
+     * @param value [out] 值（去掉首尾空白）
+     * @return 有冒号返回true
+     */
+    static bool evos_procfs_field(utils::StringView line, utils::StringView& key, utils::StringView& value) {
+        const size_t colon = line.find(':');
+        if (colon == utils::StringView::npos) {
+            return false;
+        }
+        key = utils::StringUtils::trimView(line.substr(0, colon));
+        value = utils::StringUtils::trimView(line.substr(colon + 1));
+        return true;
+    }
+
+    /**
+     * 解析以kB为单位的值
+     * @param value 值，如"123456 kB"
+     * @return 字节数（第一个单词不是数值时为0）
+     */
+    static unsigned long long evos_procfs_kb(utils::StringView value) {
+        utils::StringUtils::WordIterator words(value);
+        utils::StringView number;
+        unsigned long long kb = 0;
+        if (words.next(number) && utils::StringUtils::parseNumber(number, kb) != number.size()) {
+            kb = 0;
+        }
+        return kb * 1024;
+    }
+
+    /**
+     * 遍历目录
+     * @param path 目录路径
+     * @param visit 对每个条目调用visit(名称)，不包括"."和".."
+     * @return 目录可以打开返回true
+     */
+    template <typename Visitor>
+    static bool evos_directory_list(const std::string& path, Visitor visit) {
+        if (evos_procfs_is_archive(path)) {
+            // 归档中只有文件，顶层目录由路径的第一段得到（索引已排序，同一目录的文件相邻）
+            const ProcArchive* archive = evos_procfs_archive(path);
+            if (archive == nullptr) {
+                return false;
+            }
+            utils::StringView previous;
+            for (size_t i = 0; i < archive->files.size(); ++i) {
+                const utils::StringView name(archive->files[i].first);
+                const size_t slash = name.find('/');
+                if (slash == utils::StringView::npos) {
+                    continue;
+                }
+                const utils::StringView directory = name.substr(0, slash);
+                if (!(directory == previous)) {
+                    visit(directory);
+                    previous = directory;
+                }
+            }
+            return true;
+        }
+        // 搜索模式在栈上拼接，每次循环列出目录时不分配内存
+        utils::StackBuffer<512> pattern;
+        EVAN_FORMAT(pattern, "{}\\*", path);
+        if (pattern.truncated()) {
+            return false;
+        }
+        WIN32_FIND_DATAA entry;
+        HANDLE find = FindFirstFileA(pattern.c_str(), &entry);
+        if (find == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        do {
+            if (strcmp(entry.cFileName, ".") != 0 && strcmp(entry.cFileName, "..") != 0) {
+                visit(utils::StringView(entry.cFileName));
+            }
+        } while (FindNextFileA(find, &entry));
+        FindClose(find);
+        return true;
+    }
+
+    /**
+     * 从<root>/meminfo读取内存状态
+     * @param root 根目录
+     * @param status [out] 内存状态
+     * @return 成功返回true
+     */
+    bool evos_procfs_memory_load(const std::string& root, MEMORYSTATUSEX& status) {
+        char buffer[PROCFS_FILE_MAX];
+        const utils::StringView content = evos_procfs_file_read(root, "meminfo", buffer, sizeof(buffer));
+        if (content.empty()) {
+            return false;
+        }
+
+        unsigned long long total = 0;
+        unsigned long long free = 0;
+        unsigned long long available = 0;
+        unsigned long long swapTotal = 0;
+        unsigned long long swapFree = 0;
+        bool hasAvailable = false;
+
+        utils::StringUtils::SplitIterator lines(content, '\n');
+        utils::StringView line;
+        while (lines.next(line)) {
+            utils::StringView key;
+            utils::StringView value;
+            if (!evos_procfs_field(line, key, value)) {
+                continue;
+            }
+            if (key == "MemTotal") {
+                total = evos_procfs_kb(value);
+            } else if (key == "MemFree") {
+                free = evos_procfs_kb(value);
+            } else if (key == "MemAvailable") {
+                available = evos_procfs_kb(value);
+                hasAvailable = true;
+            } else if (key == "SwapTotal") {
+                swapTotal = evos_procfs_kb(value);
+            } else if (key == "SwapFree") {
+                swapFree = evos_procfs_kb(value);
+            }
+        }
+        if (total == 0) {
+            return false;
+        }
+        if (!hasAvailable) {
+            available = free;
+        }
+
+        memset(&status, 0, sizeof(status));
+        status.dwLength = sizeof(status);
+        status.ullTotalPhys = total;
+        status.ullAvailPhys = available < total ? available : total;
+        status.ullTotalPageFile = total + swapTotal;
+        status.ullAvailPageFile = status.ullAvailPhys + swapFree;
+        status.dwMemoryLoad = static_cast<DWORD>((total - status.ullAvailPhys) * 100 / total);
+        return true;
+    }
+
+    /**
+     * 从<root>/cpuinfo读取处理器数量
+     * @param root 根目录
+     * @param arena 读取cpuinfo的缓冲区所在的Arena
+     * @param info [out] 系统信息
+     * @return 成功返回true
+     */
+    bool evos_procfs_system_info_load(const std::string& root, utils::Arena& arena, SYSTEM_INFO& info) {
+        char* buffer = arena.allocateArray<char>(PROCFS_CPUINFO_MAX);
+        const utils::StringView content = evos_procfs_file_read(root, "cpuinfo", buffer, PROCFS_CPUINFO_MAX);
+
+        DWORD processors = 0;
+        utils::StringUtils::SplitIterator lines(content, '\n');
+        utils::StringView line;
+        while (lines.next(line)) {
+            utils::StringView key;
+            utils::StringView value;
+            if (evos_procfs_field(line, key, value) && key == "processor") {
+                ++processors;
+            }
+        }
+        if (processors == 0) {
+            return false;
+        }
+
+        memset(&info, 0, sizeof(info));
+        info.wProcessorArchitecture = 9;  // PROCESSOR_ARCHITECTURE_AMD64
+        info.dwPageSize = 4096;
+        info.dwAllocationGranularity = 64 * 1024;
+        info.dwNumberOfProcessors = processors;
+        info.dwActiveProcessorMask = processors >= sizeof(DWORD_PTR) * 8
+            ? ~static_cast<DWORD_PTR>(0)
+            : (static_cast<DWORD_PTR>(1) << processors) - 1;
+        return true;
+    }
+
+    /**
+     * 从<root>/<pid>/status读取所有进程
+     * @param root 根目录
+     * @param arena 保存进程名的Arena
+     * @param processes [out] 进程列表（追加）
+     * @return 根目录可以读取返回true
+     *
+     * 实现：只读取status一个文件（名称、VmRSS、VmSwap都在其中），读到的文件在栈上的缓冲区中解析，
+     *       只有进程名被复制到Arena；读取失败的进程（已经退出）直接跳过
+     */
+    bool evos_procfs_processes_load(const std::string& root, utils::Arena& arena, ProcessList& processes) {
+        char buffer[PROCFS_FILE_MAX];
+        utils::StackBuffer<64> relative;
+        return evos_directory_list(root, [&](utils::StringView entry) {
+            unsigned long pid = 0;
+            if (utils::StringUtils::parseNumber(entry, pid) != entry.size()) {
+                return;
+            }
+
+            relative.clear();
+            EVAN_FORMAT(relative, "{}/status", entry);
+            const utils::StringView content = evos_procfs_file_read(root, relative.view(), buffer, sizeof(buffer));
+            if (content.empty()) {
+                return;
+            }
+
+            ProcessSample sample;
+            sample.pid = pid;
+            sample.working_set = 0;
+            sample.pagefile = 0;
+            sample.accessible = false;
+
+            utils::StringUtils::SplitIterator lines(content, '\n');
+            utils::StringView line;
+            while (lines.next(line)) {
+                utils::StringView key;
+                utils::StringView value;
+                if (!evos_procfs_field(line, key, value)) {
+                    continue;
+                }
+                if (key == "Name") {
+                    sample.name = arena.copy(value);
+                } else if (key == "VmRSS") {
+                    sample.working_set = evos_procfs_kb(value);
+                    sample.accessible = true;
+                } else if (key == "VmSwap") {
+                    sample.pagefile = evos_procfs_kb(value);
+                }
+            }
+            processes.push_back(sample);
+        });
+    }
+}
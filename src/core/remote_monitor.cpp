@@ -0,0 +1,356 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "core/remote_monitor.h"
+#include "utils/metrics.h"
+#include <winsock2.h>
+#include <afunix.h>
+#include <windows.h>
+#include <cstdio>
+#include <cstring>
+
+#pragma comment(lib, "ws2_32.lib")
+
+namespace evan {
+
+namespace {
+    /**
+     * 将百分比编码为0.01%单位的整数
+     */
+    uint16_t encodeCenti(float percent) {
+        if (!(percent > 0.0f)) {
+            return 0;
+        }
+        if (percent >= 100.0f) {
+            return 10000;
+        }
+        return static_cast<uint16_t>(percent * 100.0f + 0.5f);
+    }
+
+    /**
+     * 填充Unix域套接字地址
+     * @return 路径过长返回false
+     */
+    bool makeAddress(const std::string& path, SOCKADDR_UN& address) {
+        if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+            return false;
+        }
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        memcpy(address.sun_path, path.c_str(), path.size());
+        return true;
+    }
+
+    /**
+     * 阻塞接收指定字节数
+     * @return 完整接收返回true
+     */
+    bool receiveAll(SOCKET sock, char* buffer, size_t length) {
+        while (length > 0) {
+            int received = recv(sock, buffer, static_cast<int>(length), 0);
+            if (received <= 0) {
+                return false;
+            }
+            buffer += received;
+            length -= static_cast<size_t>(received);
+        }
+        return true;
+    }
+}
+
+/**
+ * 获取默认的套接字路径
+ * @return 套接字路径
+ */
+std::string remote_default_socket_path() {
+    char temp[MAX_PATH];
+    DWORD length = GetTempPathA(sizeof(temp), temp);
+    if (length == 0 || length >= sizeof(temp)) {
+        return "evanOS.sock";
+    }
+    return std::string(temp, length) + "evanOS.sock";
+}
+
+/**
+ * 将快照编码为帧
+ * @param snapshot 快照
+ * @param frame [out] 帧缓冲区
+ */
+void remote_frame_encode(const MonitorSnapshot& snapshot, std::vector<char>& frame) {
+    const size_t cores = snapshot.core_usage.size() > 0xFFFF ? 0xFFFF : snapshot.core_usage.size();
+
+    FrameHeader header;
+    header.magic = FRAME_MAGIC;
+    header.version = FRAME_VERSION;
+    header.core_count = static_cast<uint16_t>(cores);
+    header.timestamp_ms = snapshot.timestamp_ms;
+    header.memory_centi = encodeCenti(snapshot.memory_percent);
+    header.swap_centi = encodeCenti(snapshot.swap_percent);
+    header.reserved = 0;
+
+    frame.resize(sizeof(header) + cores * sizeof(uint16_t));
+    memcpy(frame.data(), &header, sizeof(header));
+
+    uint16_t* values = reinterpret_cast<uint16_t*>(frame.data() + sizeof(header));
+    for (size_t i = 0; i < cores; ++i) {
+        values[i] = encodeCenti(snapshot.core_usage[i]);
+    }
+}
+
+/**
+ * 构造函数
+ */
+MonitorServer::MonitorServer() :
+    listen_socket(INVALID_SOCKET), wsa_started(false), dropped_frames(0) {
+}
+
+/**
+ * 析构函数
+ */
+MonitorServer::~MonitorServer() {
+    stop();
+}
+
+/**
+ * 开始监听
+ * @param path 套接字路径
+ * @return 是否成功
+ */
+bool MonitorServer::start(const std::string& path) {
+    SOCKADDR_UN address;
+    if (!makeAddress(path, address)) {
+        printf("Error: Invalid socket path: %s\n", path.c_str());
+        return false;
+    }
+
+    WSADATA wsaData;
+    int wsaerr = WSAStartup(MAKEWORD(2, 2), &wsaData);
+    if (wsaerr != 0) {
+        printf("Error: Failed to initialize Winsock. Error code: %d\n", wsaerr);
+        return false;
+    }
+    wsa_started = true;
+
+    SOCKET sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock == INVALID_SOCKET) {
+        printf("Error: Failed to create socket. Error code: %d\n", WSAGetLastError());
+        stop();
+        return false;
+    }
+    listen_socket = sock;
+
+    // 上一次运行残留的套接字文件会导致bind失败
+    DeleteFileA(path.c_str());
+
+    if (bind(sock, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == SOCKET_ERROR ||
+        listen(sock, SOMAXCONN) == SOCKET_ERROR) {
+        printf("Error: Failed to listen on %s. Error code: %d\n", path.c_str(), WSAGetLastError());
+        stop();
+        return false;
+    }
+
+    u_long mode = 1; // 1 = non-blocking mode
+    ioctlsocket(sock, FIONBIO, &mode);
+
+    socket_path = path;
+    clients.reserve(MAX_ATTACH_CLIENTS);
+    return true;
+}
+
+/**
+ * 接受所有等待中的连接（非阻塞）
+ */
+void MonitorServer::acceptClients() {
+    if (listen_socket == INVALID_SOCKET) {
+        return;
+    }
+
+    for (;;) {
+        SOCKET client = accept(static_cast<SOCKET>(listen_socket), nullptr, nullptr);
+        if (client == INVALID_SOCKET) {
+            break;
+        }
+
+        if (clients.size() >= MAX_ATTACH_CLIENTS) {
+            closesocket(client);
+            continue;
+        }
+
+        // 广播时不能被单个客户端阻塞
+        u_long mode = 1;
+        ioctlsocket(client, FIONBIO, &mode);
+        clients.push_back(client);
+    }
+}
+
+/**
+ * 向所有客户端广播快照
+ * 帧只编码一次，所有客户端共享同一缓冲区
+ * @param snapshot 快照
+ * @return 成功发送的客户端数量
+ */
+size_t MonitorServer::broadcast(const MonitorSnapshot& snapshot) {
+    static utils::MetricCounter& bytesExported = utils::MetricsRegistry::instance().counter("remote.bytes_exported");
+    static utils::MetricCounter& framesDropped = utils::MetricsRegistry::instance().counter("remote.frames_dropped");
+    remote_frame_encode(snapshot, frame);
+
+    size_t delivered = 0;
+    size_t i = 0;
+    while (i < clients.size()) {
+        int sent = send(static_cast<SOCKET>(clients[i]), frame.data(), static_cast<int>(frame.size()), 0);
+
+        if (sent == static_cast<int>(frame.size())) {
+            bytesExported.add(frame.size());
+            ++delivered;
+            ++i;
+            continue;
+        }
+
+        if (sent == SOCKET_ERROR && WSAGetLastError() == WSAEWOULDBLOCK) {
+            // 客户端处理过慢，丢弃本帧，下一帧再试
+            ++dropped_frames;
+            framesDropped.add();
+            ++i;
+            continue;
+        }
+
+        // 连接已断开，或只发送了部分帧（流已无法同步），移除该客户端
+        closesocket(static_cast<SOCKET>(clients[i]));
+        clients[i] = clients.back();
+        clients.pop_back();
+    }
+
+    return delivered;
+}
+
+/**
+ * 停止监听并断开所有客户端
+ */
+void MonitorServer::stop() {
+    for (size_t i = 0; i < clients.size(); ++i) {
+        closesocket(static_cast<SOCKET>(clients[i]));
+    }
+    clients.clear();
+
+    if (listen_socket != INVALID_SOCKET) {
+        closesocket(static_cast<SOCKET>(listen_socket));
+        listen_socket = INVALID_SOCKET;
+    }
+
+    if (!socket_path.empty()) {
+        DeleteFileA(socket_path.c_str());
+        socket_path.clear();
+    }
+
+    if (wsa_started) {
+        WSACleanup();
+        wsa_started = false;
+    }
+}
+
+/**
+ * 构造函数
+ */
+MonitorClient::MonitorClient() :
+    client_socket(INVALID_SOCKET), wsa_started(false) {
+}
+
+/**
+ * 析构函数
+ */
+MonitorClient::~MonitorClient() {
+    disconnect();
+}
+
+/**
+ * 连接到服务器
+ * @param path 套接字路径
+ * @return 是否成功
+ */
+bool MonitorClient::connect(const std::string& path) {
+    SOCKADDR_UN address;
+    if (!makeAddress(path, address)) {
+        printf("Error: Invalid socket path: %s\n", path.c_str());
+        return false;
+    }
+
+    WSADATA wsaData;
+    int wsaerr = WSAStartup(MAKEWORD(2, 2), &wsaData);
+    if (wsaerr != 0) {
+        printf("Error: Failed to initialize Winsock. Error code: %d\n", wsaerr);
+        return false;
+    }
+    wsa_started = true;
+
+    SOCKET sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock == INVALID_SOCKET) {
+        printf("Error: Failed to create socket. Error code: %d\n", WSAGetLastError());
+        disconnect();
+        return false;
+    }
+    client_socket = sock;
+
+    if (::connect(sock, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == SOCKET_ERROR) {
+        printf("Error: Failed to attach to %s. Error code: %d\n", path.c_str(), WSAGetLastError());
+        disconnect();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * 阻塞接收下一帧
+ * @param snapshot [out] 快照
+ * @return 成功返回true
+ */
+bool MonitorClient::receive(MonitorSnapshot& snapshot) {
+    if (client_socket == INVALID_SOCKET) {
+        return false;
+    }
+
+    SOCKET sock = static_cast<SOCKET>(client_socket);
+    FrameHeader header;
+    if (!receiveAll(sock, reinterpret_cast<char*>(&header), sizeof(header))) {
+        return false;
+    }
+
+    if (header.magic != FRAME_MAGIC || header.version != FRAME_VERSION) {
+        printf("Error: Unexpected frame from server (magic 0x%08x, version %u).\n",
+               header.magic, static_cast<unsigned int>(header.version));
+        return false;
+    }
+
+    payload.resize(header.core_count);
+    if (header.core_count > 0 &&
+        !receiveAll(sock, reinterpret_cast<char*>(payload.data()), payload.size() * sizeof(uint16_t))) {
+        return false;
+    }
+
+    snapshot.timestamp_ms = header.timestamp_ms;
+    snapshot.memory_percent = header.memory_centi / 100.0f;
+    snapshot.swap_percent = header.swap_centi / 100.0f;
+    snapshot.core_usage.resize(payload.size());
+    for (size_t i = 0; i < payload.size(); ++i) {
+        snapshot.core_usage[i] = payload[i] / 100.0f;
+    }
+
+    return true;
+}
+
+/**
+ * 断开连接
+ */
+void MonitorClient::disconnect() {
+    if (client_socket != INVALID_SOCKET) {
+        closesocket(static_cast<SOCKET>(client_socket));
+        client_socket = INVALID_SOCKET;
+    }
+
+    if (wsa_started) {
+        WSACleanup();
+        wsa_started = false;
+    }
+}
+
+} // namespace evan
@@ -0,0 +1,75 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "core/self_stats.h"
+#include "core/process_controls.h"
+#include "utils/alloc_tracker.h"
+#include "utils/format.h"
+#include "utils/metrics.h"
+
+namespace evan {
+    /**
+     * 显示内存分配统计
+     * 
+     * 实现：读取各作用域标签的计数器快照，未开启EVANOS_ALLOC_TRACKING时只输出提示
+     */
+    static void evos_alloc_stats_display() {
+        if (!utils::AllocTracker::enabled()) {
+            EVAN_PRINT("\tAllocation Tracking: disabled (configure with -DEVANOS_ALLOC_TRACKING=ON).\n");
+            return;
+        }
+        
+        EVAN_PRINT("\tAllocation Tracking: enabled ({}).\n",
+                   utils::AllocTracker::mallocHooked() ? "operator new/delete and malloc" : "operator new/delete only");
+        
+        utils::AllocStats stats[utils::MAX_ALLOC_TAGS];
+        const size_t count = utils::AllocTracker::snapshot(stats, utils::MAX_ALLOC_TAGS);
+        
+        EVAN_PRINT("\t{:<20} {:>12} {:>14} {:>12} {:>14}\n", "Scope", "Allocs", "Bytes", "Frees", "Live Bytes");
+        for (size_t i = 0; i < count; ++i) {
+            const utils::AllocStats& entry = stats[i];
+            // 跨作用域释放（如malloc的块在其他作用域中free）时存活字节数可能为负
+            const long long live = static_cast<long long>(entry.bytes - entry.freed_bytes);
+            EVAN_PRINT("\t{:<20} {:>12} {:>14} {:>12} {:>14}\n",
+                       entry.tag, entry.allocs, entry.bytes, entry.frees, live);
+        }
+    }
+    
+    /**
+     * 显示内部指标（循环次数、错误数、导出字节数，以及各采集器、数据源、输出和循环的耗时与抖动）
+     * 
+     * 实现：读取时才汇总各线程的分片；直方图的Value列为样本数，p50/p99为桶上界，Max为精确值
+     */
+    static void evos_metrics_display() {
+        const std::vector<utils::MetricEntry> entries = utils::MetricsRegistry::instance().entries();
+        if (entries.empty()) {
+            return;
+        }
+        
+        EVAN_PRINT("\t{:<24} {:>14} {:>10} {:>10} {:>10}\n", "Metric", "Value", "p50", "p99", "Max");
+        for (size_t i = 0; i < entries.size(); ++i) {
+            const utils::MetricEntry& entry = entries[i];
+            if (entry.type == utils::METRIC_COUNTER) {
+                EVAN_PRINT("\t{:<24} {:>14}\n", entry.name, entry.counter->value());
+            } else if (entry.type == utils::METRIC_GAUGE) {
+                EVAN_PRINT("\t{:<24} {:>14}\n", entry.name, entry.gauge->value());
+            } else {
+                utils::HistogramSnapshot snapshot;
+                entry.histogram->snapshot(snapshot);
+                EVAN_PRINT("\t{:<24} {:>14} {:>10} {:>10} {:>10}\n", entry.name, snapshot.count,
+                           snapshot.quantile(0.5), snapshot.quantile(0.99), snapshot.max);
+            }
+        }
+    }
+    
+    /**
+     * 显示evanOS自身的运行统计
+     */
+    void evos_self_stats_display() {
+        EVAN_PRINT("\n[Self Statistics]\n");
+        EVAN_PRINT("-----------------------------------------------\n");
+        evos_process_controls_display();
+        evos_metrics_display();
+        evos_alloc_stats_display();
+    }
+}
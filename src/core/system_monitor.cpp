@@ -2,6 +2,13 @@
 // Licensed under the Apache License, Version 2.0
 
 #include "core/system_monitor.h"
+#include "core/cpu_sampler.h"
+#include "core/gpu_monitor.h"
+#include "core/procfs_source.h"
+#include "ui/history_widgets.h"
+#include "utils/alloc_tracker.h"
+#include "utils/format.h"
+#include "utils/metrics.h"
 #include <winsock2.h>
 #include <ws2tcpip.h>
 #include <iphlpapi.h>
@@ -65,6 +72,27 @@ namespace evan {
         {MEM_PRIVATE, "Private"}   ///< 私有内存（进程私有）
     };
     
+    /**
+     * 本次循环的Arena
+     * 每个线程一个，并行执行的采集器互不干扰
+     */
+    static thread_local utils::Arena tickArena;
+    
+    /**
+     * 获取本次循环的Arena
+     * @return Arena引用
+     */
+    utils::Arena& evos_tick_arena() {
+        return tickArena;
+    }
+    
+    /**
+     * 结束一次循环，回收当前线程本次循环的全部快照内存
+     */
+    void evos_tick_reset() {
+        tickArena.reset();
+    }
+    
     /**
      * 根据架构代码获取架构名称
      * @param arch 架构代码
@@ -113,6 +141,8 @@ namespace evan {
      */
     void evos_error_print(const std::string& funcName) {
         DWORD errorCode = GetLastError();  ///< 获取当前线程的最后一个错误码
+        static utils::MetricCounter& errors = utils::MetricsRegistry::instance().counter("errors");
+        errors.add();
         LPVOID lpMsgBuf = nullptr;         ///< 用于存储错误信息的缓冲区
         
         // 从系统获取错误信息
@@ -127,7 +157,7 @@ namespace evan {
         );
         
         // 打印错误信息
-        printf("Error in %s: %s\n", funcName.c_str(), (LPTSTR)lpMsgBuf);
+        EVAN_PRINT("Error in {}: {}\n", funcName, (LPTSTR)lpMsgBuf);
         
         // 释放系统分配的缓冲区
         LocalFree(lpMsgBuf);
@@ -145,21 +175,107 @@ namespace evan {
         return GlobalMemoryStatusEx(&memoryStatus);
     }
     
+    /**
+     * 读取数据源
+     * @param sources 需要的数据源
+     * @param out [out] 读取结果
+     * @param arena 保存进程名等数据的Arena
+     * @return 全部读取成功返回true
+     * 
+     * 实现：每个数据源只调用一次对应的API，失败的数据源不计入out.loaded；
+     *       设置了--proc-root时改为从procfs格式的目录读取；每个数据源的读取耗时记录到source.*_us直方图
+     */
+    bool evos_tick_sources_load(DataSourceMask sources, TickSources& out, utils::Arena& arena) {
+        out.loaded = 0;
+        const std::string& procRoot = evos_proc_root();
+        
+        static utils::MetricHistogram& memoryTime = utils::MetricsRegistry::instance().latency("source.memory_us");
+        static utils::MetricHistogram& systemInfoTime = utils::MetricsRegistry::instance().latency("source.system_info_us");
+        static utils::MetricHistogram& processTime = utils::MetricsRegistry::instance().latency("source.processes_us");
+        
+        if (sources & SOURCE_MEMORY_STATUS) {
+            utils::LatencyTimer timer(memoryTime);
+            if (!procRoot.empty()) {
+                if (evos_procfs_memory_load(procRoot, out.memory_status)) {
+                    out.loaded |= SOURCE_MEMORY_STATUS;
+                } else {
+                    EVAN_PRINT("Error: Unable to read {}/meminfo.\n", procRoot);
+                }
+            } else if (getMemoryStatus(out.memory_status)) {
+                out.loaded |= SOURCE_MEMORY_STATUS;
+            } else {
+                evos_error_print("GlobalMemoryStatusEx");
+            }
+        }
+        
+        if (sources & SOURCE_SYSTEM_INFO) {
+            utils::LatencyTimer timer(systemInfoTime);
+            if (!procRoot.empty()) {
+                if (evos_procfs_system_info_load(procRoot, arena, out.system_info)) {
+                    out.loaded |= SOURCE_SYSTEM_INFO;
+                } else {
+                    EVAN_PRINT("Error: Unable to read {}/cpuinfo.\n", procRoot);
+                }
+            } else {
+                GetSystemInfo(&out.system_info);
+                out.loaded |= SOURCE_SYSTEM_INFO;
+            }
+        }
+        
+        if (sources & SOURCE_PROCESS_TABLE) {
+            utils::LatencyTimer timer(processTime);
+            out.processes.clear();
+            out.processes.reserve(PROCESS_RESERVE);
+            if (!procRoot.empty()) {
+                if (evos_procfs_processes_load(procRoot, arena, out.processes)) {
+                    out.loaded |= SOURCE_PROCESS_TABLE;
+                } else {
+                    EVAN_PRINT("Error: Unable to list {}.\n", procRoot);
+                }
+            } else if (evos_process_snapshot_collect(arena, out.processes)) {
+                out.loaded |= SOURCE_PROCESS_TABLE;
+            }
+        }
+        
+        return (out.loaded & sources) == sources;
+    }
+    
+    /**
+     * 读取数据源后显示（单独调用显示函数时使用）
+     * @param sources 需要的数据源
+     * @param display 显示函数
+     * @param config 配置实例
+     */
+    static void evos_sources_display(DataSourceMask sources,
+                                     void (*display)(const TickSources&, const Configuration&),
+                                     const Configuration& config) {
+        TickSources tickSources(tickArena);
+        evos_tick_sources_load(sources, tickSources, tickArena);
+        display(tickSources, config);
+    }
+    
     /**
      * 显示总内存信息
      * @param config 配置实例，用于格式化输出
      * 
      * 功能：显示系统总内存、已用内存、可用内存和内存使用率
-     * 实现：使用GlobalMemoryStatusEx函数获取系统内存状态，仅调用一次API
+     * 实现：单独调用时读取一次内存状态；循环中由执行计划统一读取后调用下面的重载
      */
     void evos_memory_total_display(const Configuration& config) {
-        MEMORYSTATUSEX memoryStatus;
-        
-        if (!getMemoryStatus(memoryStatus)) {
-            printf("Error: Failed to retrieve memory status.\n");
-            evos_error_print("GlobalMemoryStatusEx");
+        evos_sources_display(SOURCE_MEMORY_STATUS, &evos_memory_total_display, config);
+    }
+    
+    /**
+     * 显示总内存信息
+     * @param sources 本次循环的数据源（需要SOURCE_MEMORY_STATUS）
+     * @param config 配置实例，用于格式化输出
+     */
+    void evos_memory_total_display(const TickSources& sources, const Configuration& config) {
+        if (!sources.has(SOURCE_MEMORY_STATUS)) {
+            EVAN_PRINT("Error: Failed to retrieve memory status.\n");
             return;
         }
+        const MEMORYSTATUSEX& memoryStatus = sources.memory_status;
         
         // 计算已用物理内存
         const unsigned long long usedPhys = memoryStatus.ullTotalPhys - memoryStatus.ullAvailPhys;
@@ -167,12 +283,12 @@ namespace evan {
         const double memoryUsage = static_cast<double>(usedPhys) / memoryStatus.ullTotalPhys * 100;
         
         // 输出内存信息
-        printf("\n[Total Memory Information]\n");
-        printf("-----------------------------------------------\n");
-        printf("\tTotal Physical Memory: %s.\n", config.config_byte_to_str(memoryStatus.ullTotalPhys).c_str());
-        printf("\tUsed Physical Memory: %s.\n", config.config_byte_to_str(usedPhys).c_str());
-        printf("\tFree Physical Memory: %s.\n", config.config_byte_to_str(memoryStatus.ullAvailPhys).c_str());
-        printf("\tMemory Usage: %.2f%%.\n", memoryUsage);
+        EVAN_PRINT("\n[Total Memory Information]\n");
+        EVAN_PRINT("-----------------------------------------------\n");
+        EVAN_PRINT("\tTotal Physical Memory: {}.\n", config.config_byte_to_str(memoryStatus.ullTotalPhys, tickArena));
+        EVAN_PRINT("\tUsed Physical Memory: {}.\n", config.config_byte_to_str(usedPhys, tickArena));
+        EVAN_PRINT("\tFree Physical Memory: {}.\n", config.config_byte_to_str(memoryStatus.ullAvailPhys, tickArena));
+        EVAN_PRINT("\tMemory Usage: {:.2f}%.\n", memoryUsage);
     }
     
     /**
@@ -180,30 +296,35 @@ namespace evan {
      * @param config 配置实例，用于格式化输出
      * 
      * 功能：显示系统基本信息，包括处理器架构、内存等
-     * 实现：使用GetSystemInfo获取系统硬件信息，使用getMemoryStatus获取内存信息
+     * 实现：系统信息和内存状态来自共享的数据源，与perf/total共用同一次读取
      */
     void evos_system_info_display(const Configuration& config) {
-        SYSTEM_INFO sysInfo;
-        GetSystemInfo(&sysInfo);
-        
-        MEMORYSTATUSEX memoryStatus;
-        
-        if (!getMemoryStatus(memoryStatus)) {
-            printf("Error: Failed to retrieve memory status.\n");
-            evos_error_print("GlobalMemoryStatusEx");
+        evos_sources_display(SOURCE_MEMORY_STATUS | SOURCE_SYSTEM_INFO, &evos_system_info_display, config);
+    }
+    
+    /**
+     * 显示系统基本信息
+     * @param sources 本次循环的数据源（需要SOURCE_MEMORY_STATUS和SOURCE_SYSTEM_INFO）
+     * @param config 配置实例，用于格式化输出
+     */
+    void evos_system_info_display(const TickSources& sources, const Configuration& config) {
+        if (!sources.has(SOURCE_MEMORY_STATUS)) {
+            EVAN_PRINT("Error: Failed to retrieve memory status.\n");
             return;
         }
+        const SYSTEM_INFO& sysInfo = sources.system_info;
+        const MEMORYSTATUSEX& memoryStatus = sources.memory_status;
         
         // 输出系统信息
-        printf("\n[System Information]\n");
-        printf("-----------------------------------------------\n");
-        printf("\tProcessor Architecture: %s.\n", getArchName(sysInfo.wProcessorArchitecture));
-        printf("\tNumber of Processors: %lu.\n", sysInfo.dwNumberOfProcessors);
-        printf("\tPage Size: %lu bytes.\n", sysInfo.dwPageSize);
-        printf("\tMinimum Application Address: 0x%p.\n", sysInfo.lpMinimumApplicationAddress);
-        printf("\tMaximum Application Address: 0x%p.\n", sysInfo.lpMaximumApplicationAddress);
-        printf("\tActive Processor Mask: 0x%lx.\n", sysInfo.dwActiveProcessorMask);
-        printf("\tTotal Physical Memory: %s.\n", config.config_byte_to_str(memoryStatus.ullTotalPhys).c_str());
+        EVAN_PRINT("\n[System Information]\n");
+        EVAN_PRINT("-----------------------------------------------\n");
+        EVAN_PRINT("\tProcessor Architecture: {}.\n", getArchName(sysInfo.wProcessorArchitecture));
+        EVAN_PRINT("\tNumber of Processors: {}.\n", sysInfo.dwNumberOfProcessors);
+        EVAN_PRINT("\tPage Size: {} bytes.\n", sysInfo.dwPageSize);
+        EVAN_PRINT("\tMinimum Application Address: 0x{:p}.\n", sysInfo.lpMinimumApplicationAddress);
+        EVAN_PRINT("\tMaximum Application Address: 0x{:p}.\n", sysInfo.lpMaximumApplicationAddress);
+        EVAN_PRINT("\tActive Processor Mask: 0x{:x}.\n", sysInfo.dwActiveProcessorMask);
+        EVAN_PRINT("\tTotal Physical Memory: {}.\n", config.config_byte_to_str(memoryStatus.ullTotalPhys, tickArena));
     }
     
     /**
@@ -211,19 +332,24 @@ namespace evan {
      * @param config 配置实例，用于格式化输出
      * 
      * 功能：显示系统性能信息，包括内存使用、页面文件等
-     * 实现：使用getMemoryStatus获取内存信息，预计算所有需要的值以提高性能
+     * 实现：内存状态和系统信息来自共享的数据源，预计算所有需要的值以提高性能
      */
     void evos_system_performance_display(const Configuration& config) {
-        MEMORYSTATUSEX memoryStatus;
-        
-        if (!getMemoryStatus(memoryStatus)) {
-            printf("Error: Failed to retrieve memory status.\n");
-            evos_error_print("GlobalMemoryStatusEx");
+        evos_sources_display(SOURCE_MEMORY_STATUS | SOURCE_SYSTEM_INFO, &evos_system_performance_display, config);
+    }
+    
+    /**
+     * 显示系统性能信息
+     * @param sources 本次循环的数据源（需要SOURCE_MEMORY_STATUS和SOURCE_SYSTEM_INFO）
+     * @param config 配置实例，用于格式化输出
+     */
+    void evos_system_performance_display(const TickSources& sources, const Configuration& config) {
+        if (!sources.has(SOURCE_MEMORY_STATUS)) {
+            EVAN_PRINT("Error: Failed to retrieve memory status.\n");
             return;
         }
-        
-        SYSTEM_INFO sysInfo;
-        GetSystemInfo(&sysInfo);
+        const MEMORYSTATUSEX& memoryStatus = sources.memory_status;
+        const SYSTEM_INFO& sysInfo = sources.system_info;
         
         // 预计算所有需要的值，避免重复计算
         const unsigned long totalAppPages = static_cast<unsigned long>(memoryStatus.ullTotalPageFile / sysInfo.dwPageSize);
@@ -233,124 +359,156 @@ namespace evan {
         const unsigned long long usedVirtual = memoryStatus.ullTotalVirtual - memoryStatus.ullAvailVirtual;
         
         // 输出性能信息
-        printf("\n[Performance Information]\n");
-        printf("-----------------------------------------------\n");
-        printf("\tPage Size: %lu bytes.\n", sysInfo.dwPageSize);
-        printf("\tTotal Application Pages: %lu.\n", totalAppPages);
-        printf("\tAvailable Pages: %lu.\n", availPages);
-        printf("\tTotal Physical Pages: %lu.\n", totalPhysPages);
-        printf("\tAvailable Physical Pages: %lu.\n", availPhysPages);
-        printf("\tSystem Cache Size: %s.\n", config.config_byte_to_str(usedVirtual).c_str());
-        printf("\tFree System Memory: %s.\n", config.config_byte_to_str(memoryStatus.ullAvailVirtual).c_str());
-        printf("\tMemory Usage: %lu%%.\n", memoryStatus.dwMemoryLoad);
+        EVAN_PRINT("\n[Performance Information]\n");
+        EVAN_PRINT("-----------------------------------------------\n");
+        EVAN_PRINT("\tPage Size: {} bytes.\n", sysInfo.dwPageSize);
+        EVAN_PRINT("\tTotal Application Pages: {}.\n", totalAppPages);
+        EVAN_PRINT("\tAvailable Pages: {}.\n", availPages);
+        EVAN_PRINT("\tTotal Physical Pages: {}.\n", totalPhysPages);
+        EVAN_PRINT("\tAvailable Physical Pages: {}.\n", availPhysPages);
+        EVAN_PRINT("\tSystem Cache Size: {}.\n", config.config_byte_to_str(usedVirtual, tickArena));
+        EVAN_PRINT("\tFree System Memory: {}.\n", config.config_byte_to_str(memoryStatus.ullAvailVirtual, tickArena));
+        EVAN_PRINT("\tMemory Usage: {}%.\n", memoryStatus.dwMemoryLoad);
     }
     
-    // 显示每个进程信息
-    void evos_process_enum_display(const Configuration& config) {
-        // 使用CreateToolhelp32Snapshot获取进程快照，这是获取系统所有进程的高效方式
+    /**
+     * 采集所有进程的内存信息
+     * @param arena 保存进程名的Arena
+     * @param processes [out] 进程列表（追加）
+     * @return 成功返回true
+     * 
+     * 实现：使用CreateToolhelp32Snapshot获取进程快照，只请求PROCESS_QUERY_LIMITED_INFORMATION权限，
+     *       对于PROCESS_MEMORY_COUNTERS该权限已经足够，无法打开的进程也会列出（accessible为false）
+     */
+    bool evos_process_snapshot_collect(utils::Arena& arena, ProcessList& processes) {
         HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
         if (hSnapshot == INVALID_HANDLE_VALUE) {
-            printf("Error: Unable to create process snapshot.\n");
+            EVAN_PRINT("Error: Unable to create process snapshot.\n");
             evos_error_print("CreateToolhelp32Snapshot");
-            return;
+            return false;
         }
         
         PROCESSENTRY32 pe32;
         pe32.dwSize = sizeof(PROCESSENTRY32);
         
-        // 获取第一个进程信息
         if (!Process32First(hSnapshot, &pe32)) {
-            printf("Error: Unable to get first process.\n");
+            EVAN_PRINT("Error: Unable to get first process.\n");
             evos_error_print("Process32First");
             CloseHandle(hSnapshot);
-            return;
+            return false;
         }
         
-        // 输出表头
-        printf("\n[Process Information]\n");
-        printf("-----------------------------------------------\n");
-        printf("%-*s %-*s %*s %*s\n",
-               PID_SIZE, "PID",
-               PNAME_SIZE, "Process Name",
-               PWORKSET_SIZE, "Working Set",
-               NUM_WIDTH, "Page File(KB)");
-        
-        // 遍历所有进程
         do {
-            // 只请求必要的PROCESS_QUERY_LIMITED_INFORMATION权限，减少权限请求开销
-            // 对于PROCESS_MEMORY_COUNTERS，PROCESS_QUERY_LIMITED_INFORMATION权限已经足够
-            HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION,
-                                          FALSE, pe32.th32ProcessID);
-            if (hProcess == NULL) {
-                // 无法打开进程，可能是权限问题，只显示基本信息
-                printf("%-*lu %-*s %*s %*s\n",
-                   PID_SIZE, pe32.th32ProcessID,
-                   PNAME_SIZE, pe32.szExeFile,
-                   PWORKSET_SIZE, "-",
-                   NUM_WIDTH, "-");
-                continue;
-            }
+            ProcessSample sample;
+            sample.pid = pe32.th32ProcessID;
+            sample.name = arena.copy(pe32.szExeFile);
+            sample.working_set = 0;
+            sample.pagefile = 0;
+            sample.accessible = false;
             
-            // 初始化PROCESS_MEMORY_COUNTERS结构体
-            PROCESS_MEMORY_COUNTERS pmc;
-            pmc.cb = sizeof(pmc);
-            
-            // 获取进程内存信息
-            if (GetProcessMemoryInfo(hProcess, &pmc, sizeof(pmc))) {
-                // 格式化输出进程信息
-                printf("%-*lu %-*s %*s %*ld\n",
-                   PID_SIZE, pe32.th32ProcessID,
-                   PNAME_SIZE, pe32.szExeFile,
-                   PWORKSET_SIZE, config.config_byte_to_str(pmc.WorkingSetSize).c_str(),
-                   NUM_WIDTH, static_cast<long>(pmc.PagefileUsage / 1024));
-            } else {
-                // 获取失败，显示基本信息
-                printf("%-*lu %-*s %*s %*s\n",
-                       PID_SIZE, pe32.th32ProcessID,
-                       PNAME_SIZE, pe32.szExeFile,
-                       PWORKSET_SIZE, "-",
-                       NUM_WIDTH, "-");
+            HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pe32.th32ProcessID);
+            if (hProcess != NULL) {
+                PROCESS_MEMORY_COUNTERS pmc;
+                pmc.cb = sizeof(pmc);
+                if (GetProcessMemoryInfo(hProcess, &pmc, sizeof(pmc))) {
+                    sample.working_set = pmc.WorkingSetSize;
+                    sample.pagefile = pmc.PagefileUsage;
+                    sample.accessible = true;
+                }
+                // 及时关闭进程句柄，释放资源
+                CloseHandle(hProcess);
             }
             
-            // 及时关闭进程句柄，释放资源
-            CloseHandle(hProcess);
+            processes.push_back(sample);
         } while (Process32Next(hSnapshot, &pe32));
         
-        // 关闭进程快照句柄
         CloseHandle(hSnapshot);
+        return true;
+    }
+    
+    // 显示每个进程信息
+    void evos_process_enum_display(const Configuration& config) {
+        evos_sources_display(SOURCE_PROCESS_TABLE, &evos_process_enum_display, config);
+    }
+    
+    /**
+     * 显示每个进程信息
+     * @param sources 本次循环的数据源（需要SOURCE_PROCESS_TABLE）
+     * @param config 配置实例，用于格式化输出
+     */
+    void evos_process_enum_display(const TickSources& sources, const Configuration& config) {
+        if (!sources.has(SOURCE_PROCESS_TABLE)) {
+            return;
+        }
+        const ProcessList& processes = sources.processes;
+        
+        // 输出表头
+        EVAN_PRINT("\n[Process Information]\n");
+        EVAN_PRINT("-----------------------------------------------\n");
+        EVAN_PRINT("{:<*} {:<*} {:>*} {:>*}\n",
+                   PID_SIZE, "PID",
+                   PNAME_SIZE, "Process Name",
+                   PWORKSET_SIZE, "Working Set",
+                   NUM_WIDTH, "Page File(KB)");
+        
+        for (size_t i = 0; i < processes.size(); ++i) {
+            const ProcessSample& process = processes[i];
+            if (process.accessible) {
+                EVAN_PRINT("{:<*} {:<*} {:>*} {:>*}\n",
+                           PID_SIZE, process.pid,
+                           PNAME_SIZE, process.name,
+                           PWORKSET_SIZE, config.config_byte_to_str(process.working_set, tickArena),
+                           NUM_WIDTH, static_cast<long>(process.pagefile / 1024));
+            } else {
+                // 无法打开进程或获取内存信息失败（通常是权限问题），只显示基本信息
+                EVAN_PRINT("{:<*} {:<*} {:>*} {:>*}\n",
+                           PID_SIZE, process.pid,
+                           PNAME_SIZE, process.name,
+                           PWORKSET_SIZE, "-",
+                           NUM_WIDTH, "-");
+            }
+        }
     }
     
     // 显示硬件信息
     void evos_hardware_info_display(const Configuration& config) {
-        printf("\n[Hardware Information]\n");
-        printf("-----------------------------------------------\n");
+        evos_sources_display(SOURCE_SYSTEM_INFO, &evos_hardware_info_display, config);
+    }
+    
+    /**
+     * 显示硬件信息
+     * @param sources 本次循环的数据源（需要SOURCE_SYSTEM_INFO）
+     * @param config 配置实例
+     */
+    void evos_hardware_info_display(const TickSources& sources, const Configuration& config) {
+        EVAN_PRINT("\n[Hardware Information]\n");
+        EVAN_PRINT("-----------------------------------------------\n");
         
-        SYSTEM_INFO sysInfo;
-        GetSystemInfo(&sysInfo);
-        printf("\tProcessor Architecture: %s.\n", 
-               getArchName(sysInfo.wProcessorArchitecture));
-        printf("\tNumber of Processors: %lu.\n", sysInfo.dwNumberOfProcessors);
-        printf("\tProcessor Level: %d.\n", sysInfo.wProcessorLevel);
-        printf("\tProcessor Revision: %04x.\n", sysInfo.wProcessorRevision);
+        const SYSTEM_INFO& sysInfo = sources.system_info;
+        EVAN_PRINT("\tProcessor Architecture: {}.\n", 
+                   getArchName(sysInfo.wProcessorArchitecture));
+        EVAN_PRINT("\tNumber of Processors: {}.\n", sysInfo.dwNumberOfProcessors);
+        EVAN_PRINT("\tProcessor Level: {}.\n", sysInfo.wProcessorLevel);
+        EVAN_PRINT("\tProcessor Revision: {:04x}.\n", sysInfo.wProcessorRevision);
         
         // CPU品牌信息，使用简单的实现
-        printf("\tCPU Brand: Unknown CPU Brand.\n");
-        printf("\tPage Size: %lu bytes.\n", sysInfo.dwPageSize);
-        printf("\tActive Processor Mask: 0x%lx.\n", sysInfo.dwActiveProcessorMask);
+        EVAN_PRINT("\tCPU Brand: Unknown CPU Brand.\n");
+        EVAN_PRINT("\tPage Size: {} bytes.\n", sysInfo.dwPageSize);
+        EVAN_PRINT("\tActive Processor Mask: 0x{:x}.\n", sysInfo.dwActiveProcessorMask);
     }
     
     // 显示特定进程信息
     void evos_process_info_display(DWORD pid, const Configuration& config) {
-        printf("\n[Process Information - PID: %lu]\n", pid);
-        printf("-----------------------------------------------\n");
+        EVAN_PRINT("\n[Process Information - PID: {}]\n", pid);
+        EVAN_PRINT("-----------------------------------------------\n");
         
         HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ,
                                       FALSE, pid);
         if (hProcess == NULL) {
             // 权限不足，显示基本信息
-            printf("\tPID: %lu\n", pid);
-            printf("\tWarning: Unable to open process (permission denied).\n");
-            printf("\tBasic information only available due to insufficient permissions.\n");
+            EVAN_PRINT("\tPID: {}\n", pid);
+            EVAN_PRINT("\tWarning: Unable to open process (permission denied).\n");
+            EVAN_PRINT("\tBasic information only available due to insufficient permissions.\n");
             return;
         }
         
@@ -358,20 +516,20 @@ namespace evan {
             PROCESS_MEMORY_COUNTERS_EX pmc;
             pmc.cb = sizeof(pmc);
             if (GetProcessMemoryInfo(hProcess, (PROCESS_MEMORY_COUNTERS*)&pmc, sizeof(pmc))) {
-                printf("\tWorking Set Size: %s.\n", 
-                       config.config_byte_to_str(pmc.WorkingSetSize).c_str());
-                printf("\tPeak Working Set Size: %s.\n", 
-                       config.config_byte_to_str(pmc.PeakWorkingSetSize).c_str());
-                printf("\tPagefile Usage: %s.\n", 
-                       config.config_byte_to_str(pmc.PagefileUsage).c_str());
-                printf("\tPeak Pagefile Usage: %s.\n", 
-                       config.config_byte_to_str(pmc.PeakPagefileUsage).c_str());
-                printf("\tPrivate Usage: %s.\n", 
-                       config.config_byte_to_str(pmc.PrivateUsage).c_str());
+                EVAN_PRINT("\tWorking Set Size: {}.\n", 
+                           config.config_byte_to_str(pmc.WorkingSetSize, tickArena));
+                EVAN_PRINT("\tPeak Working Set Size: {}.\n", 
+                           config.config_byte_to_str(pmc.PeakWorkingSetSize, tickArena));
+                EVAN_PRINT("\tPagefile Usage: {}.\n", 
+                           config.config_byte_to_str(pmc.PagefileUsage, tickArena));
+                EVAN_PRINT("\tPeak Pagefile Usage: {}.\n", 
+                           config.config_byte_to_str(pmc.PeakPagefileUsage, tickArena));
+                EVAN_PRINT("\tPrivate Usage: {}.\n", 
+                           config.config_byte_to_str(pmc.PrivateUsage, tickArena));
             } else {
             // 获取内存信息失败，显示基本信息
-            printf("\tPID: %lu\n", pid);
-            printf("\tWarning: Unable to get process memory information.\n");
+            EVAN_PRINT("\tPID: {}\n", pid);
+            EVAN_PRINT("\tWarning: Unable to get process memory information.\n");
         }
         
         CloseHandle(hProcess);
@@ -388,101 +546,440 @@ namespace evan {
         return 0;
     }
     
+    /**
+     * 计算内存与交换区使用率
+     * @param memoryStatus 内存状态
+     * @param memoryPercent [out] 物理内存使用率
+     * @param swapPercent [out] 交换区（页面文件中超出物理内存的部分）使用率
+     */
+    static void evos_memory_percent_get(const MEMORYSTATUSEX& memoryStatus,
+                                        float& memoryPercent, float& swapPercent) {
+        const unsigned long long usedPhys = memoryStatus.ullTotalPhys - memoryStatus.ullAvailPhys;
+        const unsigned long long usedCommit = memoryStatus.ullTotalPageFile - memoryStatus.ullAvailPageFile;
+        const unsigned long long totalSwap = memoryStatus.ullTotalPageFile > memoryStatus.ullTotalPhys ?
+                                             memoryStatus.ullTotalPageFile - memoryStatus.ullTotalPhys : 0;
+        const unsigned long long usedSwap = usedCommit > usedPhys ? usedCommit - usedPhys : 0;
+        
+        memoryPercent = memoryStatus.ullTotalPhys ?
+                        static_cast<float>(usedPhys * 100.0 / memoryStatus.ullTotalPhys) : 0.0f;
+        swapPercent = totalSwap ? static_cast<float>(usedSwap * 100.0 / totalSwap) : 0.0f;
+    }
+    
+    /**
+     * 将数值格式化为字符串（用于--changes-only输出，结果保存在本次循环的Arena中）
+     * @param value 数值
+     * @param suffix 后缀（如 "%"）
+     */
+    static utils::StringView evos_number_to_str(unsigned long long value, const char* suffix = "") {
+        utils::StackBuffer<32> buffer;
+        EVAN_FORMAT(buffer, "{}{}", value, suffix);
+        return tickArena.copy(buffer.view());
+    }
+    
+    /**
+     * 把总内存字段交给变化跟踪器（--changes-only模式）
+     * @param sources 本次循环的数据源
+     * @param tracker 变化跟踪器
+     * @param config 配置实例，用于格式化输出
+     * 
+     * 功能：与对应的显示函数读取相同的数据，但以"键/数值/文本"的形式记录，
+     *       由跟踪器决定哪些字段需要输出
+     */
+    static void evos_memory_total_watch(const TickSources& sources, ChangeTracker& tracker, const Configuration& config) {
+        if (!sources.has(SOURCE_MEMORY_STATUS)) {
+            return;
+        }
+        const MEMORYSTATUSEX& memoryStatus = sources.memory_status;
+        
+        const unsigned long long usedPhys = memoryStatus.ullTotalPhys - memoryStatus.ullAvailPhys;
+        const double memoryUsage = static_cast<double>(usedPhys) / memoryStatus.ullTotalPhys * 100;
+        utils::StackBuffer<32> usage;
+        EVAN_FORMAT(usage, "{:.2f}%", memoryUsage);
+        
+        tracker.field("total.total_phys", static_cast<double>(memoryStatus.ullTotalPhys),
+                      config.config_byte_to_str(memoryStatus.ullTotalPhys, tickArena));
+        tracker.field("total.used_phys", static_cast<double>(usedPhys), config.config_byte_to_str(usedPhys, tickArena));
+        tracker.field("total.free_phys", static_cast<double>(memoryStatus.ullAvailPhys),
+                      config.config_byte_to_str(memoryStatus.ullAvailPhys, tickArena));
+        tracker.field("total.memory_usage", memoryUsage, usage.view());
+    }
+    
+    /**
+     * 把性能字段交给变化跟踪器（--changes-only模式）
+     * @param sources 本次循环的数据源
+     * @param tracker 变化跟踪器
+     * @param config 配置实例，用于格式化输出
+     */
+    static void evos_system_performance_watch(const TickSources& sources, ChangeTracker& tracker, const Configuration& config) {
+        if (!sources.has(SOURCE_MEMORY_STATUS)) {
+            return;
+        }
+        const MEMORYSTATUSEX& memoryStatus = sources.memory_status;
+        const SYSTEM_INFO& sysInfo = sources.system_info;
+        
+        const unsigned long long usedVirtual = memoryStatus.ullTotalVirtual - memoryStatus.ullAvailVirtual;
+        const unsigned long long availPages = memoryStatus.ullAvailPageFile / sysInfo.dwPageSize;
+        const unsigned long long availPhysPages = memoryStatus.ullAvailPhys / sysInfo.dwPageSize;
+        
+        tracker.field("perf.available_pages", static_cast<double>(availPages), evos_number_to_str(availPages));
+        tracker.field("perf.available_phys_pages", static_cast<double>(availPhysPages),
+                      evos_number_to_str(availPhysPages));
+        tracker.field("perf.system_cache", static_cast<double>(usedVirtual), config.config_byte_to_str(usedVirtual, tickArena));
+        tracker.field("perf.free_system_memory", static_cast<double>(memoryStatus.ullAvailVirtual),
+                      config.config_byte_to_str(memoryStatus.ullAvailVirtual, tickArena));
+        tracker.field("perf.memory_load", memoryStatus.dwMemoryLoad,
+                      evos_number_to_str(memoryStatus.dwMemoryLoad, "%"));
+    }
+    
+    /**
+     * 把进程行交给变化跟踪器（--changes-only模式）
+     * @param sources 本次循环的数据源
+     * @param tracker 变化跟踪器
+     * @param config 配置实例，用于格式化输出
+     */
+    static void evos_process_enum_watch(const TickSources& sources, ChangeTracker& tracker, const Configuration& config) {
+        const ProcessList& processes = sources.processes;
+        
+        utils::StackBuffer<256> line;
+        for (size_t i = 0; i < processes.size(); ++i) {
+            const ProcessSample& process = processes[i];
+            line.clear();
+            if (process.working_set) {
+                EVAN_FORMAT(line, "{:<*} {:>*} {:>*}",
+                            PNAME_SIZE, process.name,
+                            PWORKSET_SIZE, config.config_byte_to_str(process.working_set, tickArena),
+                            NUM_WIDTH, static_cast<unsigned long>(process.pagefile / 1024));
+            } else {
+                EVAN_FORMAT(line, "{:<*} {:>*} {:>*}",
+                            PNAME_SIZE, process.name,
+                            PWORKSET_SIZE, "-",
+                            NUM_WIDTH, static_cast<unsigned long>(process.pagefile / 1024));
+            }
+            tracker.row(process.pid, static_cast<double>(process.working_set), line.view());
+        }
+    }
+    
+    namespace {
+    /**
+     * 内置采集器
+     * 依赖共享数据源的功能（其余功能的内容在运行期间基本不变，--changes-only下只在关键帧中完整显示）
+     */
+    class BuiltinCollector : public Collector {
+    public:
+        typedef void (*DisplayFunc)(const TickSources&, const Configuration&);
+        typedef void (*WatchFunc)(const TickSources&, ChangeTracker&, const Configuration&);
+        
+        BuiltinCollector(const char* name, DataSourceMask sources, DisplayFunc display, WatchFunc watch = nullptr) :
+            name_(name), sources_(sources), display_(display), watch_(watch) {}
+        
+        const char* name() const override { return name_; }
+        DataSourceMask sources() const override { return sources_; }
+        
+        void display(const TickSources& sources, const Configuration& config) override {
+            display_(sources, config);
+        }
+        
+        bool watch(const TickSources& sources, ChangeTracker& tracker, const Configuration& config) override {
+            if (watch_ == nullptr) {
+                return false;
+            }
+            watch_(sources, tracker, config);
+            return true;
+        }
+        
+    private:
+        const char* name_;
+        DataSourceMask sources_;
+        DisplayFunc display_;
+        WatchFunc watch_;
+    };
+    }
+    
+    /**
+     * 注册内置采集器
+     * @param registry 注册表
+     */
+    void evos_builtin_collectors_register(CollectorRegistry& registry) {
+        registry.add(new BuiltinCollector("perf", SOURCE_MEMORY_STATUS | SOURCE_SYSTEM_INFO,
+                                          &evos_system_performance_display, &evos_system_performance_watch));
+        registry.add(new BuiltinCollector("sys", SOURCE_MEMORY_STATUS | SOURCE_SYSTEM_INFO,
+                                          &evos_system_info_display));
+        registry.add(new BuiltinCollector("total", SOURCE_MEMORY_STATUS,
+                                          &evos_memory_total_display, &evos_memory_total_watch));
+        registry.add(new BuiltinCollector("each", SOURCE_PROCESS_TABLE,
+                                          &evos_process_enum_display, &evos_process_enum_watch));
+        registry.add(new BuiltinCollector("hardware", SOURCE_SYSTEM_INFO,
+                                          &evos_hardware_info_display));
+    }
+    
+    /**
+     * 每核CPU采样器（首次采集时初始化）
+     */
+    static CpuSampler snapshotSampler;
+    
+    /**
+     * 采集一次系统快照
+     * @param snapshot [out] 快照，core_usage只在首次调用时分配
+     * @return 成功返回true
+     * 
+     * 功能：采样每核CPU使用率以及内存/交换区使用率
+     * 实现：首次调用时建立基准采样并短暂等待，保证第一份快照即为有效数据
+     */
+    bool evos_snapshot_collect(MonitorSnapshot& snapshot) {
+        if (!snapshotSampler.hasBaseline()) {
+            if (!snapshotSampler.initialize()) {
+                EVAN_PRINT("Error: Unable to initialize per-core CPU sampling.\n");
+                return false;
+            }
+            snapshot.core_usage.assign(snapshotSampler.getCoreCount(), 0.0f);
+            snapshotSampler.sample(snapshot.core_usage.data(), snapshot.core_usage.size());
+            Sleep(250);
+        }
+        
+        snapshot.core_usage.resize(snapshotSampler.getCoreCount());
+        const size_t count = snapshotSampler.sample(snapshot.core_usage.data(), snapshot.core_usage.size());
+        snapshot.core_usage.resize(count);
+        snapshot.timestamp_ms = GetTickCount64();
+        
+        snapshot.memory_percent = 0.0f;
+        snapshot.swap_percent = 0.0f;
+        MEMORYSTATUSEX memoryStatus;
+        if (getMemoryStatus(memoryStatus)) {
+            evos_memory_percent_get(memoryStatus, snapshot.memory_percent, snapshot.swap_percent);
+        }
+        
+        return count > 0;
+    }
+    
+    /**
+     * 渲染系统快照（每核CPU热力图及内存/交换区历史）
+     * @param snapshot 快照
+     * 
+     * 功能：把快照追加到固定容量的历史中，然后渲染整个面板
+     * 实现：面板为静态对象，只在首次调用或核心数量变化时分配，
+     *       渲染结果写入面板内部复用的缓冲区后一次性输出
+     */
+    void evos_snapshot_render(const MonitorSnapshot& snapshot) {
+        utils::AllocScope allocScope("render.heatmap");
+        static HistoryPanel* panel = nullptr;
+        
+        if (panel == nullptr || panel->coreCount() != snapshot.core_usage.size()) {
+            delete panel;
+            panel = new HistoryPanel(snapshot.core_usage.size(), HEATMAP_HISTORY);
+            
+            // 启用控制台的ANSI颜色与UTF-8输出
+            HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
+            DWORD mode = 0;
+            if (hOut != INVALID_HANDLE_VALUE && GetConsoleMode(hOut, &mode)) {
+                SetConsoleMode(hOut, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+            }
+            SetConsoleOutputCP(CP_UTF8);
+        }
+        
+        panel->update(snapshot.core_usage.data(), snapshot.core_usage.size(),
+                      snapshot.memory_percent, snapshot.swap_percent);
+        const std::string& frame = panel->render();
+        utils::writeStdout(frame.data(), frame.size());
+    }
+    
+    /**
+     * 显示每核CPU热力图及内存/交换区历史
+     * 
+     * 功能：每次调用采样一次并渲染，循环模式下逐步积累历史
+     */
+    void evos_cpu_heatmap_display() {
+        static MonitorSnapshot snapshot;
+        
+        if (evos_snapshot_collect(snapshot)) {
+            evos_snapshot_render(snapshot);
+        }
+    }
+    
+    /**
+     * GPU采样状态（首次显示时初始化）
+     * 设备标识只在初始化时读取一次，之后每次显示只采样动态读数并追加到历史
+     */
+    struct GpuState {
+        GPUMonitorManager manager;
+        GPUSampleHistory history;
+        std::vector<GPUSample> samples;
+        bool available;
+        
+        GpuState() : history(HEATMAP_HISTORY), available(false) {
+            if (!manager.initialize()) {
+                return;
+            }
+            std::vector<GPUDeviceIdentity> identities;
+            manager.getDeviceIdentities(identities);
+            for (size_t i = 0; i < identities.size(); ++i) {
+                history.addDevice(identities[i]);
+            }
+            available = history.deviceCount() != 0;
+        }
+    };
+    
+    /**
+     * 采样所有GPU并追加到历史
+     * @return 采样状态，没有可用的GPU时返回nullptr
+     */
+    static GpuState* evos_gpu_sample() {
+        static GpuState state;
+        if (!state.available || !state.manager.sampleAll(state.samples)) {
+            EVAN_PRINT("\tNo supported GPU was found.\n");
+            return nullptr;
+        }
+        for (size_t i = 0; i < state.samples.size(); ++i) {
+            state.history.push(state.samples[i]);
+        }
+        return &state;
+    }
+    
+    /**
+     * 按设备的采样历史输出使用率和显存占用的迷你折线
+     * @param samples 设备的采样历史
+     * @param memoryTotal 总显存（字节）
+     */
+    static void evos_gpu_history_render(const utils::RingBuffer<GPUSample>& samples, unsigned long long memoryTotal) {
+        SparklineWidget utilization("GPU", samples.capacity());
+        SparklineWidget memory("VRAM", samples.capacity());
+        for (size_t i = 0; i < samples.size(); ++i) {
+            utilization.push(static_cast<float>(samples[i].utilization_centi) / 100.0f);
+            memory.push(memoryTotal == 0 ? 0.0f
+                                         : static_cast<float>(samples[i].memory_used * 100.0 / memoryTotal));
+        }
+        std::string frame;
+        utilization.render(frame);
+        memory.render(frame);
+        utils::writeStdout(frame.data(), frame.size());
+    }
+    
     // 显示GPU基本信息
     void evos_gpu_info_display() {
-        printf("\n[GPU Information - Placeholder]\n");
-        printf("-----------------------------------------------\n");
-        printf("\tGPU monitoring is not fully implemented yet.\n");
-        printf("\tThis is a placeholder implementation.\n");
-        printf("\tPlease check back in future releases for full GPU monitoring.\n");
+        const unsigned long long MB = 1024ULL * 1024ULL;
+        EVAN_PRINT("\n[GPU Information]\n");
+        EVAN_PRINT("-----------------------------------------------\n");
+        GpuState* state = evos_gpu_sample();
+        if (state == nullptr) {
+            return;
+        }
+        for (size_t i = 0; i < state->samples.size(); ++i) {
+            const GPUSample& sample = state->samples[i];
+            const GPUDeviceIdentity* identity = state->history.identity(sample.device_id);
+            if (identity == nullptr) {
+                continue;
+            }
+            EVAN_PRINT("\tName: {} ({}, driver {}).\n", identity->name, identity->vendor, identity->driver_version);
+            EVAN_PRINT("\tMemory: {} MB used of {} MB.\n", sample.memory_used / MB, identity->memory_total / MB);
+            EVAN_PRINT("\tUtilization: {:.2f}%, Temperature: {:.2f} C, Power: {:.3f} W.\n",
+                       sample.utilization_centi / 100.0, sample.temperature_centi / 100.0, sample.power_mw / 1000.0);
+            evos_gpu_history_render(*state->history.samples(sample.device_id), identity->memory_total);
+        }
     }
     
     // 显示GPU高级信息
     void evos_gpu_advanced_info_display() {
-        printf("\n[Advanced GPU Information - Placeholder]\n");
-        printf("-----------------------------------------------\n");
-        printf("\tAdvanced GPU monitoring is not fully implemented yet.\n");
-        printf("\tThis is a placeholder implementation.\n");
+        const unsigned long long MB = 1024ULL * 1024ULL;
+        EVAN_PRINT("\n[Advanced GPU Information]\n");
+        EVAN_PRINT("-----------------------------------------------\n");
+        GpuState* state = evos_gpu_sample();
+        if (state == nullptr) {
+            return;
+        }
+        for (size_t i = 0; i < state->samples.size(); ++i) {
+            const GPUSample& sample = state->samples[i];
+            const GPUDeviceIdentity* identity = state->history.identity(sample.device_id);
+            if (identity == nullptr) {
+                continue;
+            }
+            EVAN_PRINT("\tDevice 0x{:x}: {} ({}, driver {}).\n",
+                       sample.device_id, identity->name, identity->vendor, identity->driver_version);
+            EVAN_PRINT("\tMemory: total {} MB, used {} MB, free {} MB.\n",
+                       identity->memory_total / MB, sample.memory_used / MB, sample.memory_free / MB);
+            EVAN_PRINT("\tUtilization: {:.2f}%, Temperature: {:.2f} C, Power: {:.3f} W.\n",
+                       sample.utilization_centi / 100.0, sample.temperature_centi / 100.0, sample.power_mw / 1000.0);
+            EVAN_PRINT("\tClocks: core {} MHz, memory {} MHz.\n", sample.clock_core_mhz, sample.clock_memory_mhz);
+            evos_gpu_history_render(*state->history.samples(sample.device_id), identity->memory_total);
+        }
     }
     
     // 显示GPU负载平衡建议
     void evos_gpu_balance_display() {
-        printf("\n[GPU Load Balance Suggestions - Placeholder]\n");
-        printf("-----------------------------------------------\n");
-        printf("\tGPU load balance suggestions are not fully implemented yet.\n");
-        printf("\tThis is a placeholder implementation.\n");
+        EVAN_PRINT("\n[GPU Load Balance Suggestions - Placeholder]\n");
+        EVAN_PRINT("-----------------------------------------------\n");
+        EVAN_PRINT("\tGPU load balance suggestions are not fully implemented yet.\n");
+        EVAN_PRINT("\tThis is a placeholder implementation.\n");
     }
     
     // 显示GPU功耗分析
     void evos_gpu_power_display() {
-        printf("\n[GPU Power Analysis - Placeholder]\n");
-        printf("-----------------------------------------------\n");
-        printf("\tGPU power analysis is not fully implemented yet.\n");
-        printf("\tThis is a placeholder implementation.\n");
+        EVAN_PRINT("\n[GPU Power Analysis - Placeholder]\n");
+        EVAN_PRINT("-----------------------------------------------\n");
+        EVAN_PRINT("\tGPU power analysis is not fully implemented yet.\n");
+        EVAN_PRINT("\tThis is a placeholder implementation.\n");
     }
     
     // 显示GPU频率调优建议
     void evos_gpu_tuning_display() {
-        printf("\n[GPU Frequency Tuning Suggestions - Placeholder]\n");
-        printf("-----------------------------------------------\n");
-        printf("\tGPU frequency tuning suggestions are not fully implemented yet.\n");
-        printf("\tThis is a placeholder implementation.\n");
+        EVAN_PRINT("\n[GPU Frequency Tuning Suggestions - Placeholder]\n");
+        EVAN_PRINT("-----------------------------------------------\n");
+        EVAN_PRINT("\tGPU frequency tuning suggestions are not fully implemented yet.\n");
+        EVAN_PRINT("\tThis is a placeholder implementation.\n");
     }
     
     // 显示网络连接信息
     void evos_network_display() {
-        printf("\n[Network Connection Information - Placeholder]\n");
-        printf("-----------------------------------------------\n");
-        printf("\tNetwork connection monitoring is not fully implemented yet.\n");
-        printf("\tThis is a placeholder implementation.\n");
+        EVAN_PRINT("\n[Network Connection Information - Placeholder]\n");
+        EVAN_PRINT("-----------------------------------------------\n");
+        EVAN_PRINT("\tNetwork connection monitoring is not fully implemented yet.\n");
+        EVAN_PRINT("\tThis is a placeholder implementation.\n");
     }
     
     // 显示网络流量统计
     void evos_traffic_display() {
-        printf("\n[Network Traffic Statistics - Placeholder]\n");
-        printf("-----------------------------------------------\n");
-        printf("\tNetwork traffic statistics are not fully implemented yet.\n");
-        printf("\tThis is a placeholder implementation.\n");
+        EVAN_PRINT("\n[Network Traffic Statistics - Placeholder]\n");
+        EVAN_PRINT("-----------------------------------------------\n");
+        EVAN_PRINT("\tNetwork traffic statistics are not fully implemented yet.\n");
+        EVAN_PRINT("\tThis is a placeholder implementation.\n");
     }
     
     // 显示端口使用信息
     void evos_ports_display() {
-        printf("\n[Port Usage Information - Placeholder]\n");
-        printf("-----------------------------------------------\n");
-        printf("\tPort usage monitoring is not fully implemented yet.\n");
-        printf("\tThis is a placeholder implementation.\n");
+        EVAN_PRINT("\n[Port Usage Information - Placeholder]\n");
+        EVAN_PRINT("-----------------------------------------------\n");
+        EVAN_PRINT("\tPort usage monitoring is not fully implemented yet.\n");
+        EVAN_PRINT("\tThis is a placeholder implementation.\n");
     }
     
     // 显示网络带宽统计
     void evos_net_bandwidth_display() {
-        printf("\n[Network Bandwidth Statistics - Placeholder]\n");
-        printf("-----------------------------------------------\n");
-        printf("\tNetwork bandwidth statistics are not fully implemented yet.\n");
-        printf("\tThis is a placeholder implementation.\n");
+        EVAN_PRINT("\n[Network Bandwidth Statistics - Placeholder]\n");
+        EVAN_PRINT("-----------------------------------------------\n");
+        EVAN_PRINT("\tNetwork bandwidth statistics are not fully implemented yet.\n");
+        EVAN_PRINT("\tThis is a placeholder implementation.\n");
     }
     
     // 显示网络流量图表
     void evos_net_chart_display() {
-        printf("\n[Network Traffic Chart - Placeholder]\n");
-        printf("-----------------------------------------------\n");
-        printf("\tNetwork traffic charts are not fully implemented yet.\n");
-        printf("\tThis is a placeholder implementation.\n");
+        EVAN_PRINT("\n[Network Traffic Chart - Placeholder]\n");
+        EVAN_PRINT("-----------------------------------------------\n");
+        EVAN_PRINT("\tNetwork traffic charts are not fully implemented yet.\n");
+        EVAN_PRINT("\tThis is a placeholder implementation.\n");
     }
     
     // 显示网络连接分析
     void evos_net_connection_display() {
-        printf("\n[Network Connection Analysis - Placeholder]\n");
-        printf("-----------------------------------------------\n");
-        printf("\tNetwork connection analysis is not fully implemented yet.\n");
-        printf("\tThis is a placeholder implementation.\n");
+        EVAN_PRINT("\n[Network Connection Analysis - Placeholder]\n");
+        EVAN_PRINT("-----------------------------------------------\n");
+        EVAN_PRINT("\tNetwork connection analysis is not fully implemented yet.\n");
+        EVAN_PRINT("\tThis is a placeholder implementation.\n");
     }
     
     // 显示网络接口状态
     void evos_net_interfaces_display() {
-        printf("\n[Network Interfaces Status - Placeholder]\n");
-        printf("-----------------------------------------------\n");
-        printf("\tNetwork interfaces status monitoring is not fully implemented yet.\n");
-        printf("\tThis is a placeholder implementation.\n");
+        EVAN_PRINT("\n[Network Interfaces Status - Placeholder]\n");
+        EVAN_PRINT("-----------------------------------------------\n");
+        EVAN_PRINT("\tNetwork interfaces status monitoring is not fully implemented yet.\n");
+        EVAN_PRINT("\tThis is a placeholder implementation.\n");
     }
     
     /**
@@ -495,24 +992,24 @@ namespace evan {
      * 实现：使用TCP连接方式扫描端口，连接成功则端口开放
      */
     void evos_port_scan_display(const std::string& host, int start_port, int end_port) {
-        printf("\n[Port Scan Results]\n");
-        printf("-----------------------------------------------\n");
-        printf("Scanning host: %s\n", host.c_str());
-        printf("Port range: %d - %d\n", start_port, end_port);
-        printf("-----------------------------------------------\n");
+        EVAN_PRINT("\n[Port Scan Results]\n");
+        EVAN_PRINT("-----------------------------------------------\n");
+        EVAN_PRINT("Scanning host: {}\n", host);
+        EVAN_PRINT("Port range: {} - {}\n", start_port, end_port);
+        EVAN_PRINT("-----------------------------------------------\n");
         
         // 初始化Winsock
         WSADATA wsaData;
         int wsaerr = WSAStartup(MAKEWORD(2, 2), &wsaData);
         if (wsaerr != 0) {
-            printf("Error: Failed to initialize Winsock. Error code: %d\n", wsaerr);
+            EVAN_PRINT("Error: Failed to initialize Winsock. Error code: {}\n", wsaerr);
             return;
         }
         
         // 创建socket
         SOCKET scanSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
         if (scanSocket == INVALID_SOCKET) {
-            printf("Error: Failed to create socket. Error code: %d\n", WSAGetLastError());
+            EVAN_PRINT("Error: Failed to create socket. Error code: {}\n", WSAGetLastError());
             WSACleanup();
             return;
         }
@@ -520,7 +1017,7 @@ namespace evan {
         // 设置socket为非阻塞模式
         u_long mode = 1; // 1 = non-blocking mode
         if (ioctlsocket(scanSocket, FIONBIO, &mode) != NO_ERROR) {
-            printf("Error: Failed to set socket to non-blocking. Error code: %d\n", WSAGetLastError());
+            EVAN_PRINT("Error: Failed to set socket to non-blocking. Error code: {}\n", WSAGetLastError());
             closesocket(scanSocket);
             WSACleanup();
             return;
@@ -535,7 +1032,7 @@ namespace evan {
         if (host_entry == NULL) {
             // 尝试将字符串直接转换为IP地址
             if (inet_addr(host.c_str()) == INADDR_NONE) {
-                printf("Error: Failed to resolve host: %s\n", host.c_str());
+                EVAN_PRINT("Error: Failed to resolve host: {}\n", host);
                 closesocket(scanSocket);
                 WSACleanup();
                 return;
@@ -548,9 +1045,9 @@ namespace evan {
         }
         
         // 显示目标IP
-        printf("Target IP: %s\n", inet_ntoa(serverAddr.sin_addr));
-        printf("Scanning...\n");
-        printf("-----------------------------------------------\n");
+        EVAN_PRINT("Target IP: {}\n", inet_ntoa(serverAddr.sin_addr));
+        EVAN_PRINT("Scanning...\n");
+        EVAN_PRINT("-----------------------------------------------\n");
         
         // 扫描端口
         std::vector<int> open_ports;
@@ -589,15 +1086,15 @@ namespace evan {
         
         // 显示结果
         if (open_ports.empty()) {
-            printf("No open ports found in range %d-%d\n", start_port, end_port);
+            EVAN_PRINT("No open ports found in range {}-{}\n", start_port, end_port);
         } else {
-            printf("Found %d open port(s):\n", open_ports.size());
+            EVAN_PRINT("Found {} open port(s):\n", open_ports.size());
             for (int port : open_ports) {
-                printf("  Port %d: OPEN\n", port);
+                EVAN_PRINT("  Port {}: OPEN\n", port);
             }
         }
         
-        printf("-----------------------------------------------\n");
+        EVAN_PRINT("-----------------------------------------------\n");
     }
     
     // 全局配置实例
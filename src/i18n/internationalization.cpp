@@ -2,9 +2,8 @@
 // Licensed under the Apache License, Version 2.0
 
 #include "i18n/internationalization.h"
-#include <fstream>
-#include <sstream>
-#include <algorithm>
+#include "utils/mapped_file.h"
+#include "utils/string_utils.h"
 #include <vector>
 
 namespace evan {
@@ -23,96 +22,193 @@ Internationalization& Internationalization::getInstance() {
     return *instance;
 }
 
+// 语言名称（按Language顺序）
+static const char* const LANGUAGE_NAMES[LANGUAGE_COUNT] = {
+    "English", "Chinese", "Spanish", "French", "German", "Japanese"
+};
+
+/**
+ * 内置翻译
+ */
+struct BuiltinTranslation {
+    TrKey key;
+    const char* text;
+};
+
+// 内置中文翻译（英文来自翻译键列表）
+static const BuiltinTranslation CHINESE_TRANSLATIONS[] = {
+    {TR_SYSTEM_PERFORMANCE, "系统性能"},
+    {TR_SYSTEM_MEMORY, "系统内存"},
+    {TR_TOTAL_MEMORY, "总内存"},
+    {TR_EACH_PROCESS, "每个进程"},
+    {TR_HARDWARE_INFO, "硬件信息"},
+    {TR_GPU_INFO, "GPU信息"},
+    {TR_ADVANCED_GPU_INFO, "高级GPU信息"},
+    {TR_HELP, "帮助"},
+    {TR_COPYRIGHT, "版权"},
+    {TR_LICENSE, "许可证"},
+    {TR_CPU_ARCHITECTURE, "CPU架构"},
+    {TR_NUMBER_OF_PROCESSORS, "处理器数量"},
+    {TR_PROCESSOR_LEVEL, "处理器级别"},
+    {TR_PROCESSOR_REVISION, "处理器修订"},
+    {TR_CPU_BRAND, "CPU品牌"},
+    {TR_PAGE_SIZE, "页大小"},
+    {TR_ACTIVE_PROCESSOR_MASK, "活动处理器掩码"},
+    {TR_TOTAL_PHYSICAL_MEMORY, "总物理内存"},
+    {TR_USED_PHYSICAL_MEMORY, "已用物理内存"},
+    {TR_FREE_PHYSICAL_MEMORY, "可用物理内存"},
+    {TR_MEMORY_USAGE, "内存使用率"},
+    {TR_GPU_NAME, "GPU名称"},
+    {TR_GPU_VENDOR, "GPU厂商"},
+    {TR_DRIVER_VERSION, "驱动版本"},
+    {TR_MEMORY_TOTAL, "总显存"},
+    {TR_MEMORY_USED, "已用显存"},
+    {TR_MEMORY_FREE, "可用显存"},
+    {TR_UTILIZATION, "使用率"},
+    {TR_TEMPERATURE, "温度"},
+    {TR_POWER_USAGE, "功耗"},
+    {TR_CLOCK_CORE, "核心频率"},
+    {TR_CLOCK_MEMORY, "显存频率"},
+};
+
 /**
  * 私有构造函数（单例模式）
+ * 只准备英文翻译表（全部是字面量，不分配内存），其他语言在第一次被选中时才加载
  */
-Internationalization::Internationalization() {
+Internationalization::Internationalization() : storage(4 * 1024) {
     // 默认语言为英语
     currentLanguage = Language::ENGLISH;
+    current = resolved[static_cast<size_t>(Language::ENGLISH)];
+    for (size_t lang = 0; lang < LANGUAGE_COUNT; ++lang) {
+        loaded[lang] = false;
+    }
     
-    // 初始化语言名称映射
-    languageNames[Language::ENGLISH] = "English";
-    languageNames[Language::CHINESE] = "Chinese";
-    languageNames[Language::SPANISH] = "Spanish";
-    languageNames[Language::FRENCH] = "French";
-    languageNames[Language::GERMAN] = "German";
-    languageNames[Language::JAPANESE] = "Japanese";
+    ensureLoaded(Language::ENGLISH);
+}
+
+/**
+ * 加载语言的内置翻译和指定的翻译文件（只在第一次调用时执行）
+ * @param lang 语言类型
+ */
+void Internationalization::ensureLoaded(Language lang) {
+    const size_t index = static_cast<size_t>(lang);
+    if (loaded[index]) {
+        return;
+    }
+    loaded[index] = true;
     
-    // 初始化默认翻译
-    initializeDefaultTranslations();
+    utils::StringView* table = registered[index];
+    if (lang == Language::ENGLISH) {
+#define EVAN_TRANSLATION_KEY_ENGLISH(id, name, english) table[TR_##id] = utils::StringView(english);
+        EVAN_TRANSLATION_KEYS(EVAN_TRANSLATION_KEY_ENGLISH)
+#undef EVAN_TRANSLATION_KEY_ENGLISH
+    } else if (lang == Language::CHINESE) {
+        for (size_t i = 0; i < sizeof(CHINESE_TRANSLATIONS) / sizeof(CHINESE_TRANSLATIONS[0]); ++i) {
+            table[CHINESE_TRANSLATIONS[i].key] = utils::StringView(CHINESE_TRANSLATIONS[i].text);
+        }
+    }
+    
+    if (!pendingFiles[index].empty()) {
+        parseTranslationFile(lang, pendingFiles[index]);
+        pendingFiles[index].clear();
+    }
+    resolve(lang);
+}
+
+/**
+ * 映射翻译文件并解析到翻译表（不重新计算回退）
+ * @param lang 语言类型
+ * @param filePath 翻译文件路径
+ * @return 是否读取成功
+ *
+ * 实现：文件整体映射到内存后按行切分视图，只把键已知的值复制到Arena中，
+ *       解析完成即解除映射，不逐行分配字符串
+ */
+bool Internationalization::parseTranslationFile(Language lang, const std::string& filePath) {
+    utils::MappedFile file;
+    if (!file.open(filePath)) {
+        return false;
+    }
+    
+    utils::StringView* table = registered[static_cast<size_t>(lang)];
+    utils::StringUtils::SplitIterator lines(file.view(), '\n');
+    utils::StringView line;
+    while (lines.next(line)) {
+        // 跳过空行和注释行
+        line = utils::StringUtils::trimView(line);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        
+        // 查找等号分隔符
+        size_t equalsPos = line.find('=');
+        if (equalsPos == utils::StringView::npos) {
+            continue;
+        }
+        
+        // 提取键和值并去除前后空格（未知的键名忽略）
+        utils::StringView key = utils::StringUtils::trimView(line.substr(0, equalsPos));
+        utils::StringView value = utils::StringUtils::trimView(line.substr(equalsPos + 1));
+        TrKey id;
+        if (findKey(key, id)) {
+            table[id] = storage.copy(value);
+        }
+    }
+    return true;
+}
+
+/**
+ * 重新计算语言的最终翻译表
+ * 缺失的键在这里回退到英文，translate()只需要一次数组访问；
+ * 英文是其他语言的回退，英文变化时所有语言都重新计算
+ * @param lang 翻译发生变化的语言
+ */
+void Internationalization::resolve(Language lang) {
+    static const char* const KEY_NAMES[TR_KEY_COUNT] = {
+#define EVAN_TRANSLATION_KEY_NAME(id, name, english) name,
+        EVAN_TRANSLATION_KEYS(EVAN_TRANSLATION_KEY_NAME)
+#undef EVAN_TRANSLATION_KEY_NAME
+    };
+    
+    const utils::StringView* english = registered[static_cast<size_t>(Language::ENGLISH)];
+    for (size_t target = 0; target < LANGUAGE_COUNT; ++target) {
+        if (lang != Language::ENGLISH && target != static_cast<size_t>(lang)) {
+            continue;
+        }
+        const utils::StringView* own = registered[target];
+        utils::StringView* out = resolved[target];
+        for (size_t key = 0; key < TR_KEY_COUNT; ++key) {
+            if (!own[key].empty()) {
+                out[key] = own[key];
+            } else if (!english[key].empty()) {
+                out[key] = english[key];
+            } else {
+                out[key] = utils::StringView(KEY_NAMES[key]);
+            }
+        }
+    }
 }
 
 /**
- * 初始化默认翻译
- */
-void Internationalization::initializeDefaultTranslations() {
-    // 英语翻译
-    registerTranslation(Language::ENGLISH, "system_performance", "System Performance");
-    registerTranslation(Language::ENGLISH, "system_memory", "System Memory");
-    registerTranslation(Language::ENGLISH, "total_memory", "Total Memory");
-    registerTranslation(Language::ENGLISH, "each_process", "Each Process");
-    registerTranslation(Language::ENGLISH, "hardware_info", "Hardware Info");
-    registerTranslation(Language::ENGLISH, "gpu_info", "GPU Info");
-    registerTranslation(Language::ENGLISH, "advanced_gpu_info", "Advanced GPU Info");
-    registerTranslation(Language::ENGLISH, "help", "Help");
-    registerTranslation(Language::ENGLISH, "copyright", "Copyright");
-    registerTranslation(Language::ENGLISH, "license", "License");
-    registerTranslation(Language::ENGLISH, "cpu_architecture", "CPU Architecture");
-    registerTranslation(Language::ENGLISH, "number_of_processors", "Number of Processors");
-    registerTranslation(Language::ENGLISH, "processor_level", "Processor Level");
-    registerTranslation(Language::ENGLISH, "processor_revision", "Processor Revision");
-    registerTranslation(Language::ENGLISH, "cpu_brand", "CPU Brand");
-    registerTranslation(Language::ENGLISH, "page_size", "Page Size");
-    registerTranslation(Language::ENGLISH, "active_processor_mask", "Active Processor Mask");
-    registerTranslation(Language::ENGLISH, "total_physical_memory", "Total Physical Memory");
-    registerTranslation(Language::ENGLISH, "used_physical_memory", "Used Physical Memory");
-    registerTranslation(Language::ENGLISH, "free_physical_memory", "Free Physical Memory");
-    registerTranslation(Language::ENGLISH, "memory_usage", "Memory Usage");
-    registerTranslation(Language::ENGLISH, "gpu_name", "GPU Name");
-    registerTranslation(Language::ENGLISH, "gpu_vendor", "GPU Vendor");
-    registerTranslation(Language::ENGLISH, "driver_version", "Driver Version");
-    registerTranslation(Language::ENGLISH, "memory_total", "Total Memory");
-    registerTranslation(Language::ENGLISH, "memory_used", "Used Memory");
-    registerTranslation(Language::ENGLISH, "memory_free", "Free Memory");
-    registerTranslation(Language::ENGLISH, "utilization", "Utilization");
-    registerTranslation(Language::ENGLISH, "temperature", "Temperature");
-    registerTranslation(Language::ENGLISH, "power_usage", "Power Usage");
-    registerTranslation(Language::ENGLISH, "clock_core", "Core Clock");
-    registerTranslation(Language::ENGLISH, "clock_memory", "Memory Clock");
+ * 按键名查找翻译键
+ * @param name 翻译键名
+ * @param key [out] 翻译键
+ * @return 找到返回true
+ */
+bool Internationalization::findKey(utils::StringView name, TrKey& key) {
+    static const utils::StringView KEY_NAMES[TR_KEY_COUNT] = {
+#define EVAN_TRANSLATION_KEY_VIEW(id, name, english) utils::StringView(name),
+        EVAN_TRANSLATION_KEYS(EVAN_TRANSLATION_KEY_VIEW)
+#undef EVAN_TRANSLATION_KEY_VIEW
+    };
     
-    // 中文翻译
-    registerTranslation(Language::CHINESE, "system_performance", "系统性能");
-    registerTranslation(Language::CHINESE, "system_memory", "系统内存");
-    registerTranslation(Language::CHINESE, "total_memory", "总内存");
-    registerTranslation(Language::CHINESE, "each_process", "每个进程");
-    registerTranslation(Language::CHINESE, "hardware_info", "硬件信息");
-    registerTranslation(Language::CHINESE, "gpu_info", "GPU信息");
-    registerTranslation(Language::CHINESE, "advanced_gpu_info", "高级GPU信息");
-    registerTranslation(Language::CHINESE, "help", "帮助");
-    registerTranslation(Language::CHINESE, "copyright", "版权");
-    registerTranslation(Language::CHINESE, "license", "许可证");
-    registerTranslation(Language::CHINESE, "cpu_architecture", "CPU架构");
-    registerTranslation(Language::CHINESE, "number_of_processors", "处理器数量");
-    registerTranslation(Language::CHINESE, "processor_level", "处理器级别");
-    registerTranslation(Language::CHINESE, "processor_revision", "处理器修订");
-    registerTranslation(Language::CHINESE, "cpu_brand", "CPU品牌");
-    registerTranslation(Language::CHINESE, "page_size", "页大小");
-    registerTranslation(Language::CHINESE, "active_processor_mask", "活动处理器掩码");
-    registerTranslation(Language::CHINESE, "total_physical_memory", "总物理内存");
-    registerTranslation(Language::CHINESE, "used_physical_memory", "已用物理内存");
-    registerTranslation(Language::CHINESE, "free_physical_memory", "可用物理内存");
-    registerTranslation(Language::CHINESE, "memory_usage", "内存使用率");
-    registerTranslation(Language::CHINESE, "gpu_name", "GPU名称");
-    registerTranslation(Language::CHINESE, "gpu_vendor", "GPU厂商");
-    registerTranslation(Language::CHINESE, "driver_version", "驱动版本");
-    registerTranslation(Language::CHINESE, "memory_total", "总显存");
-    registerTranslation(Language::CHINESE, "memory_used", "已用显存");
-    registerTranslation(Language::CHINESE, "memory_free", "可用显存");
-    registerTranslation(Language::CHINESE, "utilization", "使用率");
-    registerTranslation(Language::CHINESE, "temperature", "温度");
-    registerTranslation(Language::CHINESE, "power_usage", "功耗");
-    registerTranslation(Language::CHINESE, "clock_core", "核心频率");
-    registerTranslation(Language::CHINESE, "clock_memory", "显存频率");
+    for (size_t i = 0; i < TR_KEY_COUNT; ++i) {
+        if (KEY_NAMES[i] == name) {
+            key = static_cast<TrKey>(i);
+            return true;
+        }
+    }
+    return false;
 }
 
 /**
@@ -120,7 +216,9 @@ void Internationalization::initializeDefaultTranslations() {
  * @param lang 语言类型
  */
 void Internationalization::setLanguage(Language lang) {
+        ensureLoaded(lang);
         currentLanguage = lang;
+        current = resolved[static_cast<size_t>(lang)];
     }
 
 /**
@@ -136,39 +234,23 @@ Language Internationalization::getCurrentLanguage() const {
  * @return 当前语言名称字符串
  */
 std::string Internationalization::getCurrentLanguageName() const {
-        auto it = languageNames.find(currentLanguage);
-        if (it != languageNames.end()) {
-            return it->second;
+        if (isLanguageSupported(currentLanguage)) {
+            return LANGUAGE_NAMES[static_cast<size_t>(currentLanguage)];
         }
         return "Unknown";
     }
 
 /**
- * 翻译字符串
- * @param key 翻译键
- * @return 翻译后的字符串
- */
-std::string Internationalization::translate(const std::string& key) {
-        // 检查当前语言是否有对应的翻译
-        auto langIt = translations.find(currentLanguage);
-        if (langIt != translations.end()) {
-            auto keyIt = langIt->second.find(key);
-            if (keyIt != langIt->second.end()) {
-                return keyIt->second;
-            }
-        }
-        
-        // 如果当前语言没有翻译，尝试使用英语作为回退
-        auto englishIt = translations.find(Language::ENGLISH);
-        if (englishIt != translations.end()) {
-            auto keyIt = englishIt->second.find(key);
-            if (keyIt != englishIt->second.end()) {
-                return keyIt->second;
-            }
+ * 按键名翻译字符串
+ * @param key 翻译键名
+ * @return 翻译后的字符串，未知的键名原样返回
+ */
+std::string Internationalization::translate(const std::string& key) const {
+        TrKey id;
+        if (!findKey(key, id)) {
+            return key;
         }
-        
-        // 如果都没有翻译，返回原始键
-        return key;
+        return translate(id).toString();
     }
 
 /**
@@ -177,8 +259,27 @@ std::string Internationalization::translate(const std::string& key) {
  * @param key 翻译键
  * @param value 翻译值
  */
-void Internationalization::registerTranslation(Language lang, const std::string& key, const std::string& value) {
-        translations[lang][key] = value;
+void Internationalization::registerTranslation(Language lang, TrKey key, utils::StringView value) {
+        ensureLoaded(lang);
+        registered[static_cast<size_t>(lang)][key] = storage.copy(value);
+        
+        resolve(lang);
+    }
+
+/**
+ * 按键名注册翻译
+ * @param lang 语言类型
+ * @param key 翻译键名
+ * @param value 翻译值
+ * @return 键名已知返回true
+ */
+bool Internationalization::registerTranslation(Language lang, const std::string& key, const std::string& value) {
+        TrKey id;
+        if (!findKey(key, id)) {
+            return false;
+        }
+        registerTranslation(lang, id, value);
+        return true;
     }
 
 /**
@@ -188,53 +289,34 @@ void Internationalization::registerTranslation(Language lang, const std::string&
  * @return 是否加载成功
  */
 bool Internationalization::loadTranslationFile(Language lang, const std::string& filePath) {
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
+    ensureLoaded(lang);
+    if (!parseTranslationFile(lang, filePath)) {
         return false;
     }
-    
-    std::string line;
-    while (std::getline(file, line)) {
-        // 跳过空行和注释行
-        if (line.empty() || line[0] == '#') {
-            continue;
-        }
-        
-        // 查找等号分隔符
-        size_t equalsPos = line.find('=');
-        if (equalsPos == std::string::npos) {
-            continue;
-        }
-        
-        // 提取键和值
-        std::string key = line.substr(0, equalsPos);
-        std::string value = line.substr(equalsPos + 1);
-        
-        // 去除前后空格
-        key.erase(0, key.find_first_not_of(" 	"));
-        key.erase(key.find_last_not_of(" 	") + 1);
-        value.erase(0, value.find_first_not_of(" 	"));
-        value.erase(value.find_last_not_of(" 	") + 1);
-        
-        // 注册翻译
-        registerTranslation(lang, key, value);
-    }
-    
-    file.close();
+    resolve(lang);
     return true;
 }
 
+/**
+ * 指定语言的翻译文件
+ * @param lang 语言类型
+ * @param filePath 翻译文件路径
+ */
+void Internationalization::setTranslationFile(Language lang, const std::string& filePath) {
+    const size_t index = static_cast<size_t>(lang);
+    if (loaded[index]) {
+        loadTranslationFile(lang, filePath);
+    } else {
+        pendingFiles[index] = filePath;
+    }
+}
+
 /**
  * 获取支持的语言列表
  * @return 支持的语言名称列表
  */
 std::vector<std::string> Internationalization::getSupportedLanguages() const {
-        std::vector<std::string> languages;
-        for (const auto& pair : languageNames) {
-            languages.push_back(pair.second);
-        }
-        
-        return languages;
+        return std::vector<std::string>(LANGUAGE_NAMES, LANGUAGE_NAMES + LANGUAGE_COUNT);
     }
 
 /**
@@ -243,7 +325,7 @@ std::vector<std::string> Internationalization::getSupportedLanguages() const {
  * @return 是否支持
  */
 bool Internationalization::isLanguageSupported(Language lang) const {
-        return languageNames.find(lang) != languageNames.end();
+        return static_cast<size_t>(lang) < LANGUAGE_COUNT;
     }
 
 } // namespace evan
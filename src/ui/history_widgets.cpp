@@ -0,0 +1,230 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "ui/history_widgets.h"
+#include <cstdio>
+
+namespace evan {
+
+namespace {
+    /**
+     * 预生成的字符串片段（附带长度，追加时无需strlen）
+     */
+    struct Fragment {
+        const char* text;
+        size_t length;
+    };
+
+    #define EVAN_FRAGMENT(s) { s, sizeof(s) - 1 }
+
+    /**
+     * 热力图颜色梯度（ANSI 256色背景），索引为使用率/10
+     */
+    const Fragment HEAT_COLORS[] = {
+        EVAN_FRAGMENT("\033[48;5;236m"),  // 0-9%
+        EVAN_FRAGMENT("\033[48;5;22m"),   // 10-19%
+        EVAN_FRAGMENT("\033[48;5;28m"),   // 20-29%
+        EVAN_FRAGMENT("\033[48;5;34m"),   // 30-39%
+        EVAN_FRAGMENT("\033[48;5;70m"),   // 40-49%
+        EVAN_FRAGMENT("\033[48;5;142m"),  // 50-59%
+        EVAN_FRAGMENT("\033[48;5;178m"),  // 60-69%
+        EVAN_FRAGMENT("\033[48;5;172m"),  // 70-79%
+        EVAN_FRAGMENT("\033[48;5;166m"),  // 80-89%
+        EVAN_FRAGMENT("\033[48;5;160m")   // 90-100%
+    };
+    const size_t HEAT_LEVELS = sizeof(HEAT_COLORS) / sizeof(HEAT_COLORS[0]);
+    const size_t MAX_COLOR_LENGTH = sizeof("\033[48;5;236m") - 1;
+
+    /**
+     * 迷你折线字符（UTF-8编码的▁▂▃▄▅▆▇█）
+     */
+    const Fragment SPARK_BLOCKS[] = {
+        EVAN_FRAGMENT("\xE2\x96\x81"), EVAN_FRAGMENT("\xE2\x96\x82"),
+        EVAN_FRAGMENT("\xE2\x96\x83"), EVAN_FRAGMENT("\xE2\x96\x84"),
+        EVAN_FRAGMENT("\xE2\x96\x85"), EVAN_FRAGMENT("\xE2\x96\x86"),
+        EVAN_FRAGMENT("\xE2\x96\x87"), EVAN_FRAGMENT("\xE2\x96\x88")
+    };
+    const size_t SPARK_LEVELS = sizeof(SPARK_BLOCKS) / sizeof(SPARK_BLOCKS[0]);
+    const size_t SPARK_BLOCK_LENGTH = 3;
+
+    const Fragment COLOR_RESET = EVAN_FRAGMENT("\033[0m");
+
+    #undef EVAN_FRAGMENT
+
+    /**
+     * 行标签的最大长度（如 "cpu255 "、"Memory [" 及结尾的 "] 100%"）
+     */
+    const size_t LABEL_LENGTH = 24;
+
+    /**
+     * 将百分比量化为0-100的整数
+     * @param percent 百分比
+     * @return 量化后的值
+     */
+    unsigned char quantizePercent(float percent) {
+        if (!(percent > 0.0f)) {
+            return 0;
+        }
+        if (percent >= 100.0f) {
+            return 100;
+        }
+        return static_cast<unsigned char>(percent + 0.5f);
+    }
+
+    /**
+     * 追加预生成片段
+     */
+    inline void appendFragment(std::string& out, const Fragment& fragment) {
+        out.append(fragment.text, fragment.length);
+    }
+}
+
+/**
+ * 构造函数
+ * @param rows 行数（逻辑处理器数量）
+ * @param columns 列数（保留的采样次数）
+ */
+HeatmapWidget::HeatmapWidget(size_t rows, size_t columns) :
+    columns(columns == 0 ? 1 : columns),
+    history(rows, utils::RingBuffer<unsigned char>(columns == 0 ? 1 : columns)) {
+}
+
+/**
+ * 追加一列采样值
+ * @param values 每行的使用率（0-100）
+ * @param count values长度
+ */
+void HeatmapWidget::push(const float* values, size_t count) {
+    for (size_t row = 0; row < history.size(); ++row) {
+        history[row].push(row < count ? quantizePercent(values[row]) : 0);
+    }
+}
+
+/**
+ * 将热力图追加到输出缓冲区
+ * 相邻单元格颜色相同时不重复输出转义序列
+ * @param out 输出缓冲区
+ */
+void HeatmapWidget::render(std::string& out) const {
+    char label[LABEL_LENGTH];
+
+    for (size_t row = 0; row < history.size(); ++row) {
+        const utils::RingBuffer<unsigned char>& cells = history[row];
+        int length = snprintf(label, sizeof(label), "\tcpu%-3u ", static_cast<unsigned int>(row));
+        out.append(label, static_cast<size_t>(length));
+
+        // 尚未填满的列用空白补齐，使最新的采样总是对齐在最右侧
+        out.append(columns - cells.size(), ' ');
+
+        size_t current_level = HEAT_LEVELS;
+        for (size_t col = 0; col < cells.size(); ++col) {
+            size_t level = cells[col] / 10;
+            if (level >= HEAT_LEVELS) {
+                level = HEAT_LEVELS - 1;
+            }
+            if (level != current_level) {
+                appendFragment(out, HEAT_COLORS[level]);
+                current_level = level;
+            }
+            out.push_back(' ');
+        }
+        appendFragment(out, COLOR_RESET);
+
+        length = snprintf(label, sizeof(label), " %3u%%\n",
+                          static_cast<unsigned int>(cells.empty() ? 0 : cells.back()));
+        out.append(label, static_cast<size_t>(length));
+    }
+}
+
+/**
+ * 获取渲染结果的最大字节数
+ * @return 最大字节数
+ */
+size_t HeatmapWidget::maxRenderSize() const {
+    return history.size() * (2 * LABEL_LENGTH + columns * (MAX_COLOR_LENGTH + 1) + COLOR_RESET.length);
+}
+
+/**
+ * 构造函数
+ * @param label 标签（需为静态字符串）
+ * @param capacity 保留的采样次数
+ */
+SparklineWidget::SparklineWidget(const char* label, size_t capacity) :
+    label(label), history(capacity) {
+}
+
+/**
+ * 追加采样值
+ * @param percent 百分比（0-100）
+ */
+void SparklineWidget::push(float percent) {
+    history.push(quantizePercent(percent));
+}
+
+/**
+ * 将折线追加到输出缓冲区
+ * @param out 输出缓冲区
+ */
+void SparklineWidget::render(std::string& out) const {
+    char text[LABEL_LENGTH];
+    int length = snprintf(text, sizeof(text), "\t%-7s[", label);
+    out.append(text, static_cast<size_t>(length));
+
+    out.append(history.capacity() - history.size(), ' ');
+    for (size_t i = 0; i < history.size(); ++i) {
+        size_t level = history[i] * SPARK_LEVELS / 101;
+        appendFragment(out, SPARK_BLOCKS[level]);
+    }
+
+    length = snprintf(text, sizeof(text), "] %3u%%\n",
+                      static_cast<unsigned int>(history.empty() ? 0 : history.back()));
+    out.append(text, static_cast<size_t>(length));
+}
+
+/**
+ * 获取渲染结果的最大字节数
+ * @return 最大字节数
+ */
+size_t SparklineWidget::maxRenderSize() const {
+    return 2 * LABEL_LENGTH + history.capacity() * SPARK_BLOCK_LENGTH;
+}
+
+/**
+ * 构造函数
+ * @param cores 逻辑处理器数量
+ * @param columns 保留的采样次数
+ */
+HistoryPanel::HistoryPanel(size_t cores, size_t columns) :
+    heatmap(cores, columns),
+    memory("Memory", columns),
+    swap("Swap", columns) {
+    // 一次性预留足够的空间，之后每次渲染只复用该缓冲区
+    frame.reserve(heatmap.maxRenderSize() + memory.maxRenderSize() + swap.maxRenderSize() + 256);
+}
+
+/**
+ * 追加一次采样
+ */
+void HistoryPanel::update(const float* core_usage, size_t core_count, float memory_percent, float swap_percent) {
+    heatmap.push(core_usage, core_count);
+    memory.push(memory_percent);
+    swap.push(swap_percent);
+}
+
+/**
+ * 渲染整个面板
+ * @return 渲染结果
+ */
+const std::string& HistoryPanel::render() {
+    frame.clear();
+    frame.append("\n[CPU Heatmap]\n");
+    frame.append("-----------------------------------------------\n");
+    heatmap.render(frame);
+    frame.append("\n[Memory/Swap History]\n");
+    frame.append("-----------------------------------------------\n");
+    memory.render(frame);
+    swap.render(frame);
+    return frame;
+}
+
+} // namespace evan
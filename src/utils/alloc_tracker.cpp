@@ -0,0 +1,328 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "utils/alloc_tracker.h"
+
+#if EVANOS_ALLOC_TRACKING
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#if defined(_MSC_VER) && defined(_DEBUG)
+    #include <crtdbg.h>
+    #define EVANOS_ALLOC_CRT_HOOK 1
+#endif
+#if defined(EVANOS_ALLOC_WRAP) && EVANOS_ALLOC_WRAP
+    #include <malloc.h>
+#endif
+#endif
+
+namespace evan {
+namespace utils {
+
+#if EVANOS_ALLOC_TRACKING
+
+namespace {
+    /**
+     * 一个标签的计数器
+     * 全部由原子类型组成，静态存储期下零初始化，不依赖动态初始化顺序
+     * （全局构造函数中的分配也能安全计入）
+     */
+    struct TagCounters {
+        std::atomic<const char*> name;
+        std::atomic<unsigned long long> allocs;
+        std::atomic<unsigned long long> bytes;
+        std::atomic<unsigned long long> frees;
+        std::atomic<unsigned long long> freed_bytes;
+    };
+
+    TagCounters counters[MAX_ALLOC_TAGS];
+    std::atomic<size_t> tagCount(1);
+    std::mutex registerMutex;
+
+    // 当前线程的作用域标签，以及是否处于统计代码自身的分配中（避免重复计数）
+    thread_local unsigned int threadTag = 0;
+    thread_local int suppressDepth = 0;
+
+    /**
+     * operator new分配的块头，记录大小和分配时的标签，释放时计入同一个标签
+     */
+    struct AllocHeader {
+        size_t size;
+        unsigned int tag;
+    };
+
+    // 保持malloc返回地址的对齐
+    const size_t HEADER_SIZE = 16;
+    static_assert(sizeof(AllocHeader) <= HEADER_SIZE, "allocation header does not fit");
+
+    inline void recordAlloc(unsigned int tag, size_t size) {
+        counters[tag].allocs.fetch_add(1, std::memory_order_relaxed);
+        counters[tag].bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    inline void recordFree(unsigned int tag, size_t size) {
+        counters[tag].frees.fetch_add(1, std::memory_order_relaxed);
+        counters[tag].freed_bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void* trackedNew(size_t size) {
+        const unsigned int tag = threadTag;
+        ++suppressDepth;
+        void* base = std::malloc(size + HEADER_SIZE);
+        --suppressDepth;
+        if (base == nullptr) {
+            return nullptr;
+        }
+
+        AllocHeader* header = static_cast<AllocHeader*>(base);
+        header->size = size;
+        header->tag = tag;
+        recordAlloc(tag, size);
+        return static_cast<char*>(base) + HEADER_SIZE;
+    }
+
+    void trackedDelete(void* ptr) {
+        if (ptr == nullptr) {
+            return;
+        }
+        void* base = static_cast<char*>(ptr) - HEADER_SIZE;
+        const AllocHeader* header = static_cast<const AllocHeader*>(base);
+        recordFree(header->tag, header->size);
+        ++suppressDepth;
+        std::free(base);
+        --suppressDepth;
+    }
+
+#ifdef EVANOS_ALLOC_CRT_HOOK
+    /**
+     * MSVC Debug运行库的分配钩子，统计malloc/realloc/free
+     * 钩子中不能调用会分配内存的CRT函数，_msize_dbg只读取块头
+     */
+    int __cdecl crtAllocHook(int allocType, void* userData, size_t size, int blockType,
+                             long, const unsigned char*, int) {
+        if (suppressDepth > 0 || blockType == _CRT_BLOCK) {
+            return 1;
+        }
+        switch (allocType) {
+            case _HOOK_ALLOC:
+                recordAlloc(threadTag, size);
+                break;
+            case _HOOK_REALLOC:
+                recordFree(threadTag, userData ? _msize_dbg(userData, blockType) : 0);
+                recordAlloc(threadTag, size);
+                break;
+            case _HOOK_FREE:
+                recordFree(threadTag, userData ? _msize_dbg(userData, blockType) : 0);
+                break;
+            default:
+                break;
+        }
+        return 1;
+    }
+
+    struct CrtHookInstaller {
+        CrtHookInstaller() { _CrtSetAllocHook(crtAllocHook); }
+    } crtHookInstaller;
+#endif
+}
+
+/**
+ * 是否同时拦截了malloc系列函数
+ */
+bool AllocTracker::mallocHooked() {
+#if defined(EVANOS_ALLOC_CRT_HOOK) || (defined(EVANOS_ALLOC_WRAP) && EVANOS_ALLOC_WRAP)
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * 注册作用域标签
+ * 已注册的标签无锁查找，只有新标签需要加锁
+ * @param tag 标签名
+ * @return 标签编号，标签表已满时返回0
+ */
+unsigned int AllocTracker::registerTag(const char* tag) {
+    size_t count = tagCount.load(std::memory_order_acquire);
+    for (size_t i = 1; i < count; ++i) {
+        const char* name = counters[i].name.load(std::memory_order_acquire);
+        if (name == tag || std::strcmp(name, tag) == 0) {
+            return static_cast<unsigned int>(i);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(registerMutex);
+    const size_t registered = tagCount.load(std::memory_order_relaxed);
+    for (size_t i = count; i < registered; ++i) {
+        if (std::strcmp(counters[i].name.load(std::memory_order_relaxed), tag) == 0) {
+            return static_cast<unsigned int>(i);
+        }
+    }
+    if (registered >= MAX_ALLOC_TAGS) {
+        return 0;
+    }
+    counters[registered].name.store(tag, std::memory_order_release);
+    tagCount.store(registered + 1, std::memory_order_release);
+    return static_cast<unsigned int>(registered);
+}
+
+unsigned int AllocTracker::currentTag() {
+    return threadTag;
+}
+
+unsigned int AllocTracker::exchangeTag(unsigned int tag) {
+    const unsigned int previous = threadTag;
+    threadTag = tag < MAX_ALLOC_TAGS ? tag : 0;
+    return previous;
+}
+
+/**
+ * 获取所有标签的统计
+ * @param out 输出数组
+ * @param capacity 数组长度
+ * @return 标签数量
+ */
+size_t AllocTracker::snapshot(AllocStats* out, size_t capacity) {
+    const size_t count = tagCount.load(std::memory_order_acquire);
+    const size_t n = count < capacity ? count : capacity;
+    for (size_t i = 0; i < n; ++i) {
+        const char* name = counters[i].name.load(std::memory_order_acquire);
+        out[i].tag = name ? name : "untagged";
+        out[i].allocs = counters[i].allocs.load(std::memory_order_relaxed);
+        out[i].bytes = counters[i].bytes.load(std::memory_order_relaxed);
+        out[i].frees = counters[i].frees.load(std::memory_order_relaxed);
+        out[i].freed_bytes = counters[i].freed_bytes.load(std::memory_order_relaxed);
+    }
+    return n;
+}
+
+#else // !EVANOS_ALLOC_TRACKING
+
+bool AllocTracker::mallocHooked() {
+    return false;
+}
+
+unsigned int AllocTracker::registerTag(const char*) {
+    return 0;
+}
+
+unsigned int AllocTracker::currentTag() {
+    return 0;
+}
+
+unsigned int AllocTracker::exchangeTag(unsigned int) {
+    return 0;
+}
+
+size_t AllocTracker::snapshot(AllocStats*, size_t) {
+    return 0;
+}
+
+#endif // EVANOS_ALLOC_TRACKING
+
+} // namespace utils
+} // namespace evan
+
+#if EVANOS_ALLOC_TRACKING
+
+// ---------------- 全局operator new/delete替换 ----------------
+
+void* operator new(std::size_t size) {
+    void* ptr = evan::utils::trackedNew(size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return evan::utils::trackedNew(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return evan::utils::trackedNew(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    evan::utils::trackedDelete(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    evan::utils::trackedDelete(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    evan::utils::trackedDelete(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    evan::utils::trackedDelete(ptr);
+}
+
+// ---------------- malloc拦截（GCC/MinGW，链接时使用-Wl,--wrap） ----------------
+
+#if defined(EVANOS_ALLOC_WRAP) && EVANOS_ALLOC_WRAP
+namespace {
+    /**
+     * 分配和释放都按块的实际可用大小计数，保证两边一致
+     */
+    inline size_t usableSize(void* ptr) {
+    #ifdef _WIN32
+        return _msize(ptr);
+    #else
+        return malloc_usable_size(ptr);
+    #endif
+    }
+}
+
+extern "C" {
+    void* __real_malloc(size_t size);
+    void* __real_calloc(size_t count, size_t size);
+    void* __real_realloc(void* ptr, size_t size);
+    void __real_free(void* ptr);
+
+    void* __wrap_malloc(size_t size) {
+        void* ptr = __real_malloc(size);
+        if (ptr != nullptr && evan::utils::suppressDepth == 0) {
+            evan::utils::recordAlloc(evan::utils::threadTag, usableSize(ptr));
+        }
+        return ptr;
+    }
+
+    void* __wrap_calloc(size_t count, size_t size) {
+        void* ptr = __real_calloc(count, size);
+        if (ptr != nullptr && evan::utils::suppressDepth == 0) {
+            evan::utils::recordAlloc(evan::utils::threadTag, usableSize(ptr));
+        }
+        return ptr;
+    }
+
+    void* __wrap_realloc(void* old, size_t size) {
+        const size_t oldSize = (old != nullptr && evan::utils::suppressDepth == 0) ? usableSize(old) : 0;
+        void* ptr = __real_realloc(old, size);
+        if (ptr != nullptr && evan::utils::suppressDepth == 0) {
+            if (old != nullptr) {
+                evan::utils::recordFree(evan::utils::threadTag, oldSize);
+            }
+            evan::utils::recordAlloc(evan::utils::threadTag, usableSize(ptr));
+        }
+        return ptr;
+    }
+
+    void __wrap_free(void* ptr) {
+        if (ptr != nullptr && evan::utils::suppressDepth == 0) {
+            evan::utils::recordFree(evan::utils::threadTag, usableSize(ptr));
+        }
+        __real_free(ptr);
+    }
+}
+#endif
+
+#endif // EVANOS_ALLOC_TRACKING
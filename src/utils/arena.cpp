@@ -0,0 +1,87 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "utils/arena.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace evan {
+namespace utils {
+
+/**
+ * 构造函数
+ * @param chunkSize 每个内存块的大小
+ */
+Arena::Arena(size_t chunkSize) :
+    chunk_size(chunkSize ? chunkSize : ARENA_DEFAULT_CHUNK_SIZE),
+    current(0),
+    offset(0),
+    reserved(0),
+    generation_(0) {
+}
+
+Arena::~Arena() {
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        std::free(chunks[i].data);
+    }
+}
+
+/**
+ * 当前块空间不足时切换到下一个块
+ * 后面已有足够大的块时直接复用，否则新申请一块插入到当前块之后，
+ * 这样reset()之后按相同顺序分配会依次命中同样的块
+ */
+void* Arena::allocateSlow(size_t size, size_t alignment) {
+    const size_t needed = size + alignment - 1;
+
+    for (size_t next = chunks.empty() ? 0 : current + 1; next < chunks.size(); ++next) {
+        if (chunks[next].size >= needed) {
+            current = next;
+            offset = 0;
+            return allocate(size, alignment);
+        }
+    }
+
+    Chunk chunk;
+    chunk.size = needed > chunk_size ? needed : chunk_size;
+    chunk.data = static_cast<char*>(std::malloc(chunk.size));
+    if (chunk.data == nullptr) {
+        throw std::bad_alloc();
+    }
+    reserved += chunk.size;
+
+    const size_t position = chunks.empty() ? 0 : current + 1;
+    chunks.insert(chunks.begin() + position, chunk);
+    current = position;
+    offset = 0;
+    return allocate(size, alignment);
+}
+
+/**
+ * 复制字符串到Arena中
+ * @param str 源字符串
+ * @return 指向副本的视图
+ */
+StringView Arena::copy(StringView str) {
+    char* data = static_cast<char*>(allocate(str.size() + 1, 1));
+    if (!str.empty()) {
+        std::memcpy(data, str.data(), str.size());
+    }
+    data[str.size()] = '\0';
+    return StringView(data, str.size());
+}
+
+/**
+ * 获取当前已分配的字节数
+ */
+size_t Arena::bytesUsed() const {
+    size_t used = offset;
+    for (size_t i = 0; i < current && i < chunks.size(); ++i) {
+        used += chunks[i].size;
+    }
+    return used;
+}
+
+} // namespace utils
+} // namespace evan
@@ -2,6 +2,7 @@
 // Licensed under the Apache License, Version 2.0
 
 #include "utils/command_line.h"
+#include "utils/string_view.h"
 #include <algorithm>
 #include <sstream>
 #include <cctype>
@@ -88,15 +89,15 @@ namespace cmdline {
         
         // 遍历所有命令行参数
         for (int i = 1; i < argc; ++i) {
-            std::string arg = argv[i];
+            evan::utils::StringView arg(argv[i]);
             
             if (arg.empty()) {
                 continue;
             }
             
             // 处理长选项（如 --help, --verbose）
-            if (arg.size() > 2 && arg.substr(0, 2) == "--") {
-                std::string param_name = arg.substr(2);
+            if (arg.size() > 2 && arg.startsWith("--")) {
+                std::string param_name = arg.substr(2).toString();
                 
                 // 查找参数是否存在
                 auto it = parameters.find(param_name);
@@ -150,8 +151,7 @@ namespace cmdline {
                         // 非布尔参数，需要获取值
                         if (j + 1 < arg.size()) {
                             // 值紧跟在短选项后面（如 -nvalue）
-                            std::string value = arg.substr(j + 1);
-                            param_it->second->set_value(value);
+                            param_it->second->set_value(arg.substr(j + 1).toString());
                             break; // 结束当前短选项处理
                         } else {
                             // 值在下一个参数中
@@ -221,8 +221,12 @@ namespace cmdline {
         for (const auto& pair : parameters) {
             const parameter* param = pair.second;
             
-            // 输出短选项和长选项
-            oss << "  -" << param->short_name << ", --" << param->name;
+            // 输出短选项和长选项（没有短选项时留空对齐）
+            if (param->short_name != 0) {
+                oss << "  -" << param->short_name << ", --" << param->name;
+            } else {
+                oss << "      --" << param->name;
+            }
             
             // 计算并添加对齐空格
             size_t padding = max_name_len - param->name.size();
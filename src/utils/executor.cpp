@@ -0,0 +1,103 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "utils/executor.h"
+
+namespace evan {
+namespace utils {
+
+/**
+ * 构造函数
+ * @param threads 工作线程数量（0表示使用CPU逻辑核心数）
+ */
+Executor::Executor(size_t threads) :
+    batch(nullptr),
+    next(0),
+    remaining(0),
+    stopping(false) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+        if (threads == 0) {
+            threads = 1;
+        }
+    }
+
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers.push_back(std::thread(&Executor::workerLoop, this));
+    }
+}
+
+Executor::~Executor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+}
+
+/**
+ * 并行执行一批任务，全部完成后返回
+ * @param tasks 任务列表
+ */
+void Executor::run(const std::vector<Task>& tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        batch = &tasks;
+        next = 0;
+        remaining = tasks.size();
+        failure = nullptr;
+        wake.notify_all();
+
+        finished.wait(lock, [this]() { return remaining == 0; });
+        batch = nullptr;
+        error = failure;
+        failure = nullptr;
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * 工作线程主循环
+ * 领取任务时持有锁，执行任务时释放锁
+ */
+void Executor::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [this]() { return stopping || (batch != nullptr && next < batch->size()); });
+        if (stopping) {
+            return;
+        }
+
+        const Task& task = (*batch)[next++];
+        lock.unlock();
+        std::exception_ptr error;
+        try {
+            task();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        lock.lock();
+
+        if (error && !failure) {
+            failure = error;
+        }
+        if (--remaining == 0) {
+            finished.notify_one();
+        }
+    }
+}
+
+} // namespace utils
+} // namespace evan
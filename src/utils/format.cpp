@@ -0,0 +1,402 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "utils/format.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace evan {
+namespace utils {
+
+void FixedBufferSink::write(const char* data, size_t length) {
+    wanted += length;
+    if (cap == 0) {
+        return;
+    }
+    const size_t room = cap - 1 - len;
+    const size_t count = length < room ? length : room;
+    memcpy(buf + len, data, count);
+    len += count;
+    buf[len] = '\0';
+}
+
+void FileSink::write(const char* data, size_t length) {
+    if (len + length > sizeof(buffer)) {
+        flush();
+        if (length > sizeof(buffer)) {
+            fwrite(data, 1, length, fp);
+            return;
+        }
+    }
+    memcpy(buffer + len, data, length);
+    len += length;
+}
+
+/**
+ * 把缓冲的内容写入文件
+ */
+void FileSink::flush() {
+    if (len > 0) {
+        fwrite(buffer, 1, len, fp);
+        len = 0;
+    }
+}
+
+namespace {
+    // 当前线程的标准输出捕获目标
+    thread_local FormatSink* captureSink = nullptr;
+}
+
+StdoutCapture::StdoutCapture(FormatSink& sink) : previous(captureSink) {
+    captureSink = &sink;
+}
+
+StdoutCapture::~StdoutCapture() {
+    captureSink = previous;
+}
+
+/**
+ * 写入标准输出（当前线程处于StdoutCapture中时写入捕获目标）
+ * @param data 数据
+ * @param length 长度
+ */
+void writeStdout(const char* data, size_t length) {
+    if (captureSink != nullptr) {
+        captureSink->write(data, length);
+    } else {
+        fwrite(data, 1, length, stdout);
+    }
+}
+
+namespace detail {
+FormatSink* stdoutCapture() {
+    return captureSink;
+}
+
+namespace {
+    /**
+     * 解析后的占位符
+     */
+    struct Spec {
+        char fill;
+        char align;      // '<' '>' '^'，'\0'表示按类型默认
+        bool zero_pad;
+        size_t width;
+        int precision;   // -1表示未指定
+        char type;       // '\0'表示按类型默认
+    };
+
+    // 不需要小数点后更多位数的场景下，定点小数的快速路径最多支持这么多位
+    const int MAX_FAST_PRECISION = 9;
+
+    const unsigned long long POW10[MAX_FAST_PRECISION + 1] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL,
+        1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL
+    };
+
+    void writeFill(FormatSink& sink, char fill, size_t count) {
+        char chunk[32];
+        memset(chunk, fill, sizeof(chunk));
+        while (count > 0) {
+            const size_t n = count < sizeof(chunk) ? count : sizeof(chunk);
+            sink.write(chunk, n);
+            count -= n;
+        }
+    }
+
+    /**
+     * 按对齐方式写入已格式化的内容
+     * @param prefix 符号或"0x"等前缀（补零时位于填充之前）
+     * @param body 内容
+     * @param defaultAlign 未指定对齐时使用的对齐方式
+     */
+    void writePadded(FormatSink& sink, const Spec& spec, StringView prefix, StringView body, char defaultAlign) {
+        const size_t length = prefix.size() + body.size();
+        if (spec.width <= length) {
+            sink.write(prefix.data(), prefix.size());
+            sink.write(body.data(), body.size());
+            return;
+        }
+
+        const size_t padding = spec.width - length;
+        if (spec.zero_pad && spec.align == '\0') {
+            sink.write(prefix.data(), prefix.size());
+            writeFill(sink, '0', padding);
+            sink.write(body.data(), body.size());
+            return;
+        }
+
+        const char align = spec.align ? spec.align : defaultAlign;
+        const size_t before = align == '>' ? padding : (align == '^' ? padding / 2 : 0);
+        writeFill(sink, spec.fill, before);
+        sink.write(prefix.data(), prefix.size());
+        sink.write(body.data(), body.size());
+        writeFill(sink, spec.fill, padding - before);
+    }
+
+    /**
+     * 无符号整数转字符串（从缓冲区末尾向前写）
+     * @return 第一个字符的位置
+     */
+    char* writeUnsigned(char* end, unsigned long long value, unsigned int base, bool upper) {
+        const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+        char* p = end;
+        do {
+            *--p = digits[value % base];
+            value /= base;
+        } while (value != 0);
+        return p;
+    }
+
+    void formatInteger(FormatSink& sink, const Spec& spec, unsigned long long magnitude, bool negative) {
+        char buffer[32];
+        char* end = buffer + sizeof(buffer);
+        const bool hex = spec.type == 'x' || spec.type == 'X';
+        char* begin = writeUnsigned(end, magnitude, hex ? 16 : 10, spec.type == 'X');
+        writePadded(sink, spec, negative ? StringView("-", 1) : StringView(),
+                    StringView(begin, static_cast<size_t>(end - begin)), '>');
+    }
+
+    void formatDouble(FormatSink& sink, const Spec& spec, double value) {
+        const int precision = spec.precision < 0 ? 6 : spec.precision;
+        const double magnitude = std::fabs(value);
+        const bool negative = std::signbit(value) && !std::isnan(value);
+        char buffer[64];
+
+        // 快速路径：放大为整数后分别输出整数部分和小数部分
+        // 先拆出整数部分（减法是精确的），只对小数部分放大；
+        // 放大后接近0.5的值可能受乘法误差影响舍入方向，交给C库按精确的二进制值处理
+        if (precision <= MAX_FAST_PRECISION && std::isfinite(value) && magnitude < 1e9) {
+            const unsigned long long scale = POW10[precision];
+            const double whole = std::floor(magnitude);
+            const double exact = (magnitude - whole) * static_cast<double>(scale);
+            const double floor_value = std::floor(exact);
+            const double remainder = exact - floor_value;
+
+            if (std::fabs(remainder - 0.5) > 1e-6) {
+                unsigned long long scaled = static_cast<unsigned long long>(whole) * scale +
+                                            static_cast<unsigned long long>(floor_value) + (remainder > 0.5 ? 1 : 0);
+                const unsigned long long integral = scaled / scale;
+                unsigned long long fraction = scaled % scale;
+
+                char* end = buffer + sizeof(buffer);
+                char* p = end;
+                for (int i = 0; i < precision; ++i) {
+                    *--p = static_cast<char>('0' + fraction % 10);
+                    fraction /= 10;
+                }
+                if (precision > 0) {
+                    *--p = '.';
+                }
+                p = writeUnsigned(p, integral, 10, false);
+                writePadded(sink, spec, negative ? StringView("-", 1) : StringView(),
+                            StringView(p, static_cast<size_t>(end - p)), '>');
+                return;
+            }
+        }
+
+        // 超出快速路径范围（极大值、NaN、无穷大、高精度或接近舍入边界）交给C库
+        // 结果放不下时（如1e300有301位整数，或很高的精度）按snprintf返回的长度在堆上重新格式化，不截断
+        const int written = snprintf(buffer, sizeof(buffer), "%.*f", precision, magnitude);
+        if (written < 0) {
+            return;
+        }
+        const StringView sign = negative ? StringView("-", 1) : StringView();
+        if (static_cast<size_t>(written) < sizeof(buffer)) {
+            writePadded(sink, spec, sign, StringView(buffer, static_cast<size_t>(written)), '>');
+            return;
+        }
+        std::vector<char> large(static_cast<size_t>(written) + 1);
+        snprintf(large.data(), large.size(), "%.*f", precision, magnitude);
+        writePadded(sink, spec, sign, StringView(large.data(), static_cast<size_t>(written)), '>');
+    }
+
+    void formatArg(FormatSink& sink, const Spec& spec, const FormatArg& arg) {
+        switch (arg.type) {
+            case FormatArg::INT: {
+                const long long v = arg.value.i;
+                if (spec.type == 'c') {
+                    const char ch = static_cast<char>(v);
+                    writePadded(sink, spec, StringView(), StringView(&ch, 1), '<');
+                    break;
+                }
+                // 取绝对值时先转换为无符号数，避免LLONG_MIN溢出
+                const unsigned long long magnitude = v < 0 ? 0ULL - static_cast<unsigned long long>(v)
+                                                           : static_cast<unsigned long long>(v);
+                formatInteger(sink, spec, magnitude, v < 0);
+                break;
+            }
+            case FormatArg::UINT:
+                if (spec.type == 'c') {
+                    const char ch = static_cast<char>(arg.value.u);
+                    writePadded(sink, spec, StringView(), StringView(&ch, 1), '<');
+                    break;
+                }
+                formatInteger(sink, spec, arg.value.u, false);
+                break;
+            case FormatArg::DOUBLE:
+                formatDouble(sink, spec, arg.value.d);
+                break;
+            case FormatArg::STRING: {
+                size_t length = arg.str_len;
+                if (spec.precision >= 0 && static_cast<size_t>(spec.precision) < length) {
+                    length = static_cast<size_t>(spec.precision);
+                }
+                writePadded(sink, spec, StringView(), StringView(arg.str, length), '<');
+                break;
+            }
+            case FormatArg::CHAR:
+                writePadded(sink, spec, StringView(), StringView(&arg.value.c, 1), '<');
+                break;
+            case FormatArg::BOOL:
+                writePadded(sink, spec, StringView(), arg.value.b ? StringView("true", 4) : StringView("false", 5), '<');
+                break;
+            case FormatArg::POINTER: {
+                // 与MSVC的%p一致：按指针宽度补零的大写十六进制，不带0x前缀
+                char buffer[32];
+                char* end = buffer + sizeof(buffer);
+                const unsigned long long address = static_cast<unsigned long long>(
+                    reinterpret_cast<uintptr_t>(arg.value.p));
+                char* begin = writeUnsigned(end, address, 16, spec.type != 'x');
+                while (static_cast<size_t>(end - begin) < sizeof(void*) * 2) {
+                    *--begin = '0';
+                }
+                writePadded(sink, spec, StringView(), StringView(begin, static_cast<size_t>(end - begin)), '>');
+                break;
+            }
+            default:
+                sink.write("{?}", 3);
+                break;
+        }
+    }
+
+    size_t parseNumber(const char*& s) {
+        size_t value = 0;
+        while (*s >= '0' && *s <= '9') {
+            value = value * 10 + static_cast<size_t>(*s - '0');
+            ++s;
+        }
+        return value;
+    }
+
+    /**
+     * 从参数读取动态宽度/精度
+     */
+    long long dynamicValue(const FormatArg* args, size_t count, size_t& index) {
+        if (index >= count) {
+            return 0;
+        }
+        const FormatArg& arg = args[index++];
+        if (arg.type == FormatArg::INT) {
+            return arg.value.i;
+        }
+        return arg.type == FormatArg::UINT ? static_cast<long long>(arg.value.u) : 0;
+    }
+}
+
+/**
+ * 格式化实现
+ * 格式字符串已经在编译期检查过，这里仍对参数越界做保护，不会读取数组之外的参数
+ * @param sink 输出目标
+ * @param format 格式字符串
+ * @param args 参数数组
+ * @param count 参数个数
+ */
+void vformat(FormatSink& sink, const char* format, const FormatArg* args, size_t count) {
+    size_t index = 0;
+    const char* s = format;
+    const char* literal = s;
+
+    while (*s != '\0') {
+        if (*s != '{' && *s != '}') {
+            ++s;
+            continue;
+        }
+
+        // 先写出占位符之前的普通文本
+        if (s > literal) {
+            sink.write(literal, static_cast<size_t>(s - literal));
+        }
+
+        if (s[0] == s[1]) {
+            // {{ 或 }}
+            sink.write(s, 1);
+            s += 2;
+            literal = s;
+            continue;
+        }
+        if (*s == '}') {
+            ++s;
+            literal = s;
+            continue;
+        }
+
+        Spec spec = { ' ', '\0', false, 0, -1, '\0' };
+        ++s;
+        if (*s == ':') {
+            ++s;
+            if (*s != '\0' && *s != '}' && (s[1] == '<' || s[1] == '>' || s[1] == '^')) {
+                spec.fill = s[0];
+                spec.align = s[1];
+                s += 2;
+            } else if (*s == '<' || *s == '>' || *s == '^') {
+                spec.align = *s++;
+            }
+            if (*s == '0') {
+                spec.zero_pad = true;
+                ++s;
+            }
+            if (*s == '*') {
+                const long long width = dynamicValue(args, count, index);
+                // 与printf一致：负的动态宽度表示左对齐
+                if (width < 0) {
+                    spec.align = '<';
+                    spec.width = static_cast<size_t>(-width);
+                } else {
+                    spec.width = static_cast<size_t>(width);
+                }
+                ++s;
+            } else {
+                spec.width = parseNumber(s);
+            }
+            if (*s == '.') {
+                ++s;
+                if (*s == '*') {
+                    const long long precision = dynamicValue(args, count, index);
+                    spec.precision = precision < 0 ? -1 : static_cast<int>(precision);
+                    ++s;
+                } else {
+                    spec.precision = static_cast<int>(parseNumber(s));
+                }
+            }
+            if (*s != '}' && *s != '\0') {
+                spec.type = *s++;
+            }
+        }
+
+        // 跳过到'}'（非法的说明符在编译期已被拒绝）
+        while (*s != '}' && *s != '\0') {
+            ++s;
+        }
+        if (*s == '}') {
+            ++s;
+        }
+        literal = s;
+
+        if (index < count) {
+            formatArg(sink, spec, args[index++]);
+        } else {
+            sink.write("{?}", 3);
+        }
+    }
+
+    if (s > literal) {
+        sink.write(literal, static_cast<size_t>(s - literal));
+    }
+}
+} // namespace detail
+
+} // namespace utils
+} // namespace evan
@@ -0,0 +1,80 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "utils/mapped_file.h"
+
+#include <windows.h>
+
+namespace evan {
+namespace utils {
+
+MappedFile::MappedFile() : data(""), length(0), file(INVALID_HANDLE_VALUE), mapping(nullptr) {
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+/**
+ * 映射文件
+ * @param path 文件路径
+ * @return 成功返回true
+ *
+ * 实现：Windows使用CreateFileMapping/MapViewOfFile，其他平台使用mmap；
+ *       长度为0的文件无法映射，直接返回空视图
+ */
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    file = handle;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size)) {
+        close();
+        return false;
+    }
+    if (size.QuadPart == 0) {
+        return true;
+    }
+
+    mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        close();
+        return false;
+    }
+    const void* view = MapViewOfFile(static_cast<HANDLE>(mapping), FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        close();
+        return false;
+    }
+    data = static_cast<const char*>(view);
+    length = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+/**
+ * 解除映射并关闭文件
+ */
+void MappedFile::close() {
+    if (length != 0) {
+        UnmapViewOfFile(data);
+    }
+    if (mapping != nullptr) {
+        CloseHandle(static_cast<HANDLE>(mapping));
+        mapping = nullptr;
+    }
+    if (file != INVALID_HANDLE_VALUE) {
+        CloseHandle(static_cast<HANDLE>(file));
+        file = INVALID_HANDLE_VALUE;
+    }
+    data = "";
+    length = 0;
+}
+
+} // namespace utils
+} // namespace evan
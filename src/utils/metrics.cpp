@@ -0,0 +1,239 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "utils/metrics.h"
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+namespace evan {
+namespace utils {
+
+namespace {
+    std::atomic<size_t> nextShard(0);
+
+    /**
+     * 按缓存行对齐分配对象
+     * C++11的operator new不保证超过alignof(std::max_align_t)的对齐，
+     * 分片若不对齐，相邻线程的分片会落在同一缓存行上（伪共享）
+     */
+    template <typename T>
+    void* allocateAligned() {
+        const size_t size = sizeof(T) + CACHE_LINE_SIZE;
+        void* base = std::malloc(size);
+        if (base == nullptr) {
+            throw std::bad_alloc();
+        }
+        const uintptr_t aligned = (reinterpret_cast<uintptr_t>(base) + CACHE_LINE_SIZE - 1) & ~(CACHE_LINE_SIZE - 1);
+        return reinterpret_cast<void*>(aligned);
+    }
+}
+
+namespace detail {
+    /**
+     * 为新线程分配分片下标
+     * 前METRIC_SHARDS个线程各占一个分片，之后的线程轮流共享
+     */
+    size_t assignMetricShard() {
+        return nextShard.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARDS;
+    }
+} // namespace detail
+
+MetricCounter::MetricCounter() {
+    for (size_t i = 0; i < METRIC_SHARDS; ++i) {
+        shards[i].value.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * 获取所有分片之和
+ */
+unsigned long long MetricCounter::value() const {
+    unsigned long long total = 0;
+    for (size_t i = 0; i < METRIC_SHARDS; ++i) {
+        total += shards[i].value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+/**
+ * 构造函数
+ * @param bounds 升序的桶上界
+ * @param count 边界数量
+ */
+MetricHistogram::MetricHistogram(const unsigned long long* bounds, size_t count) :
+    bound_count(count < MAX_HISTOGRAM_BOUNDS ? count : MAX_HISTOGRAM_BOUNDS) {
+    for (size_t i = 0; i < bound_count; ++i) {
+        this->bounds[i] = bounds[i];
+    }
+    for (size_t s = 0; s < METRIC_SHARDS; ++s) {
+        for (size_t b = 0; b <= MAX_HISTOGRAM_BOUNDS; ++b) {
+            shards[s].buckets[b].store(0, std::memory_order_relaxed);
+        }
+        shards[s].sum.store(0, std::memory_order_relaxed);
+        shards[s].max.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * 汇总所有分片
+ * 写入方不停顿，读数是各分片在读取时刻的近似一致值
+ * @param out [out] 读数
+ */
+void MetricHistogram::snapshot(HistogramSnapshot& out) const {
+    out.bounds.assign(bounds, bounds + bound_count);
+    out.buckets.assign(bound_count + 1, 0);
+    out.count = 0;
+    out.sum = 0;
+    out.max = 0;
+    for (size_t s = 0; s < METRIC_SHARDS; ++s) {
+        for (size_t b = 0; b <= bound_count; ++b) {
+            const unsigned long long n = shards[s].buckets[b].load(std::memory_order_relaxed);
+            out.buckets[b] += n;
+            out.count += n;
+        }
+        out.sum += shards[s].sum.load(std::memory_order_relaxed);
+        const unsigned long long shardMax = shards[s].max.load(std::memory_order_relaxed);
+        if (shardMax > out.max) {
+            out.max = shardMax;
+        }
+    }
+}
+
+/**
+ * 估计分位数
+ * @param q 分位数（0-1）
+ * @return 分位数所在桶的上界（不超过最大样本）
+ */
+unsigned long long HistogramSnapshot::quantile(double q) const {
+    if (count == 0 || bounds.empty()) {
+        return 0;
+    }
+    if (q < 0.0) {
+        q = 0.0;
+    } else if (q > 1.0) {
+        q = 1.0;
+    }
+
+    const unsigned long long rank = static_cast<unsigned long long>(q * static_cast<double>(count - 1)) + 1;
+    unsigned long long seen = 0;
+    for (size_t b = 0; b < buckets.size(); ++b) {
+        seen += buckets[b];
+        if (seen >= rank) {
+            return b < bounds.size() && bounds[b] < max ? bounds[b] : max;
+        }
+    }
+    return max;
+}
+
+/**
+ * 生成对数线性的桶边界
+ * @param out [out] 边界
+ * @param capacity 最多生成的边界数量
+ * @param first 第一个边界
+ * @param steps 每个2倍区间内的桶数
+ * @return 生成的边界数量
+ */
+size_t logLinearBounds(unsigned long long* out, size_t capacity, unsigned long long first, unsigned int steps) {
+    if (capacity == 0 || first == 0 || steps == 0) {
+        return 0;
+    }
+    size_t count = 0;
+    out[count++] = first;
+    for (unsigned long long octave = first; count < capacity; octave *= 2) {
+        const unsigned long long step = octave / steps > 0 ? octave / steps : 1;
+        for (unsigned int k = 1; k <= steps && count < capacity; ++k) {
+            out[count++] = octave + step * k;
+        }
+    }
+    return count;
+}
+
+/**
+ * 获取全局注册表
+ * 有意不析构：其他静态对象的析构函数中仍可能写入指标
+ */
+MetricsRegistry& MetricsRegistry::instance() {
+    static MetricsRegistry* registry = new MetricsRegistry();
+    return *registry;
+}
+
+/**
+ * 按名称查找指标
+ * @param name 指标名
+ * @param type 期望的类型
+ * @return 找到返回指标，不存在返回nullptr
+ * @throws std::invalid_argument 类型不同
+ */
+MetricEntry* MetricsRegistry::find(const std::string& name, MetricType type) {
+    for (size_t i = 0; i < metrics.size(); ++i) {
+        if (metrics[i].name == name) {
+            if (metrics[i].type != type) {
+                throw std::invalid_argument("metric '" + name + "' is already registered with a different type");
+            }
+            return &metrics[i];
+        }
+    }
+    return nullptr;
+}
+
+MetricCounter& MetricsRegistry::counter(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    MetricEntry* entry = find(name, METRIC_COUNTER);
+    if (entry != nullptr) {
+        return *entry->counter;
+    }
+
+    MetricEntry created = {name, METRIC_COUNTER, new (allocateAligned<MetricCounter>()) MetricCounter(), nullptr, nullptr};
+    metrics.push_back(created);
+    return *created.counter;
+}
+
+MetricGauge& MetricsRegistry::gauge(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    MetricEntry* entry = find(name, METRIC_GAUGE);
+    if (entry != nullptr) {
+        return *entry->gauge;
+    }
+
+    MetricEntry created = {name, METRIC_GAUGE, nullptr, new (allocateAligned<MetricGauge>()) MetricGauge(), nullptr};
+    metrics.push_back(created);
+    return *created.gauge;
+}
+
+MetricHistogram& MetricsRegistry::histogram(const std::string& name, const unsigned long long* bounds, size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    MetricEntry* entry = find(name, METRIC_HISTOGRAM);
+    if (entry != nullptr) {
+        return *entry->histogram;
+    }
+
+    MetricEntry created = {name, METRIC_HISTOGRAM, nullptr, nullptr,
+                           new (allocateAligned<MetricHistogram>()) MetricHistogram(bounds, count)};
+    metrics.push_back(created);
+    return *created.histogram;
+}
+
+/**
+ * 获取或创建延迟直方图
+ * @param name 指标名
+ * @return 直方图引用
+ */
+MetricHistogram& MetricsRegistry::latency(const std::string& name) {
+    static unsigned long long bounds[MAX_HISTOGRAM_BOUNDS];
+    static const size_t count = logLinearBounds(bounds, MAX_HISTOGRAM_BOUNDS, LATENCY_FIRST_BOUND_US, LATENCY_STEPS_PER_OCTAVE);
+    return histogram(name, bounds, count);
+}
+
+/**
+ * 获取所有指标
+ * @return 按注册顺序排列的指标列表
+ */
+std::vector<MetricEntry> MetricsRegistry::entries() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return metrics;
+}
+
+} // namespace utils
+} // namespace evan
@@ -0,0 +1,461 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "utils/simd_scan.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    #define EVAN_SIMD_X86 1
+    #include <emmintrin.h>
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#else
+    #define EVAN_SIMD_X86 0
+#endif
+
+// GCC/Clang需要按函数开启指令集，MSVC可以直接使用内建函数
+#if defined(__GNUC__) || defined(__clang__)
+    #define EVAN_TARGET_SSE2 __attribute__((target("sse2")))
+    #define EVAN_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define EVAN_TARGET_SSE2
+    #define EVAN_TARGET_AVX2
+#endif
+
+namespace evan {
+namespace utils {
+
+namespace {
+    /**
+     * 内核函数表
+     */
+    struct Kernels {
+        SimdScan::Level level;
+        uint64_t (*byteMask)(const char* data, size_t length, char byte);
+        uint64_t (*whitespaceMask)(const char* data, size_t length);
+        void (*toLowerAscii)(char* data, size_t length);
+        void (*rangeMask)(const uint32_t* values, size_t count, uint32_t low, uint32_t span,
+                          const uint64_t* candidates, uint64_t* out);
+    };
+
+    /**
+     * 块内需要检查的字节数
+     */
+    inline size_t blockLength(size_t length) {
+        return length < SimdScan::BLOCK_BYTES ? length : SimdScan::BLOCK_BYTES;
+    }
+
+    inline bool isWhitespace(char ch) {
+        return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+    }
+
+    // ---------------- 标量实现 ----------------
+
+    /**
+     * 字节位图，SIMD实现中不足16字节的尾部也由这里处理
+     * @param first 第一个字节在位图中的下标
+     */
+    uint64_t byteMaskScalar(const char* data, size_t length, char byte, unsigned int first) {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < length; ++i) {
+            bits |= static_cast<uint64_t>(data[i] == byte) << (first + i);
+        }
+        return bits;
+    }
+
+    /**
+     * 没有SIMD内核时用memchr逐个查找块内的字节（行分割中每块只有一两个换行符）
+     */
+    uint64_t byteMaskScalar(const char* data, size_t length, char byte) {
+        const size_t n = blockLength(length);
+        uint64_t bits = 0;
+        const char* pos = data;
+        while ((pos = static_cast<const char*>(std::memchr(pos, byte, n - static_cast<size_t>(pos - data)))) != nullptr) {
+            bits |= static_cast<uint64_t>(1) << (pos - data);
+            if (++pos == data + n) {
+                break;
+            }
+        }
+        return bits;
+    }
+
+    uint64_t whitespaceMaskScalar(const char* data, size_t length, unsigned int first) {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < length; ++i) {
+            bits |= static_cast<uint64_t>(isWhitespace(data[i])) << (first + i);
+        }
+        return bits;
+    }
+
+    uint64_t whitespaceMaskScalar(const char* data, size_t length) {
+        return whitespaceMaskScalar(data, blockLength(length), 0);
+    }
+
+    void toLowerAsciiScalar(char* data, size_t length) {
+        for (size_t i = 0; i < length; ++i) {
+            const unsigned char ch = static_cast<unsigned char>(data[i]);
+            if (static_cast<unsigned int>(ch - 'A') < 26u) {
+                data[i] = static_cast<char>(ch | 0x20);
+            }
+        }
+    }
+
+    /**
+     * 范围过滤（values - low在无符号意义下不超过span即在范围内）
+     * SIMD实现处理完整的64行一组，最后不足64行的一组也由这里处理
+     */
+    void rangeMaskScalar(const uint32_t* values, size_t count, uint32_t low, uint32_t span,
+                         const uint64_t* candidates, uint64_t* out) {
+        for (size_t w = 0; w * 64 < count; ++w) {
+            const uint64_t candidate = candidates[w];
+            if (candidate == 0) {
+                out[w] = 0;
+                continue;
+            }
+            const uint32_t* block = values + w * 64;
+            const size_t rows = count - w * 64 < 64 ? count - w * 64 : 64;
+            uint64_t bits = 0;
+            for (size_t j = 0; j < rows; ++j) {
+                bits |= static_cast<uint64_t>(block[j] - low <= span) << j;
+            }
+            out[w] = candidate & bits;
+        }
+    }
+
+#if EVAN_SIMD_X86
+    // ---------------- SSE2实现 ----------------
+
+    EVAN_TARGET_SSE2
+    uint64_t byteMaskSse2(const char* data, size_t length, char byte) {
+        const size_t n = blockLength(length);
+        const __m128i needle = _mm_set1_epi8(byte);
+        uint64_t bits = 0;
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+            bits |= static_cast<uint64_t>(static_cast<unsigned int>(mask)) << i;
+        }
+        return bits | byteMaskScalar(data + i, n - i, byte, static_cast<unsigned int>(i));
+    }
+
+    EVAN_TARGET_SSE2
+    uint64_t whitespaceMaskSse2(const char* data, size_t length) {
+        const size_t n = blockLength(length);
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i tab = _mm_set1_epi8('\t');
+        const __m128i cr = _mm_set1_epi8('\r');
+        const __m128i lf = _mm_set1_epi8('\n');
+        uint64_t bits = 0;
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            const __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, tab)),
+                                             _mm_or_si128(_mm_cmpeq_epi8(block, cr), _mm_cmpeq_epi8(block, lf)));
+            bits |= static_cast<uint64_t>(static_cast<unsigned int>(_mm_movemask_epi8(hit))) << i;
+        }
+        return bits | whitespaceMaskScalar(data + i, n - i, static_cast<unsigned int>(i));
+    }
+
+    EVAN_TARGET_SSE2
+    void toLowerAsciiSse2(char* data, size_t length) {
+        const __m128i before_a = _mm_set1_epi8('A' - 1);
+        const __m128i after_z = _mm_set1_epi8('Z' + 1);
+        const __m128i case_bit = _mm_set1_epi8(0x20);
+
+        size_t i = 0;
+        for (; i + 16 <= length; i += 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            // 有符号比较：>=0x80的字节为负数，不会被误判为大写字母
+            const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(block, before_a), _mm_cmplt_epi8(block, after_z));
+            block = _mm_or_si128(block, _mm_and_si128(upper, case_bit));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), block);
+        }
+
+        toLowerAsciiScalar(data + i, length - i);
+    }
+
+    EVAN_TARGET_SSE2
+    void rangeMaskSse2(const uint32_t* values, size_t count, uint32_t low, uint32_t span,
+                       const uint64_t* candidates, uint64_t* out) {
+        // SSE2只有有符号比较：翻转符号位后有符号比较等价于无符号比较
+        const __m128i bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+        const __m128i lowVec = _mm_set1_epi32(static_cast<int>(low));
+        const __m128i limit = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(span)), bias);
+        const size_t full = count / 64;
+        for (size_t w = 0; w < full; ++w) {
+            const uint64_t candidate = candidates[w];
+            if (candidate == 0) {
+                out[w] = 0;
+                continue;
+            }
+            const uint32_t* block = values + w * 64;
+            uint64_t outside = 0;
+            for (unsigned int j = 0; j < 64; j += 4) {
+                const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + j));
+                const __m128i offset = _mm_xor_si128(_mm_sub_epi32(data, lowVec), bias);
+                const int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(offset, limit)));
+                outside |= static_cast<uint64_t>(mask) << j;
+            }
+            out[w] = candidate & ~outside;
+        }
+
+        rangeMaskScalar(values + full * 64, count - full * 64, low, span, candidates + full, out + full);
+    }
+
+    // ---------------- AVX2实现 ----------------
+
+    /**
+     * 完整的64字节块用两次256位比较，文件末尾不足64字节的块交给SSE2实现
+     */
+    EVAN_TARGET_AVX2
+    uint64_t byteMaskAvx2(const char* data, size_t length, char byte) {
+        if (length < SimdScan::BLOCK_BYTES) {
+            return byteMaskSse2(data, length, byte);
+        }
+        const __m256i needle = _mm256_set1_epi8(byte);
+        const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32));
+        const unsigned int lowBits = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, needle)));
+        const unsigned int highBits = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, needle)));
+        _mm256_zeroupper();
+        return (static_cast<uint64_t>(highBits) << 32) | lowBits;
+    }
+
+    EVAN_TARGET_AVX2
+    uint64_t whitespaceMaskAvx2(const char* data, size_t length) {
+        if (length < SimdScan::BLOCK_BYTES) {
+            return whitespaceMaskSse2(data, length);
+        }
+        const __m256i space = _mm256_set1_epi8(' ');
+        const __m256i tab = _mm256_set1_epi8('\t');
+        const __m256i cr = _mm256_set1_epi8('\r');
+        const __m256i lf = _mm256_set1_epi8('\n');
+        unsigned int halves[2];
+        for (unsigned int h = 0; h < 2; ++h) {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + h * 32));
+            const __m256i hit = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, space), _mm256_cmpeq_epi8(block, tab)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, cr), _mm256_cmpeq_epi8(block, lf)));
+            halves[h] = static_cast<unsigned int>(_mm256_movemask_epi8(hit));
+        }
+        _mm256_zeroupper();
+        return (static_cast<uint64_t>(halves[1]) << 32) | halves[0];
+    }
+
+    EVAN_TARGET_AVX2
+    void toLowerAsciiAvx2(char* data, size_t length) {
+        const __m256i before_a = _mm256_set1_epi8('A' - 1);
+        const __m256i after_z = _mm256_set1_epi8('Z' + 1);
+        const __m256i case_bit = _mm256_set1_epi8(0x20);
+
+        size_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            const __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(block, before_a),
+                                                   _mm256_cmpgt_epi8(after_z, block));
+            block = _mm256_or_si256(block, _mm256_and_si256(upper, case_bit));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), block);
+        }
+
+        // 剩余部分交给非VEX编码的实现之前清除YMM高位，避免AVX-SSE状态切换的开销
+        _mm256_zeroupper();
+        toLowerAsciiSse2(data + i, length - i);
+    }
+
+    EVAN_TARGET_AVX2
+    void rangeMaskAvx2(const uint32_t* values, size_t count, uint32_t low, uint32_t span,
+                       const uint64_t* candidates, uint64_t* out) {
+        const __m256i bias = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+        const __m256i lowVec = _mm256_set1_epi32(static_cast<int>(low));
+        const __m256i limit = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(span)), bias);
+        const size_t full = count / 64;
+        for (size_t w = 0; w < full; ++w) {
+            const uint64_t candidate = candidates[w];
+            if (candidate == 0) {
+                out[w] = 0;
+                continue;
+            }
+            const uint32_t* block = values + w * 64;
+            uint64_t outside = 0;
+            for (unsigned int j = 0; j < 64; j += 8) {
+                const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + j));
+                const __m256i offset = _mm256_xor_si256(_mm256_sub_epi32(data, lowVec), bias);
+                const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(offset, limit)));
+                outside |= static_cast<uint64_t>(static_cast<unsigned int>(mask)) << j;
+            }
+            out[w] = candidate & ~outside;
+        }
+
+        _mm256_zeroupper();
+        rangeMaskScalar(values + full * 64, count - full * 64, low, span, candidates + full, out + full);
+    }
+#endif // EVAN_SIMD_X86
+
+    const Kernels SCALAR_KERNELS = {
+        SimdScan::SCALAR, byteMaskScalar, whitespaceMaskScalar, toLowerAsciiScalar, rangeMaskScalar
+    };
+
+#if EVAN_SIMD_X86
+    const Kernels SSE2_KERNELS = {
+        SimdScan::SSE2, byteMaskSse2, whitespaceMaskSse2, toLowerAsciiSse2, rangeMaskSse2
+    };
+
+    const Kernels AVX2_KERNELS = {
+        SimdScan::AVX2, byteMaskAvx2, whitespaceMaskAvx2, toLowerAsciiAvx2, rangeMaskAvx2
+    };
+#endif
+
+    /**
+     * 通过CPUID检测CPU支持的最高指令集级别
+     * AVX2还需要操作系统通过XSAVE保存YMM寄存器状态
+     */
+    SimdScan::Level detectLevel() {
+    #if EVAN_SIMD_X86
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+        unsigned int max_leaf = 0;
+
+        #ifdef _MSC_VER
+            int info[4];
+            __cpuid(info, 0);
+            max_leaf = static_cast<unsigned int>(info[0]);
+            __cpuid(info, 1);
+            ecx = static_cast<unsigned int>(info[2]);
+            edx = static_cast<unsigned int>(info[3]);
+        #else
+            if (!__get_cpuid(0, &max_leaf, &ebx, &ecx, &edx) || !__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+                return SimdScan::SCALAR;
+            }
+        #endif
+
+        const bool sse2 = (edx & (1u << 26)) != 0;
+        const bool osxsave = (ecx & (1u << 27)) != 0;
+        const bool avx = (ecx & (1u << 28)) != 0;
+        if (!sse2) {
+            return SimdScan::SCALAR;
+        }
+
+        bool ymm_enabled = false;
+        if (osxsave && avx) {
+            #ifdef _MSC_VER
+                const unsigned long long xcr0 = _xgetbv(0);
+            #else
+                unsigned int xcr0_lo = 0, xcr0_hi = 0;
+                __asm__ __volatile__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+                const unsigned long long xcr0 = (static_cast<unsigned long long>(xcr0_hi) << 32) | xcr0_lo;
+            #endif
+            ymm_enabled = (xcr0 & 0x6) == 0x6;
+        }
+
+        if (ymm_enabled && max_leaf >= 7) {
+            #ifdef _MSC_VER
+                __cpuidex(info, 7, 0);
+                ebx = static_cast<unsigned int>(info[1]);
+            #else
+                __cpuid_count(7, 0, eax, ebx, ecx, edx);
+            #endif
+            if (ebx & (1u << 5)) {
+                return SimdScan::AVX2;
+            }
+        }
+
+        return SimdScan::SSE2;
+    #else
+        return SimdScan::SCALAR;
+    #endif
+    }
+
+    const Kernels* kernelsFor(SimdScan::Level lvl) {
+    #if EVAN_SIMD_X86
+        if (lvl == SimdScan::AVX2) {
+            return &AVX2_KERNELS;
+        }
+        if (lvl == SimdScan::SSE2) {
+            return &SSE2_KERNELS;
+        }
+    #else
+        (void)lvl;
+    #endif
+        return &SCALAR_KERNELS;
+    }
+
+    /**
+     * 当前使用的内核（首次使用时按检测结果初始化）
+     */
+    std::atomic<const Kernels*>& activeKernels() {
+        static std::atomic<const Kernels*> active(kernelsFor(SimdScan::detectedLevel()));
+        return active;
+    }
+}
+
+const size_t SimdScan::BLOCK_BYTES;
+
+/**
+ * 获取CPU支持的最高指令集级别（只检测一次）
+ * @return 指令集级别
+ */
+SimdScan::Level SimdScan::detectedLevel() {
+    static const Level detected = detectLevel();
+    return detected;
+}
+
+/**
+ * 获取当前使用的指令集级别
+ * @return 指令集级别
+ */
+SimdScan::Level SimdScan::level() {
+    return activeKernels().load(std::memory_order_relaxed)->level;
+}
+
+/**
+ * 获取指令集级别名称
+ * @param lvl 指令集级别
+ * @return 名称字符串
+ */
+const char* SimdScan::levelName(Level lvl) {
+    switch (lvl) {
+        case AVX2:
+            return "AVX2";
+        case SSE2:
+            return "SSE2";
+        default:
+            return "scalar";
+    }
+}
+
+/**
+ * 强制使用指定的指令集级别
+ * @param lvl 指令集级别
+ */
+void SimdScan::setLevel(Level lvl) {
+    if (lvl > detectedLevel()) {
+        lvl = detectedLevel();
+    }
+    activeKernels().store(kernelsFor(lvl), std::memory_order_relaxed);
+}
+
+uint64_t SimdScan::byteMask(const char* data, size_t length, char byte) {
+    return activeKernels().load(std::memory_order_relaxed)->byteMask(data, length, byte);
+}
+
+uint64_t SimdScan::whitespaceMask(const char* data, size_t length) {
+    return activeKernels().load(std::memory_order_relaxed)->whitespaceMask(data, length);
+}
+
+void SimdScan::toLowerAscii(char* data, size_t length) {
+    activeKernels().load(std::memory_order_relaxed)->toLowerAscii(data, length);
+}
+
+void SimdScan::rangeMask(const uint32_t* values, size_t count, uint32_t low, uint32_t span,
+                         const uint64_t* candidates, uint64_t* out) {
+    activeKernels().load(std::memory_order_relaxed)->rangeMask(values, count, low, span, candidates, out);
+}
+
+} // namespace utils
+} // namespace evan
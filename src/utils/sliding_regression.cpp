@@ -0,0 +1,140 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "utils/sliding_regression.h"
+#include <algorithm>
+
+namespace evan {
+namespace utils {
+
+/**
+ * 构造函数
+ * @param capacity 窗口中的点数
+ */
+SlidingRegression::SlidingRegression(size_t capacity)
+    : xs(std::max<size_t>(capacity, 2)), ys(std::max<size_t>(capacity, 2)) {
+    clear();
+}
+
+/**
+ * 清空窗口
+ */
+void SlidingRegression::clear() {
+    head = 0;
+    count = 0;
+    pending = 0;
+    originX = 0.0;
+    originY = 0.0;
+    sx = sy = sxx = sxy = syy = 0.0;
+}
+
+/**
+ * 加入一个点
+ * @param x 自变量
+ * @param y 因变量
+ */
+void SlidingRegression::add(double x, double y) {
+    if (count == 0) {
+        originX = x;
+        originY = y;
+    }
+    if (count == xs.size()) {
+        const double dx = xs[head] - originX;
+        const double dy = ys[head] - originY;
+        sx -= dx;
+        sy -= dy;
+        sxx -= dx * dx;
+        sxy -= dx * dy;
+        syy -= dy * dy;
+        --count;
+    }
+
+    xs[head] = x;
+    ys[head] = y;
+    head = (head + 1) % xs.size();
+    ++count;
+
+    const double dx = x - originX;
+    const double dy = y - originY;
+    sx += dx;
+    sy += dy;
+    sxx += dx * dx;
+    sxy += dx * dy;
+    syy += dy * dy;
+
+    if (++pending >= xs.size()) {
+        rebuild();
+    }
+}
+
+/**
+ * 以最旧的点为原点重新计算和式
+ */
+void SlidingRegression::rebuild() {
+    const size_t first = oldest();
+    originX = xs[first];
+    originY = ys[first];
+    sx = sy = sxx = sxy = syy = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        const size_t index = (first + i) % xs.size();
+        const double dx = xs[index] - originX;
+        const double dy = ys[index] - originY;
+        sx += dx;
+        sy += dy;
+        sxx += dx * dx;
+        sxy += dx * dy;
+        syy += dy * dy;
+    }
+    pending = 0;
+}
+
+/**
+ * 斜率
+ */
+double SlidingRegression::slope() const {
+    if (count < 2) {
+        return 0.0;
+    }
+    const double n = static_cast<double>(count);
+    const double denominator = n * sxx - sx * sx;
+    return denominator > 0.0 ? (n * sxy - sx * sy) / denominator : 0.0;
+}
+
+/**
+ * 拟合直线在x处的值
+ * @param x 自变量
+ */
+double SlidingRegression::predict(double x) const {
+    if (count == 0) {
+        return 0.0;
+    }
+    const double n = static_cast<double>(count);
+    return originY + sy / n + slope() * (x - originX - sx / n);
+}
+
+/**
+ * 决定系数R²
+ */
+double SlidingRegression::r2() const {
+    if (count < 2) {
+        return 0.0;
+    }
+    const double n = static_cast<double>(count);
+    const double varianceX = n * sxx - sx * sx;
+    const double varianceY = n * syy - sy * sy;
+    if (varianceX <= 0.0 || varianceY <= 0.0) {
+        return 0.0;
+    }
+    const double covariance = n * sxy - sx * sy;
+    return std::min(1.0, covariance * covariance / (varianceX * varianceY));
+}
+
+/**
+ * 窗口中最新与最旧的点的x之差
+ */
+double SlidingRegression::span() const {
+    return count < 2 ? 0.0 : xs[newest()] - xs[oldest()];
+}
+
+} // namespace utils
+} // namespace evan
@@ -0,0 +1,95 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "utils/streaming_stats.h"
+#include <algorithm>
+#include <cmath>
+
+namespace evan {
+namespace utils {
+
+/**
+ * 正态分布下MAD与标准差之比（稳健z值 = 0.6745 * 偏差 / MAD）
+ */
+static const double MAD_TO_SIGMA = 0.6745;
+
+/**
+ * 加入一个样本
+ * @param value 样本值
+ * @param alpha 平滑系数
+ */
+void StreamingStats::add(double value, double alpha) {
+    if (count_ == 0) {
+        mean_ = value;
+        median_ = value;
+        variance_ = 0.0;
+        mad_ = 0.0;
+        count_ = 1;
+        return;
+    }
+
+    if (count_ < STREAMING_WARMUP_SAMPLES) {
+        // 预热：按样本数平均（前几个样本的权重不至于太小），中位数和MAD用均值和平均绝对偏差初始化
+        const double rate = std::max(alpha, 1.0 / (count_ + 1));
+        const double diff = value - mean_;
+        const double increment = rate * diff;
+        mean_ += increment;
+        variance_ = (1.0 - rate) * (variance_ + diff * increment);
+        median_ = mean_;
+        mad_ += rate * (std::fabs(value - median_) - mad_);
+        ++count_;
+        return;
+    }
+
+    // EWMA均值和方差（Huber截断）
+    const double limit = STREAMING_HUBER_K * std::max(std::sqrt(variance_), floor());
+    const double diff = std::min(std::max(value - mean_, -limit), limit);
+    const double increment = alpha * diff;
+    mean_ += increment;
+    variance_ = (1.0 - alpha) * (variance_ + diff * increment);
+
+    // 中位数和MAD：每次向样本方向移动与MAD成比例的一步（不越过样本）
+    const double step = alpha * std::max(mad_, floor());
+    if (value > median_) {
+        median_ += std::min(step, value - median_);
+    } else if (value < median_) {
+        median_ -= std::min(step, median_ - value);
+    }
+    const double deviation = std::fabs(value - median_);
+    if (deviation > mad_) {
+        mad_ += std::min(step, deviation - mad_);
+    } else if (deviation < mad_) {
+        mad_ -= std::min(step, mad_ - deviation);
+    }
+
+    if (count_ < 0xFFFFFFFFu) {
+        ++count_;
+    }
+}
+
+/**
+ * 离散程度的下限（水平值的STREAMING_RELATIVE_FLOOR倍）
+ */
+double StreamingStats::floor() const {
+    const double level = std::max(std::fabs(median_), std::fabs(mean_));
+    return std::max(level * STREAMING_RELATIVE_FLOOR, 1e-12);
+}
+
+/**
+ * 相对EWMA均值和标准差的z值
+ * @param value 样本值
+ */
+double StreamingStats::zScore(double value) const {
+    return (value - mean_) / std::max(std::sqrt(variance_), floor());
+}
+
+/**
+ * 相对中位数和MAD的稳健z值
+ * @param value 样本值
+ */
+double StreamingStats::robustZ(double value) const {
+    return MAD_TO_SIGMA * (value - median_) / std::max(mad_, floor());
+}
+
+} // namespace utils
+} // namespace evan
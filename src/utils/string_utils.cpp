@@ -2,6 +2,8 @@
 // Licensed under the Apache License, Version 2.0
 
 #include "utils/string_utils.h"
+#include <cstring>
+#include "utils/simd_scan.h"
 
 namespace evan {
 namespace utils {
@@ -24,7 +26,7 @@ namespace utils {
      */
     std::string StringUtils::toLower(const std::string& str) {
         std::string result = str;
-        std::transform(result.begin(), result.end(), result.begin(), ::tolower);
+        toLowerInPlace(result);
         return result;
     }
     
@@ -45,13 +47,7 @@ namespace utils {
      * @return 处理后的字符串
      */
     std::string StringUtils::trim(const std::string& str) {
-        size_t start = str.find_first_not_of(" \t\r\n");
-        if (start == std::string::npos) {
-            return "";
-        }
-        
-        size_t end = str.find_last_not_of(" \t\r\n");
-        return str.substr(start, end - start + 1);
+        return trimView(str).toString();
     }
     
     /**
@@ -62,11 +58,19 @@ namespace utils {
      */
     std::vector<std::string> StringUtils::split(const std::string& str, char delimiter) {
         std::vector<std::string> result;
-        std::istringstream iss(str);
-        std::string item;
         
-        while (std::getline(iss, item, delimiter)) {
-            result.push_back(item);
+        // 与std::getline的行为保持一致：空字符串没有字段，末尾的分隔符不产生空字段
+        StringView input(str);
+        if (!input.empty() && input.back() == delimiter) {
+            input.removeSuffix(1);
+        } else if (input.empty()) {
+            return result;
+        }
+        
+        SplitIterator it(input, delimiter);
+        StringView field;
+        while (it.next(field)) {
+            result.push_back(field.toString());
         }
         
         return result;
@@ -122,13 +126,7 @@ namespace utils {
      */
     std::string StringUtils::replace(const std::string& str, const std::string& from, const std::string& to) {
         std::string result = str;
-        size_t pos = 0;
-        
-        while ((pos = result.find(from, pos)) != std::string::npos) {
-            result.replace(pos, from.length(), to);
-            pos += to.length();
-        }
-        
+        replaceInPlace(result, from, to);
         return result;
     }
     
@@ -139,10 +137,7 @@ namespace utils {
      * @return 是否以指定前缀开头
      */
     bool StringUtils::startsWith(const std::string& str, const std::string& prefix) {
-        if (str.length() < prefix.length()) {
-            return false;
-        }
-        return str.substr(0, prefix.length()) == prefix;
+        return StringView(str).startsWith(prefix);
     }
     
     /**
@@ -152,10 +147,7 @@ namespace utils {
      * @return 是否以指定后缀结尾
      */
     bool StringUtils::endsWith(const std::string& str, const std::string& suffix) {
-        if (str.length() < suffix.length()) {
-            return false;
-        }
-        return str.substr(str.length() - suffix.length()) == suffix;
+        return StringView(str).endsWith(suffix);
     }
     
     /**
@@ -167,5 +159,207 @@ namespace utils {
     bool StringUtils::contains(const std::string& str, const std::string& substr) {
         return str.find(substr) != std::string::npos;
     }
+    
+    /**
+     * 去除首尾空白字符，返回原字符串的子视图
+     * @param str 输入视图
+     * @return 去除空白后的视图
+     */
+    StringView StringUtils::trimView(StringView str) {
+        size_t start = 0;
+        size_t end = str.size();
+        
+        while (start < end && (str[start] == ' ' || str[start] == '\t' || str[start] == '\r' || str[start] == '\n')) {
+            ++start;
+        }
+        while (end > start && (str[end - 1] == ' ' || str[end - 1] == '\t' || str[end - 1] == '\r' || str[end - 1] == '\n')) {
+            --end;
+        }
+        
+        return str.substr(start, end - start);
+    }
+    
+    /**
+     * 按分隔符分割到调用方提供的视图数组
+     * @param str 输入视图
+     * @param delimiter 分隔符
+     * @param out 输出视图数组
+     * @param capacity 输出数组长度
+     * @return 字段总数
+     */
+    size_t StringUtils::splitView(StringView str, char delimiter, StringView* out, size_t capacity) {
+        SplitIterator it(str, delimiter);
+        StringView field;
+        size_t count = 0;
+        
+        while (it.next(field)) {
+            if (count < capacity) {
+                out[count] = field;
+            }
+            ++count;
+        }
+        
+        return count;
+    }
+    
+    /**
+     * 惰性分割迭代器构造函数
+     * @param str 输入视图
+     * @param delimiter 分隔符
+     */
+    StringUtils::SplitIterator::SplitIterator(StringView str, char delimiter) :
+        cursor(str.data()), block(str.data()), end(str.data() + str.size()),
+        pending(SimdScan::byteMask(str.data(), str.size(), delimiter)), delimiter(delimiter), done(false) {
+    }
+    
+    /**
+     * 空白分割迭代器构造函数
+     * @param str 输入视图
+     */
+    StringUtils::WordIterator::WordIterator(StringView str) :
+        block(str.data()), end(str.data() + str.size()), boundaries(0), previous(1) {
+        load();
+    }
+    
+    /**
+     * 计算当前块的单词边界
+     * 最后一块超出输入的位视为空白，输入末尾的单词因此在块内就有结尾边界
+     */
+    void StringUtils::WordIterator::load() {
+        const size_t length = static_cast<size_t>(end - block);
+        uint64_t whitespace = SimdScan::whitespaceMask(block, length);
+        if (length < SimdScan::BLOCK_BYTES) {
+            whitespace |= ~static_cast<uint64_t>(0) << length;
+        }
+        boundaries = whitespace ^ ((whitespace << 1) | previous);
+        previous = whitespace >> 63;
+    }
+    
+    /**
+     * 原地将ASCII字符转换为小写
+     * 只处理'A'-'Z'，不受区域设置影响，UTF-8多字节字符保持不变（由SimdScan::toLowerAscii处理）
+     * @param data 字符缓冲区
+     * @param length 长度
+     */
+    void StringUtils::toLowerInPlace(char* data, size_t length) {
+        SimdScan::toLowerAscii(data, length);
+    }
+    
+    /**
+     * 原地将字符串转换为小写
+     * @param str 字符串
+     */
+    void StringUtils::toLowerInPlace(std::string& str) {
+        if (!str.empty()) {
+            toLowerInPlace(&str[0], str.size());
+        }
+    }
+    
+    /**
+     * 原地替换子串
+     * 替换后不变长时在原缓冲区内一次前移完成；变长时先统计次数，再按最终长度一次性分配
+     * @param str 字符串（from和to不能引用str自身）
+     * @param from 要替换的子串
+     * @param to 替换后的子串
+     */
+    void StringUtils::replaceInPlace(std::string& str, StringView from, StringView to) {
+        if (from.empty() || str.empty()) {
+            return;
+        }
+        
+        if (to.size() <= from.size()) {
+            size_t read = 0;
+            size_t write = 0;
+            StringView view(str);
+            
+            for (;;) {
+                size_t hit = view.find(from, read);
+                size_t chunk = (hit == StringView::npos ? str.size() : hit) - read;
+                if (write != read) {
+                    std::memmove(&str[write], &str[read], chunk);
+                }
+                write += chunk;
+                if (hit == StringView::npos) {
+                    break;
+                }
+                std::memcpy(&str[write], to.data(), to.size());
+                write += to.size();
+                read = hit + from.size();
+            }
+            
+            str.resize(write);
+            return;
+        }
+        
+        size_t occurrences = 0;
+        for (size_t pos = StringView(str).find(from); pos != StringView::npos;
+             pos = StringView(str).find(from, pos + from.size())) {
+            ++occurrences;
+        }
+        if (occurrences == 0) {
+            return;
+        }
+        
+        // 变长时无法原地完成，按最终长度一次性分配后顺序拼接
+        std::string result;
+        result.reserve(str.size() + occurrences * (to.size() - from.size()));
+        StringView view(str);
+        size_t read = 0;
+        for (size_t hit = view.find(from); hit != StringView::npos; hit = view.find(from, read)) {
+            result.append(str, read, hit - read);
+            result.append(to.data(), to.size());
+            read = hit + from.size();
+        }
+        result.append(str, read, std::string::npos);
+        str.swap(result);
+    }
+    
+    /**
+     * 通配符匹配
+     * @param text 被匹配的文本
+     * @param pattern 模式
+     * @param ignoreCase 是否忽略ASCII大小写
+     * @return 整个文本与模式匹配返回true
+     * 
+     * 实现：贪心匹配，遇到不匹配时回溯到最近的'*'，让它多吞一个字符；
+     *       只需记住最近一个'*'，最坏O(n*m)，不递归
+     */
+    bool StringUtils::wildcardMatch(StringView text, StringView pattern, bool ignoreCase) {
+        size_t t = 0;
+        size_t p = 0;
+        size_t starPattern = StringView::npos;
+        size_t starText = 0;
+        
+        while (t < text.size()) {
+            if (p < pattern.size() && pattern[p] == '*') {
+                starPattern = p++;
+                starText = t;
+                continue;
+            }
+            if (p < pattern.size()) {
+                char a = text[t];
+                char b = pattern[p];
+                if (ignoreCase) {
+                    a = static_cast<char>(::tolower(static_cast<unsigned char>(a)));
+                    b = static_cast<char>(::tolower(static_cast<unsigned char>(b)));
+                }
+                if (b == '?' || a == b) {
+                    ++t;
+                    ++p;
+                    continue;
+                }
+            }
+            if (starPattern == StringView::npos) {
+                return false;
+            }
+            p = starPattern + 1;
+            t = ++starText;
+        }
+        
+        while (p < pattern.size() && pattern[p] == '*') {
+            ++p;
+        }
+        return p == pattern.size();
+    }
 } // namespace utils
 } // namespace evan
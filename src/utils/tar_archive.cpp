@@ -0,0 +1,225 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include "utils/tar_archive.h"
+#include <cstddef>
+#include <cstring>
+#include <ctime>
+
+namespace evan {
+namespace utils {
+
+namespace {
+    /**
+     * ustar头部
+     */
+    struct TarHeader {
+        char name[100];
+        char mode[8];
+        char uid[8];
+        char gid[8];
+        char size[12];
+        char mtime[12];
+        char checksum[8];
+        char typeflag;
+        char linkname[100];
+        char magic[6];
+        char version[2];
+        char uname[32];
+        char gname[32];
+        char devmajor[8];
+        char devminor[8];
+        char prefix[155];
+        char padding[12];
+    };
+
+    static_assert(sizeof(TarHeader) == TAR_BLOCK_SIZE, "ustar header must be one block");
+
+    /**
+     * 以八进制写入定长字段（末尾为'\0'）
+     */
+    void writeOctal(char* field, size_t width, unsigned long long value) {
+        field[width - 1] = '\0';
+        for (size_t i = width - 1; i > 0; --i) {
+            field[i - 1] = static_cast<char>('0' + (value & 7));
+            value >>= 3;
+        }
+    }
+
+    /**
+     * 解析八进制字段（跳过前导空格，遇到'\0'或空格结束）
+     */
+    unsigned long long readOctal(const char* field, size_t width) {
+        unsigned long long value = 0;
+        size_t i = 0;
+        while (i < width && field[i] == ' ') {
+            ++i;
+        }
+        for (; i < width && field[i] >= '0' && field[i] <= '7'; ++i) {
+            value = (value << 3) | static_cast<unsigned long long>(field[i] - '0');
+        }
+        return value;
+    }
+
+    /**
+     * 计算头部校验和（校验和字段按8个空格计算）
+     */
+    unsigned long checksumOf(const TarHeader& header) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&header);
+        unsigned long sum = 0;
+        for (size_t i = 0; i < sizeof(header); ++i) {
+            const bool inChecksum = i >= offsetof(TarHeader, checksum) && i < offsetof(TarHeader, checksum) + sizeof(header.checksum);
+            sum += inChecksum ? ' ' : bytes[i];
+        }
+        return sum;
+    }
+
+    /**
+     * 字段的实际长度（字段不一定以'\0'结尾）
+     */
+    size_t fieldLength(const char* field, size_t width) {
+        const void* end = memchr(field, '\0', width);
+        return end != nullptr ? static_cast<size_t>(static_cast<const char*>(end) - field) : width;
+    }
+}
+
+TarWriter::TarWriter() : file(nullptr), failed(false) {
+}
+
+TarWriter::~TarWriter() {
+    close();
+}
+
+/**
+ * 创建归档文件
+ * @param path 文件路径
+ * @return 成功返回true
+ */
+bool TarWriter::open(const std::string& path) {
+    close();
+    file = fopen(path.c_str(), "wb");
+    failed = file == nullptr;
+    return !failed;
+}
+
+/**
+ * 追加一个文件
+ * @param name 归档内的路径
+ * @param data 文件内容
+ * @return 成功返回true
+ */
+bool TarWriter::add(StringView name, StringView data) {
+    if (file == nullptr) {
+        return false;
+    }
+
+    TarHeader header;
+    memset(&header, 0, sizeof(header));
+
+    // 超过100字节的路径在某个'/'处拆分，前半部分写入prefix
+    if (name.size() <= sizeof(header.name)) {
+        memcpy(header.name, name.data(), name.size());
+    } else {
+        size_t split = name.size();
+        while (split > 0 && (name[split - 1] != '/' || name.size() - split > sizeof(header.name) ||
+                             split - 1 > sizeof(header.prefix))) {
+            --split;
+        }
+        if (split == 0) {
+            return false;
+        }
+        memcpy(header.prefix, name.data(), split - 1);
+        memcpy(header.name, name.data() + split, name.size() - split);
+    }
+
+    writeOctal(header.mode, sizeof(header.mode), 0644);
+    writeOctal(header.uid, sizeof(header.uid), 0);
+    writeOctal(header.gid, sizeof(header.gid), 0);
+    writeOctal(header.size, sizeof(header.size), data.size());
+    writeOctal(header.mtime, sizeof(header.mtime), static_cast<unsigned long long>(time(nullptr)));
+    header.typeflag = '0';
+    memcpy(header.magic, "ustar", 6);
+    memcpy(header.version, "00", 2);
+    writeOctal(header.checksum, 7, checksumOf(header));
+    header.checksum[7] = ' ';
+
+    static const char ZEROS[TAR_BLOCK_SIZE] = {0};
+    const size_t padding = (TAR_BLOCK_SIZE - data.size() % TAR_BLOCK_SIZE) % TAR_BLOCK_SIZE;
+    if (fwrite(&header, sizeof(header), 1, file) != 1 ||
+        fwrite(data.data(), 1, data.size(), file) != data.size() ||
+        fwrite(ZEROS, 1, padding, file) != padding) {
+        failed = true;
+    }
+    return !failed;
+}
+
+/**
+ * 写入结束标记（两个全零块）并关闭文件
+ * @return 所有写入都成功返回true
+ */
+bool TarWriter::close() {
+    if (file == nullptr) {
+        return !failed;
+    }
+    static const char ZEROS[TAR_BLOCK_SIZE * 2] = {0};
+    if (fwrite(ZEROS, 1, sizeof(ZEROS), file) != sizeof(ZEROS)) {
+        failed = true;
+    }
+    if (fclose(file) != 0) {
+        failed = true;
+    }
+    file = nullptr;
+    return !failed;
+}
+
+/**
+ * 打开归档
+ * @param path 文件路径
+ * @return 成功返回true
+ */
+bool TarReader::open(const std::string& path) {
+    offset = 0;
+    return file.open(path);
+}
+
+/**
+ * 读取下一个普通文件
+ * @param entry [out] 文件
+ * @return 还有文件返回true
+ */
+bool TarReader::next(TarEntry& entry) {
+    const StringView archive = file.view();
+    while (offset + TAR_BLOCK_SIZE <= archive.size()) {
+        const TarHeader& header = *reinterpret_cast<const TarHeader*>(archive.data() + offset);
+        if (header.name[0] == '\0') {
+            return false;  // 结束标记
+        }
+        if (readOctal(header.checksum, sizeof(header.checksum)) != checksumOf(header)) {
+            return false;
+        }
+
+        const unsigned long long size = readOctal(header.size, sizeof(header.size));
+        const size_t dataOffset = offset + TAR_BLOCK_SIZE;
+        if (size > archive.size() - dataOffset) {
+            return false;
+        }
+        offset = dataOffset + static_cast<size_t>((size + TAR_BLOCK_SIZE - 1) / TAR_BLOCK_SIZE * TAR_BLOCK_SIZE);
+        if (header.typeflag != '0' && header.typeflag != '\0') {
+            continue;
+        }
+
+        entry.name.clear();
+        const size_t prefixLength = fieldLength(header.prefix, sizeof(header.prefix));
+        if (prefixLength != 0) {
+            entry.name.assign(header.prefix, prefixLength);
+            entry.name.push_back('/');
+        }
+        entry.name.append(header.name, fieldLength(header.name, sizeof(header.name)));
+        entry.data = archive.substr(dataOffset, static_cast<size_t>(size));
+        return true;
+    }
+    return false;
+}
+
+} // namespace utils
+} // namespace evan
@@ -0,0 +1,62 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include <cstdio>
+#include "core/anomaly_detector.h"
+#include "core/leak_detector.h"
+#include "utils/command_line.h"
+#include "utils/format.h"
+
+/**
+ * 命令行解析测试
+ * 浮点数选项（--leak-rate、--anomaly-threshold）按与main.cpp相同的方式注册，
+ * 检查默认值和传入的小数都能经parser::convert<double>取回
+ */
+
+namespace {
+    int failures = 0;
+
+    void expectEqual(const char* what, double actual, double expected) {
+        if (actual != expected) {
+            EVAN_FPRINT(stderr, "FAIL {}: got {}, expected {}\n", what, actual, expected);
+            ++failures;
+        }
+    }
+
+    void addOptions(cmdline::parser& par) {
+        par.add("leaks", 'h', "detect leaks.");
+        par.add("leak-rate", 0, "leak rate (MB/hour).", false, evan::DEFAULT_LEAK_RATE_MB_PER_HOUR);
+        par.add("leak-duration", 0, "leak duration (minutes).", false, evan::DEFAULT_LEAK_DURATION_MIN);
+        par.add("anomaly-threshold", 'x', "robust z threshold.", false, evan::DEFAULT_ANOMALY_THRESHOLD);
+    }
+}
+
+int main() {
+    {
+        cmdline::parser par;
+        addOptions(par);
+        char* argv[] = {const_cast<char*>("evanOS"), const_cast<char*>("--leaks")};
+        if (!par.parse(2, argv)) {
+            EVAN_FPRINT(stderr, "FAIL defaults: {}\n", par.error());
+            return 1;
+        }
+        expectEqual("default --leak-rate", par.get<double>("leak-rate"), evan::DEFAULT_LEAK_RATE_MB_PER_HOUR);
+        expectEqual("default --anomaly-threshold", par.get<double>("anomaly-threshold"), evan::DEFAULT_ANOMALY_THRESHOLD);
+    }
+    {
+        cmdline::parser par;
+        addOptions(par);
+        char* argv[] = {const_cast<char*>("evanOS"), const_cast<char*>("--leaks"),
+                        const_cast<char*>("--leak-rate"), const_cast<char*>("2.5"),
+                        const_cast<char*>("--leak-duration"), const_cast<char*>("45"),
+                        const_cast<char*>("-x"), const_cast<char*>("3.75")};
+        if (!par.parse(8, argv)) {
+            EVAN_FPRINT(stderr, "FAIL values: {}\n", par.error());
+            return 1;
+        }
+        expectEqual("--leak-rate 2.5", par.get<double>("leak-rate"), 2.5);
+        expectEqual("--leak-duration 45", par.get<unsigned int>("leak-duration"), 45);
+        expectEqual("-x 3.75", par.get<double>("anomaly-threshold"), 3.75);
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+// Copyright 2026 Evanluo
+// Licensed under the Apache License, Version 2.0
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "procfs_fixture.h"
+#include "core/change_tracker.h"
+#include "core/collector.h"
+#include "core/configuration.h"
+#include "core/procfs_source.h"
+#include "core/system_monitor.h"
+#include "utils/alloc_tracker.h"
+#include "utils/format.h"
+
+/**
+ * 稳态循环的堆分配测试
+ * 在合成的procfs目录上执行循环模式（表格输出和--changes-only两种），预热后
+ * 统计若干次循环内的分配次数（utils::AllocTracker），要求为0。
+ * 需要开启EVANOS_ALLOC_TRACKING，未开启时返回SKIP_RETURN_CODE
+ */
+
+namespace {
+    const int SKIPPED = 77;
+    const unsigned int PROCESSES = 200;
+    const size_t WARMUP_TICKS = 3;
+    const size_t MEASURED_TICKS = 10;
+
+    /**
+     * 丢弃输出（排除终端的开销和缓冲区的增长）
+     */
+    class NullSink : public evan::utils::FormatSink {
+    public:
+        void write(const char*, size_t) override {}
+    };
+
+    /**
+     * 获取标签的累计分配次数
+     * @param tag 标签名
+     */
+    unsigned long long allocCount(const char* tag) {
+        evan::utils::AllocStats stats[evan::utils::MAX_ALLOC_TAGS];
+        const size_t count = evan::utils::AllocTracker::snapshot(stats, evan::utils::MAX_ALLOC_TAGS);
+        for (size_t i = 0; i < count; ++i) {
+            if (std::strcmp(stats[i].tag, tag) == 0) {
+                return stats[i].allocs;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * 表格输出模式的一次循环：回收Arena，读取数据源，依次执行采集器
+     */
+    void displayTick(const evan::CollectorPlan& plan, const evan::Configuration& config) {
+        evan::evos_tick_reset();
+        NullSink output;
+        evan::utils::StdoutCapture capture(output);
+        evan::TickSources sources(evan::evos_tick_arena());
+        plan.load(sources, evan::evos_tick_arena());
+        for (size_t i = 0; i < plan.size(); ++i) {
+            plan[i]->display(sources, config);
+        }
+    }
+
+    /**
+     * --changes-only模式的一次循环：字段和进程行交给变化跟踪器，变化写入out
+     */
+    void watchTick(const evan::CollectorPlan& plan, const evan::Configuration& config,
+                   evan::ChangeTracker& tracker, FILE* out) {
+        evan::evos_tick_reset();
+        tracker.beginTick(out);
+        evan::TickSources sources(evan::evos_tick_arena());
+        plan.load(sources, evan::evos_tick_arena());
+        for (size_t i = 0; i < plan.size(); ++i) {
+            plan[i]->watch(sources, tracker, config);
+        }
+        tracker.endTick(out);
+    }
+
+    /**
+     * 预热后执行若干次循环，检查本线程的分配次数
+     * @param name 测试名
+     * @param tick 一次循环
+     * @return 没有分配返回true
+     */
+    template <typename Tick>
+    bool expectNoAllocations(const char* name, Tick tick) {
+        evan::utils::AllocScope scope(name);
+        for (size_t i = 0; i < WARMUP_TICKS; ++i) {
+            tick();
+        }
+        const unsigned long long before = allocCount(name);
+        for (size_t i = 0; i < MEASURED_TICKS; ++i) {
+            tick();
+        }
+        const unsigned long long allocs = allocCount(name) - before;
+        EVAN_FPRINT(stderr, "{}: {} allocations in {} ticks\n", name, allocs, MEASURED_TICKS);
+        return allocs == 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (!evan::utils::AllocTracker::enabled()) {
+        EVAN_FPRINT(stderr, "Allocation tracking is not compiled in (EVANOS_ALLOC_TRACKING=OFF), skipped.\n");
+        return SKIPPED;
+    }
+
+    // 进程表、内存状态等数据源全部来自合成的procfs目录，与运行环境无关
+    const std::string root(argc > 1 ? argv[1] : "tick_allocations_procfs");
+    evan::bench::ProcfsFixtureSpec spec;
+    spec.processes = PROCESSES;
+    if (!evan::bench::procfs_fixture_prepare(root, spec)) {
+        EVAN_FPRINT(stderr, "Error: Unable to write procfs fixture {}.\n", root);
+        return 1;
+    }
+    evan::evos_proc_root_set(root);
+
+    evan::CollectorRegistry registry;
+    evan::evos_builtin_collectors_register(registry);
+    evan::Configuration config;
+
+    static const char* const DISPLAYED[] = {"perf", "sys", "total", "each"};
+    evan::CollectorPlan displayPlan;
+    for (size_t i = 0; i < sizeof(DISPLAYED) / sizeof(DISPLAYED[0]); ++i) {
+        displayPlan.add(registry.find(DISPLAYED[i]));
+    }
+
+    static const char* const WATCHED[] = {"perf", "total", "each"};
+    evan::CollectorPlan watchPlan;
+    for (size_t i = 0; i < sizeof(WATCHED) / sizeof(WATCHED[0]); ++i) {
+        watchPlan.add(registry.find(WATCHED[i]));
+    }
+    evan::ChangeTracker tracker(evan::DEFAULT_CHANGE_THRESHOLD, evan::DEFAULT_KEYFRAME_INTERVAL);
+    FILE* changes = std::tmpfile();
+    if (changes == nullptr) {
+        EVAN_FPRINT(stderr, "Error: Unable to create a temporary file.\n");
+        return 1;
+    }
+
+    bool passed = true;
+    passed &= expectNoAllocations("test.tick.display", [&]() { displayTick(displayPlan, config); });
+    passed &= expectNoAllocations("test.tick.changes", [&]() { watchTick(watchPlan, config, tracker, changes); });
+
+    std::fclose(changes);
+    evan::evos_proc_root_set(std::string());
+    return passed ? 0 : 1;
+}